@@ -20,6 +20,7 @@ namespace scene
 	public:
 		//! constructor
 		CDynamicMeshBuffer(video::E_VERTEX_TYPE vertexType, video::E_INDEX_TYPE indexType)
+			: PrimitiveType(EPT_TRIANGLES)
 		{
 			VertexBuffer=new CVertexBuffer(vertexType);
 			IndexBuffer=new CIndexBuffer(indexType);
@@ -101,11 +102,24 @@ namespace scene
 			}
 		}
 
+		//! Describe what kind of primitive geometry is used by the meshbuffer
+		virtual void setPrimitiveType(E_PRIMITIVE_TYPE type)
+		{
+			PrimitiveType = type;
+		}
+
+		//! Get the kind of primitive geometry which is used by the meshbuffer
+		virtual E_PRIMITIVE_TYPE getPrimitiveType() const
+		{
+			return PrimitiveType;
+		}
+
 		video::SMaterial Material;
 		core::aabbox3d<f32> BoundingBox;
 	private:
 		IVertexBuffer *VertexBuffer;
 		IIndexBuffer *IndexBuffer;
+		E_PRIMITIVE_TYPE PrimitiveType;
 	};
 
 
@@ -51,7 +51,14 @@ namespace irr
 		to your operating system. If this is unavailable then the X11, SDL and then console device
 		will be tried. This ensures that Irrlicht will run even if your platform is unsupported,
 		although it may not be able to render anything. */
-		EIDT_BEST
+		EIDT_BEST,
+
+		//! A device which renders into memory only, supported by all platforms.
+		/** This device has no window, no input and no console output. It is meant for
+		rendering with the software drivers on machines without a display, and can write
+		the rendered frames to files, see SIrrlichtCreationParameters::CaptureFileName.
+		It is never chosen by EIDT_BEST. */
+		EIDT_OFFSCREEN
 	};
 
 } // end namespace irr
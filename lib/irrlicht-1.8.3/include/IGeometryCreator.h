@@ -167,6 +167,54 @@ public:
 			const video::SColor tailColor = 0xffffffff,
 			const f32 lpDistance = 8.f,
 			const core::vector3df& lightDim = core::vector3df(1.f,1.2f,1.f)) const =0;
+
+	//! Get a cube mesh which is shared with all other users of the same size.
+	/** The shared meshes are cached by primitive type and parameters, so
+	any number of scene nodes can use one copy of the geometry. The mesh
+	has to be dropped when it is no longer needed, just like a created one.
+	Because it is shared, neither its vertices nor its materials may be
+	changed. Scene nodes using it keep their own material instead.
+	\param size Dimensions of the cube.
+	\return Shared mesh. */
+	virtual IMesh* getSharedCubeMesh(const core::vector3df& size=core::vector3df(5.f,5.f,5.f)) const =0;
+
+	//! Get a sphere mesh which is shared with all other users of the same parameters.
+	/** See getSharedCubeMesh() for the rules of shared meshes.
+	\param radius Radius of the sphere
+	\param polyCountX Number of quads used for the horizontal tiling
+	\param polyCountY Number of quads used for the vertical tiling
+	\return Shared mesh. */
+	virtual IMesh* getSharedSphereMesh(f32 radius = 5.f,
+			u32 polyCountX = 16, u32 polyCountY = 16) const =0;
+
+	//! Get a cylinder mesh which is shared with all other users of the same parameters.
+	/** See getSharedCubeMesh() for the rules of shared meshes and
+	createCylinderMesh() for the parameters.
+	\return Shared mesh. */
+	virtual IMesh* getSharedCylinderMesh(f32 radius, f32 length,
+			u32 tesselation,
+			const video::SColor& color=video::SColor(0xffffffff),
+			bool closeTop=true, f32 oblique=0.f) const =0;
+
+	//! Get a volume light mesh which is shared with all other users of the same parameters.
+	/** See getSharedCubeMesh() for the rules of shared meshes and
+	createVolumeLightMesh() for the parameters.
+	\return Shared mesh. */
+	virtual IMesh* getSharedVolumeLightMesh(
+			const u32 subdivideU=32, const u32 subdivideV=32,
+			const video::SColor footColor = 0xffffffff,
+			const video::SColor tailColor = 0xffffffff,
+			const f32 lpDistance = 8.f,
+			const core::vector3df& lightDim = core::vector3df(1.f,1.2f,1.f)) const =0;
+
+	//! Removes all shared meshes from the cache which are not used anymore.
+	/** Unused meshes are also removed whenever a new shared mesh is
+	created, so calling this is only needed to free memory early.
+	\return Number of meshes removed. */
+	virtual u32 removeUnusedSharedMeshes() const =0;
+
+	//! Get the number of meshes in the shared mesh cache.
+	virtual u32 getSharedMeshCount() const =0;
 };
 
 
@@ -0,0 +1,75 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_INSTANCED_MESH_SCENE_NODE_H_INCLUDED__
+#define __I_INSTANCED_MESH_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+
+class IMesh;
+
+
+//! A scene node drawing many copies of one static mesh.
+/** Every instance has its own transformation, relative to the node, and
+its own color. All instances share the mesh and the material of the node,
+so the node only stores a transformation and a color per instance, however
+large the mesh is. This is much lighter than a scene node per instance,
+which has to be animated, registered and culled on its own.
+Each visible instance is drawn with the mesh buffers of the shared mesh,
+under its own world transformation. The color of the instance is the
+diffuse and ambient color of the material it is drawn with, so lit
+materials and shaders show it, while unlit fixed function materials keep
+the vertex colors of the mesh.
+*/
+class IInstancedMeshSceneNode : public ISceneNode
+{
+public:
+
+	//! Constructor
+	IInstancedMeshSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position = core::vector3df(0,0,0),
+			const core::vector3df& rotation = core::vector3df(0,0,0),
+			const core::vector3df& scale = core::vector3df(1,1,1))
+		: ISceneNode(parent, mgr, id, position, rotation, scale) {}
+
+	//! Get the mesh which is drawn for every instance.
+	virtual IMesh* getMesh() = 0;
+
+	//! Adds an instance of the mesh.
+	/** \param transform Transformation of the instance, relative to this node.
+	\param color Color of all vertices of the instance.
+	\return Index of the new instance. */
+	virtual u32 addInstance(const core::matrix4& transform,
+			video::SColor color=video::SColor(255,255,255,255)) = 0;
+
+	//! Get the number of instances.
+	virtual u32 getInstanceCount() const = 0;
+
+	//! Removes all instances.
+	virtual void clearInstances() = 0;
+
+	//! Sets the transformation of an instance, relative to this node.
+	virtual void setInstanceTransform(u32 index, const core::matrix4& transform) = 0;
+
+	//! Get the transformation of an instance, relative to this node.
+	virtual const core::matrix4& getInstanceTransform(u32 index) const = 0;
+
+	//! Sets the color of an instance.
+	virtual void setInstanceColor(u32 index, video::SColor color) = 0;
+
+	//! Get the color of an instance.
+	virtual video::SColor getInstanceColor(u32 index) const = 0;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+
+#endif
+
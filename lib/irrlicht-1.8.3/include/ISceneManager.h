@@ -17,6 +17,7 @@
 #include "ESceneNodeAnimatorTypes.h"
 #include "EMeshWriterEnums.h"
 #include "SceneParameters.h"
+#include "SSceneStatistics.h"
 #include "IGeometryCreator.h"
 #include "ISkinnedMesh.h"
 
@@ -108,6 +109,7 @@ namespace scene
 	class IMeshLoader;
 	class IMeshManipulator;
 	class IMeshSceneNode;
+	class IInstancedMeshSceneNode;
 	class IMeshWriter;
 	class IMetaTriangleSelector;
 	class IParticleSystemSceneNode;
@@ -522,6 +524,24 @@ namespace scene
 			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f),
 			bool alsoAddIfMeshPointerZero=false) = 0;
 
+		//! Adds a scene node drawing many instances of a static mesh.
+		/** Use this instead of one mesh scene node per object when there are
+		thousands of small objects with the same mesh and material, which only
+		differ in transformation and color. See IInstancedMeshSceneNode.
+		\param mesh: Pointer to the mesh to draw for every instance.
+		\param parent: Parent of the scene node. Can be NULL if no parent.
+		\param id: Id of the node. This id can be used to identify the scene node.
+		\param position: Position of the space relative to its parent where the
+		scene node will be placed.
+		\param rotation: Initital rotation of the scene node.
+		\param scale: Initial scale of the scene node.
+		\return Pointer to the created scene node, or 0 if mesh is 0.
+		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
+		virtual IInstancedMeshSceneNode* addInstancedMeshSceneNode(IMesh* mesh, ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0,0,0),
+			const core::vector3df& rotation = core::vector3df(0,0,0),
+			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f)) = 0;
+
 		//! Adds a scene node for rendering a animated water surface mesh.
 		/** Looks really good when the Material type EMT_TRANSPARENT_REFLECTION
 		is used.
@@ -1099,6 +1119,67 @@ namespace scene
 		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
 		virtual ISceneNode* getSceneNodeFromName(const c8* name, ISceneNode* start=0) = 0;
 
+		//! Enables or disables the index of scene node names and ids.
+		/** Without the index, getSceneNodeFromName() and
+		getSceneNodeFromId() visit the scene graph node by node until they
+		find a match. With the index enabled, a search of the whole scene
+		(start is null or the root scene node) for a name or id which no
+		node or only one node has is answered without visiting the scene
+		graph. Names and ids shared by several nodes are still searched for
+		in the scene graph, so the result is always the same as without the
+		index.
+		The index is kept up to date whenever a node is added to or removed
+		from the scene, or its name or id is changed with setName() or
+		setID(), which makes these a little slower. It is disabled by
+		default.
+		\param enable True to build the index, false to free it. */
+		virtual void setSceneNodeIndexEnabled(bool enable) = 0;
+
+		//! Check if the index of scene node names and ids is enabled.
+		/** \return True if it is enabled, see setSceneNodeIndexEnabled(). */
+		virtual bool isSceneNodeIndexEnabled() const = 0;
+
+		//! Enables or disables the bounding volume hierarchy used for culling.
+		/** Without the hierarchy, isCulled() tests every registered node
+		on its own. With the hierarchy enabled, drawAll() first tests groups
+		of nodes which are close to each other against the view frustum of
+		the active camera, and isCulled() only looks up the result for
+		EAC_BOX and for most nodes with EAC_FRUSTUM_BOX. Nodes close to a
+		frustum plane are still tested on their own, so the result is
+		always the same as without the hierarchy.
+		Nodes which moved or whose bounding box changed are tested on their
+		own once and refitted into the hierarchy in the next drawAll(). It
+		is rebuilt after many nodes were added, removed or moved. This pays
+		off for scenes with many nodes, of which most are outside of the
+		view. It is disabled by default.
+		\param enable True to build the hierarchy, false to free it. */
+		virtual void setCullingHierarchyEnabled(bool enable) = 0;
+
+		//! Check if the bounding volume hierarchy used for culling is enabled.
+		/** \return True if it is enabled, see setCullingHierarchyEnabled(). */
+		virtual bool isCullingHierarchyEnabled() const = 0;
+
+		//! Sets the number of threads which animate the scene in drawAll().
+		/** With one thread, which is the default, the scene nodes are
+		animated one after another by ISceneNode::OnAnimate(). With more
+		threads, the scene graph is split into subtrees below the root
+		scene node, which are animated in parallel. Animators and
+		OnAnimate() of scene nodes must then only change the subtree they
+		are in, and must not change data shared with other subtrees.
+		Subtrees with animated meshes, text, water surfaces, cameras, or
+		camera and collision response animators use shared data, and are
+		animated after the others on the thread calling drawAll().
+		Children added or removed, nodes added to the deletion queue and
+		changed names and ids while the scene is animated take effect
+		after all subtrees were animated, in the same order for any number
+		of threads greater than one.
+		\param count Number of threads, including the one calling drawAll(). */
+		virtual void setAnimationThreadCount(u32 count) = 0;
+
+		//! Get the number of threads which animate the scene in drawAll().
+		/** \return The number of threads, see setAnimationThreadCount(). */
+		virtual u32 getAnimationThreadCount() const = 0;
+
 		//! Get the first scene node with the specified type.
 		/** \param type: The type to search for
 		\param start: Scene node to start from. All children of this scene
@@ -1439,6 +1520,18 @@ namespace scene
 		COLLADA_CREATE_SCENE_INSTANCES, DMF_TEXTURE_PATH and DMF_USE_MATERIALS_DIRS*/
 		virtual io::IAttributes* getParameters() = 0;
 
+		//! Get typed copies of the parameters used while rendering.
+		/** Scene nodes should use these in their render() methods instead
+		of looking the values up with getParameters(). The copies are
+		updated after a parameter was changed.
+		\return The parameters, see SSceneParameters. */
+		virtual const SSceneParameters& getSceneParameters() = 0;
+
+		//! Get the counters of the last drawAll() call.
+		/** Counting is cheap, so they are always available.
+		\return The statistics, see SSceneStatistics. */
+		virtual const SSceneStatistics& getSceneStatistics() const = 0;
+
 		//! Get current render pass.
 		/** All scene nodes are being rendered in a specific order.
 		First lights, cameras, sky boxes, solid geometry, and then transparent
@@ -61,8 +61,14 @@ namespace scene
 		//! Destructor
 		virtual ~ISceneNode()
 		{
-			// delete all children
-			removeAll();
+			// delete all children. A node which is deleted is not part
+			// of a scene anymore, so nobody has to be told about it.
+			ISceneNodeList::Iterator it = Children.begin();
+			for (; it != Children.end(); ++it)
+			{
+				(*it)->Parent = 0;
+				(*it)->drop();
+			}
 
 			// delete all animators
 			ISceneNodeAnimatorList::Iterator ait = Animators.begin();
@@ -151,6 +157,7 @@ namespace scene
 		virtual void setName(const c8* name)
 		{
 			Name = name;
+			notifySceneNodeChanged(this, false);
 		}
 
 
@@ -159,6 +166,7 @@ namespace scene
 		virtual void setName(const core::stringc& name)
 		{
 			Name = name;
+			notifySceneNodeChanged(this, false);
 		}
 
 
@@ -270,6 +278,7 @@ namespace scene
 		virtual void setID(s32 id)
 		{
 			ID = id;
+			notifySceneNodeChanged(this, false);
 		}
 
 
@@ -281,6 +290,9 @@ namespace scene
 		{
 			if (child && (child != this))
 			{
+				if (deferSceneNodeChange(child, true))
+					return;
+
 				// Change scene manager?
 				if (SceneManager != child->SceneManager)
 					child->setSceneManager(SceneManager);
@@ -289,6 +301,7 @@ namespace scene
 				child->remove(); // remove from old parent
 				Children.push_back(child);
 				child->Parent = this;
+				notifySceneNodeChanged(child, true);
 			}
 		}
 
@@ -305,7 +318,11 @@ namespace scene
 			for (; it != Children.end(); ++it)
 				if ((*it) == child)
 				{
+					if (deferSceneNodeChange(child, false))
+						return true;
+
 					(*it)->Parent = 0;
+					notifySceneNodeChanged(child, true);
 					(*it)->drop();
 					Children.erase(it);
 					return true;
@@ -322,10 +339,14 @@ namespace scene
 		*/
 		virtual void removeAll()
 		{
+			if (deferSceneNodeChange(0, false))
+				return;
+
 			ISceneNodeList::Iterator it = Children.begin();
 			for (; it != Children.end(); ++it)
 			{
 				(*it)->Parent = 0;
+				notifySceneNodeChanged(*it, true);
 				(*it)->drop();
 			}
 
@@ -713,8 +734,8 @@ namespace scene
 		{
 			if (!in)
 				return;
-			Name = in->getAttributeAsString("Name");
-			ID = in->getAttributeAsInt("Id");
+			setName(in->getAttributeAsString("Name"));
+			setID(in->getAttributeAsInt("Id"));
 
 			setPosition(in->getAttributeAsVector3d("Position"));
 			setRotation(in->getAttributeAsVector3d("Rotation"));
@@ -747,8 +768,49 @@ namespace scene
 		/** \return The node's scene manager. */
 		virtual ISceneManager* getSceneManager(void) const { return SceneManager; }
 
+		//! Called on the root of a scene graph after a node in it changed.
+		/** This happens when the name or id of the node changes, or when
+		it is added to or removed from a parent. The scene manager uses
+		this to keep its index of scene node names and ids and its culling
+		hierarchy up to date (see ISceneManager::setSceneNodeIndexEnabled()
+		and ISceneManager::setCullingHierarchyEnabled()).
+		\param node The node which changed. It may already have been
+		removed from the scene graph.
+		\param recursive True if all children of node changed as well,
+		because node was added or removed. */
+		virtual void OnSceneNodeChanged(ISceneNode* node, bool recursive) {}
+
+		//! Called on the root of a scene graph before a node in it gets a new child or loses one.
+		/** The scene manager uses this to make these changes after it
+		animated the scene on several threads (see
+		ISceneManager::setAnimationThreadCount()).
+		\param parent The node whose children change.
+		\param child The node which is added to or removed from parent, or
+		0 if all children of parent are removed.
+		\param add True if child is added to parent.
+		\return True if the change is made later and must not be made now. */
+		virtual bool OnSceneNodeChanging(ISceneNode* parent, ISceneNode* child, bool add) { return false; }
+
 	protected:
 
+		//! Tells the root of the scene graph this node is in about a changed node.
+		void notifySceneNodeChanged(ISceneNode* node, bool recursive)
+		{
+			ISceneNode* root = this;
+			while (root->Parent)
+				root = root->Parent;
+			root->OnSceneNodeChanged(node, recursive);
+		}
+
+		//! Asks the root of the scene graph this node is in whether a change of its children has to wait.
+		bool deferSceneNodeChange(ISceneNode* child, bool add)
+		{
+			ISceneNode* root = this;
+			while (root->Parent)
+				root = root->Parent;
+			return root->OnSceneNodeChanging(this, child, add);
+		}
+
 		//! A clone function for the ISceneNode members.
 		/** This method can be used by clone() implementations of
 		derived classes
@@ -756,12 +818,12 @@ namespace scene
 		\param newManager The new scene manager. */
 		void cloneMembers(ISceneNode* toCopyFrom, ISceneManager* newManager)
 		{
-			Name = toCopyFrom->Name;
+			setName(toCopyFrom->Name);
 			AbsoluteTransformation = toCopyFrom->AbsoluteTransformation;
 			RelativeTranslation = toCopyFrom->RelativeTranslation;
 			RelativeRotation = toCopyFrom->RelativeRotation;
 			RelativeScale = toCopyFrom->RelativeScale;
-			ID = toCopyFrom->ID;
+			setID(toCopyFrom->ID);
 			setTriangleSelector(toCopyFrom->TriangleSelector);
 			AutomaticCullingState = toCopyFrom->AutomaticCullingState;
 			DebugDataVisible = toCopyFrom->DebugDataVisible;
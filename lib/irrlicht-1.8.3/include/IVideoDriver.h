@@ -503,6 +503,21 @@ namespace video
 		actual value of pixels. */
 		virtual u32 getOcclusionQueryResult(scene::ISceneNode* node) const =0;
 
+		//! Test boxes for visibility against the depth buffer.
+		/** Draws the boxes without changing the color or depth buffer
+		and counts the pixels of each which pass the depth test, so
+		many scene nodes can be tested at once after the occluders were
+		drawn. The current view and projection transformations and view
+		port are used, the world transformation and material are kept.
+		\param boxes Boxes in world coordinates, e.g. from
+		ISceneNode::getTransformedBoundingBox().
+		\param count Number of boxes.
+		\param samples Receives the number of visible pixels of each
+		box. The value is a safe approximation, i.e. can be larger than
+		the actual value of pixels. Drivers which cannot test boxes
+		return ~0 for all of them. */
+		virtual void testOcclusionBoxes(const core::aabbox3df* boxes, u32 count, u32* samples) =0;
+
 		//! Sets a boolean alpha channel on the texture based on a color key.
 		/** This makes the texture fully transparent at the texels where
 		this color key can be found when using for example draw2DImage
@@ -1082,6 +1097,20 @@ namespace video
 		\return Amount of primitives drawn in the last frame. */
 		virtual u32 getPrimitiveCountDrawn( u32 mode =0 ) const =0;
 
+		//! Returns the number of draw calls made since beginScene().
+		/** Every drawVertexPrimitiveList(), draw2DVertexPrimitiveList()
+		and hardware buffer draw counts as one call, also when a driver
+		splits it up internally.
+		\return Amount of draw calls in the current frame. */
+		virtual u32 getDrawCallCount() const =0;
+
+		//! Returns how often a changed material was applied since beginScene().
+		/** Setting the material which is already active is not counted
+		by drivers which skip that. The null driver counts each material
+		which differs from the one set before.
+		\return Amount of material changes in the current frame. */
+		virtual u32 getMaterialChangeCount() const =0;
+
 		//! Deletes all dynamic lights which were previously added with addDynamicLight().
 		virtual void deleteAllDynamicLights() =0;
 
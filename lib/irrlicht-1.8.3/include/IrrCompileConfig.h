@@ -36,6 +36,7 @@
 //! _IRR_COMPILE_WITH_SDL_DEVICE_ for platform independent SDL framework
 //! _IRR_COMPILE_WITH_CONSOLE_DEVICE_ for no windowing system, used as a fallback
 //! _IRR_COMPILE_WITH_FB_DEVICE_ for framebuffer systems
+//! _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_ for rendering into memory without any display
 
 //! Passing defines to the compiler which have NO in front of the _IRR definename is an alternative
 //! way which can be used to disable defines (instead of outcommenting them in this header).
@@ -56,6 +57,12 @@
 #undef _IRR_COMPILE_WITH_CONSOLE_DEVICE_
 #endif
 
+//! Comment this line to compile without the offscreen device.
+#define _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+#ifdef NO_IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+#undef _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+#endif
+
 //! WIN32 for Windows32
 //! WIN64 for Windows64
 // The windows platform and API support SDL and WINDOW device
@@ -517,9 +524,7 @@ B3D, MS3D or X meshes */
 #undef _IRR_COMPILE_WITH_PSD_LOADER_
 #endif
 //! Define _IRR_COMPILE_WITH_DDS_LOADER_ if you want to load .dds files
-// Outcommented because
-// a) it doesn't compile on 64-bit currently
-// b) anyone enabling it should be aware that S3TC compression algorithm which might be used in that loader
+// Outcommented because anyone enabling it should be aware that S3TC compression algorithm which might be used in that loader
 // is patented in the US by S3 and they do collect license fees when it's used in applications.
 // So if you are unfortunate enough to develop applications for US market and their broken patent system be careful.
 // #define _IRR_COMPILE_WITH_DDS_LOADER_
@@ -814,19 +819,5 @@ precision will be lower but speed higher. currently X86 only
 
 #endif
 
-#ifdef _DEBUG
-	//! A few attributes are written in CSceneManager when _IRR_SCENEMANAGER_DEBUG is enabled
-	// NOTE: Those attributes were used always until 1.8.0 and became a global define for 1.8.1
-	// which is only enabled in debug because it had a large (sometimes >5%) impact on speed.
-	// A better solution in the long run is to break the interface and remove _all_ attribute
-	// access in functions like CSceneManager::drawAll and instead put that information in some
-	// own struct/class or in CSceneManager.
-	// See http://irrlicht.sourceforge.net/forum/viewtopic.php?f=2&t=48211 for the discussion.
-	#define _IRR_SCENEMANAGER_DEBUG
-	#ifdef NO_IRR_SCENEMANAGER_DEBUG
-		#undef _IRR_SCENEMANAGER_DEBUG
-	#endif
-#endif
-
 #endif // __IRR_COMPILE_CONFIG_H_INCLUDED__
 
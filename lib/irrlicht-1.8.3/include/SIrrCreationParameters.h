@@ -9,6 +9,7 @@
 #include "EDeviceTypes.h"
 #include "dimension2d.h"
 #include "ILogger.h"
+#include "path.h"
 
 namespace irr
 {
@@ -45,6 +46,9 @@ namespace irr
 			DisplayAdapter(0),
 			DriverMultithreaded(false),
 			UsePerformanceTimer(true),
+			RasterThreads(1),
+			CaptureThreads(1),
+			CaptureQueueSize(4),
 			SDK_version_do_not_use(IRRLICHT_SDK_VERSION)
 		{
 		}
@@ -76,6 +80,10 @@ namespace irr
 			DriverMultithreaded = other.DriverMultithreaded;
 			DisplayAdapter = other.DisplayAdapter;
 			UsePerformanceTimer = other.UsePerformanceTimer;
+			RasterThreads = other.RasterThreads;
+			CaptureFileName = other.CaptureFileName;
+			CaptureThreads = other.CaptureThreads;
+			CaptureQueueSize = other.CaptureQueueSize;
 			return *this;
 		}
 
@@ -88,6 +96,7 @@ namespace irr
 		EIDT_X11 is available on Linux, Solaris, BSD and other operating systems which use X11,
 		EIDT_SDL is available on most systems if compiled in,
 		EIDT_CONSOLE is usually available but can only render to text,
+		EIDT_OFFSCREEN is usually available and renders into memory only,
 		EIDT_BEST will select the best available device for your operating system.
 		Default: EIDT_BEST. */
 		E_DEVICE_TYPE DeviceType;
@@ -283,6 +292,32 @@ namespace irr
 		*/
 		bool UsePerformanceTimer;
 
+		//! Number of threads which rasterize triangles.
+		/** Default is 1. With more threads, each thread draws a part of
+		the rows of the render target, which gives the same image faster
+		on machines with several cores. So far only supported by
+		Burning's Video. */
+		u32 RasterThreads;
+
+		//! File names to write the rendered frames to.
+		/** A printf() format with the number of the frame, counted
+		from 0, for example "frames/%05u.png". The extension selects
+		the image writer, "raw" writes the pixels as R8G8B8 without a
+		header. Each presented frame is copied and written by
+		background threads, so rendering goes on while frames are
+		encoded. Default is empty, which writes no frames. So far only
+		supported by the EIDT_OFFSCREEN device. */
+		io::path CaptureFileName;
+
+		//! Number of threads which write the frames of CaptureFileName.
+		/** Default is 1. */
+		u32 CaptureThreads;
+
+		//! Number of frames which can wait for being written.
+		/** When that many frames wait, the next presented frame waits
+		for the first of them to be written. Default is 4. */
+		u32 CaptureQueueSize;
+
 		//! Don't use or change this parameter.
 		/** Always set it to IRRLICHT_SDK_VERSION, which is done by default.
 		This is needed for sdk version checks. */
@@ -0,0 +1,79 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __S_SCENE_STATISTICS_H_INCLUDED__
+#define __S_SCENE_STATISTICS_H_INCLUDED__
+
+#include "irrTypes.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! Counters of the last ISceneManager::drawAll() call.
+	/** The scene manager resets them when drawAll() starts, so nodes
+	registered for rendering outside of drawAll() are not counted. Get them
+	with ISceneManager::getSceneStatistics(). */
+	struct SSceneStatistics
+	{
+		SSceneStatistics()
+		{
+			reset();
+		}
+
+		//! Sets all counters to 0.
+		void reset()
+		{
+			Registered = 0;
+			Culled = 0;
+			DrawnSolid = 0;
+			DrawnTransparent = 0;
+			DrawnTransparentEffect = 0;
+			DrawCalls = 0;
+			StateChanges = 0;
+			SortTime = 0;
+			CullTime = 0;
+			DrawTime = 0;
+		}
+
+		//! Calls of ISceneManager::registerNodeForRendering()
+		u32 Registered;
+
+		//! Registered nodes which were not taken because they were culled
+		u32 Culled;
+
+		//! Nodes rendered in the solid pass
+		u32 DrawnSolid;
+
+		//! Nodes rendered in the transparent pass
+		u32 DrawnTransparent;
+
+		//! Nodes rendered in the transparent effect pass
+		u32 DrawnTransparentEffect;
+
+		//! Draw calls the video driver made while drawing the scene
+		/** See video::IVideoDriver::getDrawCallCount(). */
+		u32 DrawCalls;
+
+		//! Materials the video driver applied while drawing the scene
+		/** See video::IVideoDriver::getMaterialChangeCount(). */
+		u32 StateChanges;
+
+		//! Microseconds spent sorting the nodes of the render passes
+		u32 SortTime;
+
+		//! Microseconds spent testing the culling hierarchy against the view
+		/** See ISceneManager::setCullingHierarchyEnabled(). */
+		u32 CullTime;
+
+		//! Microseconds drawAll() took, including animating the nodes
+		u32 DrawTime;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -22,7 +22,7 @@ struct SSkinMeshBuffer : public IMeshBuffer
 	SSkinMeshBuffer(video::E_VERTEX_TYPE vt=video::EVT_STANDARD) :
 		ChangedID_Vertex(1), ChangedID_Index(1), VertexType(vt),
 		MappingHint_Vertex(EHM_NEVER), MappingHint_Index(EHM_NEVER),
-		BoundingBoxNeedsRecalculated(true)
+		PrimitiveType(EPT_TRIANGLES), BoundingBoxNeedsRecalculated(true)
 	{
 		#ifdef _DEBUG
 		setDebugName("SSkinMeshBuffer");
@@ -370,6 +370,18 @@ struct SSkinMeshBuffer : public IMeshBuffer
 
 	virtual u32 getChangedID_Index() const {return ChangedID_Index;}
 
+	//! Describe what kind of primitive geometry is used by the meshbuffer
+	virtual void setPrimitiveType(E_PRIMITIVE_TYPE type)
+	{
+		PrimitiveType = type;
+	}
+
+	//! Get the kind of primitive geometry which is used by the meshbuffer
+	virtual E_PRIMITIVE_TYPE getPrimitiveType() const
+	{
+		return PrimitiveType;
+	}
+
 	//! Call this after changing the positions of any vertex.
 	void boundingBoxNeedsRecalculated(void) { BoundingBoxNeedsRecalculated = true; }
 
@@ -393,6 +405,8 @@ struct SSkinMeshBuffer : public IMeshBuffer
 	E_HARDWARE_MAPPING MappingHint_Vertex:3;
 	E_HARDWARE_MAPPING MappingHint_Index:3;
 
+	E_PRIMITIVE_TYPE PrimitiveType;
+
 	bool BoundingBoxNeedsRecalculated:1;
 };
 
@@ -12,6 +12,8 @@
 	to modify the behavior of plugins and mesh loaders.
 */
 
+#include "SColor.h"
+
 namespace irr
 {
 namespace scene
@@ -174,6 +176,31 @@ namespace scene
 	**/
 	const c8* const DEBUG_NORMAL_COLOR = "DEBUG_Normal_Color";
 
+	//! Typed copies of the scene parameters which are read while rendering.
+	/** The scene manager updates them after one of the parameters was
+	changed with ISceneManager::getParameters(), so the render path does not
+	need to look up attributes by name. Get them with
+	ISceneManager::getSceneParameters(). */
+	struct SSceneParameters
+	{
+		SSceneParameters()
+			: DebugNormalLength(1.f), DebugNormalColor(255, 34, 221, 221),
+			AllowZWriteOnTransparent(false), IsEditor(false)
+		{
+		}
+
+		//! Value of DEBUG_NORMAL_LENGTH
+		f32 DebugNormalLength;
+
+		//! Value of DEBUG_NORMAL_COLOR
+		video::SColor DebugNormalColor;
+
+		//! Value of ALLOW_ZWRITE_ON_TRANSPARENT
+		bool AllowZWriteOnTransparent;
+
+		//! Value of IRR_SCENE_MANAGER_IS_EDITOR
+		bool IsEditor;
+	};
 
 } // end namespace scene
 } // end namespace irr
@@ -111,6 +111,7 @@
 #include "IMeshLoader.h"
 #include "IMeshManipulator.h"
 #include "IMeshSceneNode.h"
+#include "IInstancedMeshSceneNode.h"
 #include "IMeshWriter.h"
 #include "IColladaMeshWriter.h"
 #include "IMetaTriangleSelector.h"
@@ -172,6 +173,7 @@
 #include "SExposedVideoData.h"
 #include "SIrrCreationParameters.h"
 #include "SKeyMap.h"
+#include "SSceneStatistics.h"
 #include "SLight.h"
 #include "SMaterial.h"
 #include "SMesh.h"
@@ -14,7 +14,7 @@ namespace io
 {
 
 CAttributes::CAttributes(video::IVideoDriver* driver)
-: Driver(driver)
+: Driver(driver), ChangedID(1)
 {
 	#ifdef _DEBUG
 	setDebugName("CAttributes");
@@ -36,6 +36,7 @@ CAttributes::~CAttributes()
 //! Removes all attributes
 void CAttributes::clear()
 {
+	++ChangedID;
 	for (u32 i=0; i<Attributes.size(); ++i)
 		Attributes[i]->drop();
 
@@ -48,6 +49,7 @@ void CAttributes::clear()
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const c8* value)
 {
+	++ChangedID;
 	for (u32 i=0; i<Attributes.size(); ++i)
 		if (Attributes[i]->Name == attributeName)
 		{
@@ -116,6 +118,7 @@ core::stringc CAttributes::getAttributeAsString(s32 index)
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const wchar_t* value)
 {
+	++ChangedID;
 	for (u32 i=0; i<Attributes.size(); ++i)
 	{
 		if (Attributes[i]->Name == attributeName)
@@ -183,12 +186,14 @@ core::stringw CAttributes::getAttributeAsStringW(s32 index)
 //! Adds an attribute as an array of wide strings
 void CAttributes::addArray(const c8* attributeName, const core::array<core::stringw>& value)
 {
+	++ChangedID;
 	Attributes.push_back(new CStringWArrayAttribute(attributeName, value));
 }
 
 //! Sets an attribute value as an array of wide strings.
 void CAttributes::setAttribute(const c8* attributeName, const core::array<core::stringw>& value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setArray(value);
@@ -222,6 +227,7 @@ core::array<core::stringw> CAttributes::getAttributeAsArray(s32 index)
 //! Sets an attribute as an array of wide strings
 void CAttributes::setAttribute(s32 index, const core::array<core::stringw>& value)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setArray(value);
 }
@@ -253,6 +259,7 @@ IAttribute* CAttributes::getAttributeP(const c8* attributeName) const
 //! Sets a attribute as boolean value
 void CAttributes::setAttribute(const c8* attributeName, bool value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setBool(value);
@@ -281,6 +288,7 @@ bool CAttributes::getAttributeAsBool(const c8* attributeName)
 //! Sets a attribute as integer value
 void CAttributes::setAttribute(const c8* attributeName, s32 value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setInt(value);
@@ -306,6 +314,7 @@ s32 CAttributes::getAttributeAsInt(const c8* attributeName) const
 //! Sets a attribute as float value
 void CAttributes::setAttribute(const c8* attributeName, f32 value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setFloat(value);
@@ -329,6 +338,7 @@ f32 CAttributes::getAttributeAsFloat(const c8* attributeName)
 //! Sets a attribute as color
 void CAttributes::setAttribute(const c8* attributeName, video::SColor value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setColor(value);
@@ -353,6 +363,7 @@ video::SColor CAttributes::getAttributeAsColor(const c8* attributeName)
 //! Sets a attribute as floating point color
 void CAttributes::setAttribute(const c8* attributeName, video::SColorf value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setColor(value);
@@ -375,6 +386,7 @@ video::SColorf CAttributes::getAttributeAsColorf(const c8* attributeName)
 //! Sets a attribute as 2d position
 void CAttributes::setAttribute(const c8* attributeName, core::position2di value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setPosition(value);
@@ -397,6 +409,7 @@ core::position2di CAttributes::getAttributeAsPosition2d(const c8* attributeName)
 //! Sets a attribute as rectangle
 void CAttributes::setAttribute(const c8* attributeName, core::rect<s32> value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setRect(value);
@@ -419,6 +432,7 @@ core::rect<s32> CAttributes::getAttributeAsRect(const c8* attributeName)
 //! Sets a attribute as dimension2d
 void CAttributes::setAttribute(const c8* attributeName, core::dimension2d<u32> value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setDimension2d(value);
@@ -441,6 +455,7 @@ core::dimension2d<u32> CAttributes::getAttributeAsDimension2d(const c8* attribut
 //! Sets a attribute as vector
 void CAttributes::setAttribute(const c8* attributeName, core::vector3df value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setVector(value);
@@ -451,6 +466,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::vector3df value)
 //! Sets a attribute as vector
 void CAttributes::setAttribute(const c8* attributeName, core::vector2df value)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setVector2d(value);
@@ -483,6 +499,7 @@ core::vector2df CAttributes::getAttributeAsVector2d(const c8* attributeName)
 //! Sets an attribute as binary data
 void CAttributes::setAttribute(const c8* attributeName, void* data, s32 dataSizeInBytes )
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setBinary(data, dataSizeInBytes);
@@ -502,6 +519,7 @@ void CAttributes::getAttributeAsBinaryData(const c8* attributeName, void* outDat
 //! Sets an attribute as enumeration
 void CAttributes::setAttribute(const c8* attributeName, const char* enumValue, const char* const* enumerationLiterals)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setEnum(enumValue, enumerationLiterals);
@@ -553,6 +571,7 @@ void CAttributes::getAttributeEnumerationLiteralsOfEnumeration(const c8* attribu
 //! Sets an attribute as texture reference
 void CAttributes::setAttribute(const c8* attributeName, video::ITexture* value, const io::path& filename)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setTexture(value, filename);
@@ -802,42 +821,49 @@ void CAttributes::getAttributeEnumerationLiteralsOfEnumeration(s32 index, core::
 //! Adds an attribute as integer
 void CAttributes::addInt(const c8* attributeName, s32 value)
 {
+	++ChangedID;
 	Attributes.push_back(new CIntAttribute(attributeName, value));
 }
 
 //! Adds an attribute as float
 void CAttributes::addFloat(const c8* attributeName, f32 value)
 {
+	++ChangedID;
 	Attributes.push_back(new CFloatAttribute(attributeName, value));
 }
 
 //! Adds an attribute as string
 void CAttributes::addString(const c8* attributeName, const char* value)
 {
+	++ChangedID;
 	Attributes.push_back(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as wchar string
 void CAttributes::addString(const c8* attributeName, const wchar_t* value)
 {
+	++ChangedID;
 	Attributes.push_back(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as bool
 void CAttributes::addBool(const c8* attributeName, bool value)
 {
+	++ChangedID;
 	Attributes.push_back(new CBoolAttribute(attributeName, value));
 }
 
 //! Adds an attribute as enum
 void CAttributes::addEnum(const c8* attributeName, const char* enumValue, const char* const* enumerationLiterals)
 {
+	++ChangedID;
 	Attributes.push_back(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
 }
 
 //! Adds an attribute as enum
 void CAttributes::addEnum(const c8* attributeName, s32 enumValue, const char* const* enumerationLiterals)
 {
+	++ChangedID;
 	addEnum(attributeName, "", enumerationLiterals);
 	Attributes.getLast()->setInt(enumValue);
 }
@@ -845,24 +871,28 @@ void CAttributes::addEnum(const c8* attributeName, s32 enumValue, const char* co
 //! Adds an attribute as color
 void CAttributes::addColor(const c8* attributeName, video::SColor value)
 {
+	++ChangedID;
 	Attributes.push_back(new CColorAttribute(attributeName, value));
 }
 
 //! Adds an attribute as floating point color
 void CAttributes::addColorf(const c8* attributeName, video::SColorf value)
 {
+	++ChangedID;
 	Attributes.push_back(new CColorfAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 3d vector
 void CAttributes::addVector3d(const c8* attributeName, core::vector3df value)
 {
+	++ChangedID;
 	Attributes.push_back(new CVector3DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 2d vector
 void CAttributes::addVector2d(const c8* attributeName, core::vector2df value)
 {
+	++ChangedID;
 	Attributes.push_back(new CVector2DAttribute(attributeName, value));
 }
 
@@ -870,30 +900,35 @@ void CAttributes::addVector2d(const c8* attributeName, core::vector2df value)
 //! Adds an attribute as 2d position
 void CAttributes::addPosition2d(const c8* attributeName, core::position2di value)
 {
+	++ChangedID;
 	Attributes.push_back(new CPosition2DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as rectangle
 void CAttributes::addRect(const c8* attributeName, core::rect<s32> value)
 {
+	++ChangedID;
 	Attributes.push_back(new CRectAttribute(attributeName, value));
 }
 
 //! Adds an attribute as dimension2d
 void CAttributes::addDimension2d(const c8* attributeName, core::dimension2d<u32> value)
 {
+	++ChangedID;
 	Attributes.push_back(new CDimension2dAttribute(attributeName, value));
 }
 
 //! Adds an attribute as binary data
 void CAttributes::addBinary(const c8* attributeName, void* data, s32 dataSizeInBytes)
 {
+	++ChangedID;
 	Attributes.push_back(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
 }
 
 //! Adds an attribute as texture reference
 void CAttributes::addTexture(const c8* attributeName, video::ITexture* texture, const io::path& filename)
 {
+	++ChangedID;
 	Attributes.push_back(new CTextureAttribute(attributeName, texture, Driver, filename));
 }
 
@@ -907,6 +942,7 @@ bool CAttributes::existsAttribute(const c8* attributeName)
 //! \param attributeName: Name for the attribute
 void CAttributes::setAttribute(s32 index, const c8* value)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setString(value);
 }
@@ -915,6 +951,7 @@ void CAttributes::setAttribute(s32 index, const c8* value)
 //! \param attributeName: Name for the attribute
 void CAttributes::setAttribute(s32 index, const wchar_t* value)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setString(value);
 }
@@ -922,6 +959,7 @@ void CAttributes::setAttribute(s32 index, const wchar_t* value)
 //! Sets an attribute as boolean value
 void CAttributes::setAttribute(s32 index, bool value)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setBool(value);
 }
@@ -929,6 +967,7 @@ void CAttributes::setAttribute(s32 index, bool value)
 //! Sets an attribute as integer value
 void CAttributes::setAttribute(s32 index, s32 value)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setInt(value);
 }
@@ -936,6 +975,7 @@ void CAttributes::setAttribute(s32 index, s32 value)
 //! Sets a attribute as float value
 void CAttributes::setAttribute(s32 index, f32 value)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setFloat(value);
 }
@@ -943,6 +983,7 @@ void CAttributes::setAttribute(s32 index, f32 value)
 //! Sets a attribute as color
 void CAttributes::setAttribute(s32 index, video::SColor color)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setColor(color);
 }
@@ -950,6 +991,7 @@ void CAttributes::setAttribute(s32 index, video::SColor color)
 //! Sets a attribute as floating point color
 void CAttributes::setAttribute(s32 index, video::SColorf color)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setColor(color);
 }
@@ -957,6 +999,7 @@ void CAttributes::setAttribute(s32 index, video::SColorf color)
 //! Sets a attribute as vector
 void CAttributes::setAttribute(s32 index, core::vector3df v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setVector(v);
 }
@@ -964,6 +1007,7 @@ void CAttributes::setAttribute(s32 index, core::vector3df v)
 //! Sets a attribute as vector
 void CAttributes::setAttribute(s32 index, core::vector2df v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setVector2d(v);
 }
@@ -971,6 +1015,7 @@ void CAttributes::setAttribute(s32 index, core::vector2df v)
 //! Sets a attribute as position
 void CAttributes::setAttribute(s32 index, core::position2di v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setPosition(v);
 }
@@ -978,6 +1023,7 @@ void CAttributes::setAttribute(s32 index, core::position2di v)
 //! Sets a attribute as rectangle
 void CAttributes::setAttribute(s32 index, core::rect<s32> v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setRect(v);
 }
@@ -985,6 +1031,7 @@ void CAttributes::setAttribute(s32 index, core::rect<s32> v)
 //! Sets a attribute as dimension2d
 void CAttributes::setAttribute(s32 index, core::dimension2d<u32> v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setDimension2d(v);
 }
@@ -992,6 +1039,7 @@ void CAttributes::setAttribute(s32 index, core::dimension2d<u32> v)
 //! Sets an attribute as binary data
 void CAttributes::setAttribute(s32 index, void* data, s32 dataSizeInBytes )
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setBinary(data, dataSizeInBytes);
 }
@@ -1000,6 +1048,7 @@ void CAttributes::setAttribute(s32 index, void* data, s32 dataSizeInBytes )
 //! Sets an attribute as enumeration
 void CAttributes::setAttribute(s32 index, const char* enumValue, const char* const* enumerationLiterals)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setEnum(enumValue, enumerationLiterals);
 }
@@ -1008,6 +1057,7 @@ void CAttributes::setAttribute(s32 index, const char* enumValue, const char* con
 //! Sets an attribute as texture reference
 void CAttributes::setAttribute(s32 index, video::ITexture* texture, const io::path& filename)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setTexture(texture, filename);
 }
@@ -1016,6 +1066,7 @@ void CAttributes::setAttribute(s32 index, video::ITexture* texture, const io::pa
 //! Adds an attribute as matrix
 void CAttributes::addMatrix(const c8* attributeName, const core::matrix4& v)
 {
+	++ChangedID;
 	Attributes.push_back(new CMatrixAttribute(attributeName, v));
 }
 
@@ -1023,6 +1074,7 @@ void CAttributes::addMatrix(const c8* attributeName, const core::matrix4& v)
 //! Sets an attribute as matrix
 void CAttributes::setAttribute(const c8* attributeName, const core::matrix4& v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setMatrix(v);
@@ -1053,6 +1105,7 @@ core::matrix4 CAttributes::getAttributeAsMatrix(s32 index)
 //! Sets an attribute as matrix
 void CAttributes::setAttribute(s32 index, const core::matrix4& v)
 {
+	++ChangedID;
 	if ((u32)index < Attributes.size())
 		Attributes[index]->setMatrix(v);
 }
@@ -1061,6 +1114,7 @@ void CAttributes::setAttribute(s32 index, const core::matrix4& v)
 //! Adds an attribute as quaternion
 void CAttributes::addQuaternion(const c8* attributeName, core::quaternion v)
 {
+	++ChangedID;
 	Attributes.push_back(new CQuaternionAttribute(attributeName, v));
 }
 
@@ -1068,6 +1122,7 @@ void CAttributes::addQuaternion(const c8* attributeName, core::quaternion v)
 //! Sets an attribute as quaternion
 void CAttributes::setAttribute(const c8* attributeName, core::quaternion v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setQuaternion(v);
@@ -1103,6 +1158,7 @@ core::quaternion CAttributes::getAttributeAsQuaternion(s32 index)
 //! Sets an attribute as quaternion
 void CAttributes::setAttribute(s32 index, core::quaternion v)
 {
+	++ChangedID;
 if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setQuaternion(v);
 }
@@ -1110,12 +1166,14 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as axis aligned bounding box
 void CAttributes::addBox3d(const c8* attributeName, core::aabbox3df v)
 {
+	++ChangedID;
 	Attributes.push_back(new CBBoxAttribute(attributeName, v));
 }
 
 //! Sets an attribute as axis aligned bounding box
 void CAttributes::setAttribute(const c8* attributeName, core::aabbox3df v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setBBox(v);
@@ -1151,6 +1209,7 @@ core::aabbox3df CAttributes::getAttributeAsBox3d(s32 index)
 //! Sets an attribute as axis aligned bounding box
 void CAttributes::setAttribute(s32 index, core::aabbox3df v)
 {
+	++ChangedID;
 if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setBBox(v);
 }
@@ -1158,12 +1217,14 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as 3d plane
 void CAttributes::addPlane3d(const c8* attributeName, core::plane3df v)
 {
+	++ChangedID;
 	Attributes.push_back(new CPlaneAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d plane
 void CAttributes::setAttribute(const c8* attributeName, core::plane3df v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setPlane(v);
@@ -1199,6 +1260,7 @@ core::plane3df CAttributes::getAttributeAsPlane3d(s32 index)
 //! Sets an attribute as 3d plane
 void CAttributes::setAttribute(s32 index, core::plane3df v)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setPlane(v);
 }
@@ -1206,12 +1268,14 @@ void CAttributes::setAttribute(s32 index, core::plane3df v)
 //! Adds an attribute as 3d triangle
 void CAttributes::addTriangle3d(const c8* attributeName, core::triangle3df v)
 {
+	++ChangedID;
 	Attributes.push_back(new CTriangleAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d triangle
 void CAttributes::setAttribute(const c8* attributeName, core::triangle3df v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setTriangle(v);
@@ -1249,6 +1313,7 @@ core::triangle3df CAttributes::getAttributeAsTriangle3d(s32 index)
 //! Sets an attribute as 3d triangle
 void CAttributes::setAttribute(s32 index, core::triangle3df v)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setTriangle(v);
 }
@@ -1256,12 +1321,14 @@ void CAttributes::setAttribute(s32 index, core::triangle3df v)
 //! Adds an attribute as a 2d line
 void CAttributes::addLine2d(const c8* attributeName, core::line2df v)
 {
+	++ChangedID;
 	Attributes.push_back(new CLine2dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 2d line
 void CAttributes::setAttribute(const c8* attributeName, core::line2df v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setLine2d(v);
@@ -1297,6 +1364,7 @@ core::line2df CAttributes::getAttributeAsLine2d(s32 index)
 //! Sets an attribute as a 2d line
 void CAttributes::setAttribute(s32 index, core::line2df v)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setLine2d(v);
 }
@@ -1304,12 +1372,14 @@ void CAttributes::setAttribute(s32 index, core::line2df v)
 //! Adds an attribute as a 3d line
 void CAttributes::addLine3d(const c8* attributeName, core::line3df v)
 {
+	++ChangedID;
 	Attributes.push_back(new CLine3dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 3d line
 void CAttributes::setAttribute(const c8* attributeName, core::line3df v)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setLine3d(v);
@@ -1345,6 +1415,7 @@ core::line3df CAttributes::getAttributeAsLine3d(s32 index)
 //! Sets an attribute as a 3d line
 void CAttributes::setAttribute(s32 index, core::line3df v)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setLine3d(v);
 
@@ -1354,12 +1425,14 @@ void CAttributes::setAttribute(s32 index, core::line3df v)
 //! Adds an attribute as user pointner
 void CAttributes::addUserPointer(const c8* attributeName, void* userPointer)
 {
+	++ChangedID;
 	Attributes.push_back(new CUserPointerAttribute(attributeName, userPointer));
 }
 
 //! Sets an attribute as user pointer
 void CAttributes::setAttribute(const c8* attributeName, void* userPointer)
 {
+	++ChangedID;
 	IAttribute* att = getAttributeP(attributeName);
 	if (att)
 		att->setUserPointer(userPointer);
@@ -1397,6 +1470,7 @@ void* CAttributes::getAttributeAsUserPointer(s32 index)
 //! Sets an attribute as user pointer
 void CAttributes::setAttribute(s32 index, void* userPointer)
 {
+	++ChangedID;
 	if (index >= 0 && index < (s32)Attributes.size() )
 		Attributes[index]->setUserPointer(userPointer);
 }
@@ -1408,6 +1482,7 @@ void CAttributes::setAttribute(s32 index, void* userPointer)
 bool CAttributes::read(io::IXMLReader* reader, bool readCurrentElementOnly,
 					    const wchar_t* nonDefaultElementName)
 {
+	++ChangedID;
 	if (!reader)
 		return false;
 
@@ -1445,6 +1520,7 @@ bool CAttributes::read(io::IXMLReader* reader, bool readCurrentElementOnly,
 
 void CAttributes::readAttributeFromXML(io::IXMLReader* reader)
 {
+	++ChangedID;
 	core::stringw element = reader->getNodeName();
 	core::stringc name = reader->getAttributeValue(L"name");
 
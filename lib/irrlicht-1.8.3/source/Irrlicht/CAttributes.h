@@ -59,6 +59,11 @@ public:
 	//! Removes all attributes
 	virtual void clear();
 
+	//! Returns a number which changes whenever an attribute is added, set or removed.
+	/** Lets users of the attributes keep typed copies of the values they
+	need and only read them again after a change. */
+	u32 getChangedID() const { return ChangedID; }
+
 	//! Reads attributes from a xml file.
 	//! \param readCurrentElementOnly: If set to true, reading only works if current element has the name 'attributes'.
 	//! IF set to false, the first appearing list attributes are read.
@@ -703,6 +708,8 @@ protected:
 	IAttribute* getAttributeP(const c8* attributeName) const;
 
 	video::IVideoDriver* Driver;
+
+	u32 ChangedID;
 };
 
 } // end namespace io
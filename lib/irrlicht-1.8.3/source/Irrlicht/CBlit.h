@@ -6,6 +6,12 @@
 #define _C_BLIT_H_INCLUDED_
 
 #include "SoftwareDriver2_helper.h"
+#include "CColorConverter.h"
+#include "CThreadPool.h"
+
+#ifdef SOFTWARE_DRIVER_2_SSE2
+	#include <emmintrin.h>
+#endif
 
 namespace irr
 {
@@ -33,7 +39,10 @@ namespace irr
 		float x_stretch;
 		float y_stretch;
 
-		SBlitJob() : stretch(false) {}
+		//! first row of this job inside the stretched blit it is a band of
+		u32 firstRow;
+
+		SBlitJob() : src(0), stretch(false), firstRow(0) {}
 	};
 
 	// Bitfields Cohen Sutherland
@@ -205,6 +214,107 @@ inline u32 PixelLerp32(const u32 source, const u32 value)
 	return srcRB | srcXG;
 }
 
+#ifdef SOFTWARE_DRIVER_2_SSE2
+
+/*!
+	32 bit lanes times a factor [0;65535] in both 16 bit halves, modulo 2^32
+	like the u32 multiplication of the scalar pixel functions
+*/
+static inline __m128i mul32_sse2 ( const __m128i a, const __m128i f )
+{
+	return _mm_add_epi32 ( _mm_mullo_epi16 ( a, f ), _mm_slli_epi32 ( _mm_mulhi_epu16 ( a, f ), 16 ) );
+}
+
+/*!
+	PixelBlend32 ( c2, c1, alpha ) of four pixels, alpha [0;256] in both
+	16 bit halves of each lane. The packed channels borrow from each other
+	exactly like in the scalar version.
+*/
+static inline __m128i PixelBlend32_sse2 ( const __m128i c2, const __m128i c1, const __m128i alpha )
+{
+	const __m128i maskRB = _mm_set1_epi32 ( 0x00FF00FF );
+	const __m128i maskXG = _mm_set1_epi32 ( 0x0000FF00 );
+
+	const __m128i dstRB = _mm_and_si128 ( c2, maskRB );
+	const __m128i dstXG = _mm_and_si128 ( c2, maskXG );
+
+	__m128i rb = _mm_sub_epi32 ( _mm_and_si128 ( c1, maskRB ), dstRB );
+	__m128i xg = _mm_sub_epi32 ( _mm_and_si128 ( c1, maskXG ), dstXG );
+
+	rb = _mm_srli_epi32 ( mul32_sse2 ( rb, alpha ), 8 );
+	xg = _mm_srli_epi32 ( mul32_sse2 ( xg, alpha ), 8 );
+
+	rb = _mm_and_si128 ( _mm_add_epi32 ( rb, dstRB ), maskRB );
+	xg = _mm_and_si128 ( _mm_add_epi32 ( xg, dstXG ), maskXG );
+
+	return _mm_or_si128 ( rb, xg );
+}
+
+/*!
+	PixelBlend32 ( c2, c1 ) of four pixels, blending with the alpha of c1
+*/
+static inline __m128i PixelBlend32_sse2 ( const __m128i c2, const __m128i c1 )
+{
+	const __m128i alphaMask = _mm_set1_epi32 ( 0xFF000000 );
+
+	// alpha [0;256], add highbit alpha
+	__m128i alpha = _mm_srli_epi32 ( c1, 24 );
+	const __m128i transparent = _mm_cmpeq_epi32 ( alpha, _mm_setzero_si128 () );
+	alpha = _mm_add_epi32 ( alpha, _mm_srli_epi32 ( alpha, 7 ) );
+	alpha = _mm_or_si128 ( alpha, _mm_slli_epi32 ( alpha, 16 ) );
+
+	const __m128i blend = _mm_or_si128 ( _mm_and_si128 ( c1, alphaMask ), PixelBlend32_sse2 ( c2, c1, alpha ) );
+
+	// fully transparent pixels keep the destination
+	return _mm_or_si128 ( _mm_and_si128 ( transparent, c2 ), _mm_andnot_si128 ( transparent, blend ) );
+}
+
+/*!
+	PixelMul32_2 of four pixels
+*/
+static inline __m128i PixelMul32_2_sse2 ( const __m128i c0, const __m128i c1 )
+{
+	const __m128i zero = _mm_setzero_si128 ();
+	const __m128i lo = _mm_srli_epi16 ( _mm_mullo_epi16 ( _mm_unpacklo_epi8 ( c0, zero ), _mm_unpacklo_epi8 ( c1, zero ) ), 8 );
+	const __m128i hi = _mm_srli_epi16 ( _mm_mullo_epi16 ( _mm_unpackhi_epi8 ( c0, zero ), _mm_unpackhi_epi8 ( c1, zero ) ), 8 );
+	return _mm_packus_epi16 ( lo, hi );
+}
+
+#endif
+
+/*!
+	blends a row of 32 bit pixels onto dst with their alpha
+*/
+static inline void blendRow32 ( u32 * dst, const u32 * src, const u32 w )
+{
+	u32 dx = 0;
+#ifdef SOFTWARE_DRIVER_2_SSE2
+	const __m128i alphaMask = _mm_set1_epi32 ( 0xFF000000 );
+	const __m128i zero = _mm_setzero_si128 ();
+	for ( ; dx + 4 <= w; dx += 4 )
+	{
+		const __m128i s = _mm_loadu_si128 ( (const __m128i*) ( src + dx ) );
+		const __m128i a = _mm_and_si128 ( s, alphaMask );
+
+		// skip invisible and copy opaque spans, which are common in 2D art
+		if ( 0xFFFF == _mm_movemask_epi8 ( _mm_cmpeq_epi32 ( a, zero ) ) )
+			continue;
+		if ( 0xFFFF == _mm_movemask_epi8 ( _mm_cmpeq_epi32 ( a, alphaMask ) ) )
+		{
+			_mm_storeu_si128 ( (__m128i*) ( dst + dx ), s );
+			continue;
+		}
+
+		const __m128i d = _mm_loadu_si128 ( (const __m128i*) ( dst + dx ) );
+		_mm_storeu_si128 ( (__m128i*) ( dst + dx ), PixelBlend32_sse2 ( d, s ) );
+	}
+#endif
+	for ( ; dx != w; ++dx )
+	{
+		dst[dx] = PixelBlend32( dst[dx], src[dx] );
+	}
+}
+
 
 /*
 */
@@ -486,7 +596,7 @@ static void executeBlit_TextureCopy_x_to_x( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u32*) ( (u8*) (job->src) + job->srcPitch*src_y );
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -529,7 +639,7 @@ static void executeBlit_TextureCopy_32_to_16( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u32*) ( (u8*) (job->src) + job->srcPitch*src_y );
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -575,7 +685,7 @@ static void executeBlit_TextureCopy_24_to_16( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u8*)(job->src) + job->srcPitch*src_y;
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -590,12 +700,8 @@ static void executeBlit_TextureCopy_24_to_16( const SBlitJob * job )
 	{
 		for ( u32 dy = 0; dy != h; ++dy )
 		{
-			const u8* s = src;
-			for ( u32 dx = 0; dx != w; ++dx )
-			{
-				dst[dx] = video::RGBA16(s[0], s[1], s[2]);
-				s += 3;
-			}
+			// same as RGBA16 per pixel
+			video::CColorConverter::convert_R8G8B8toA1R5G5B5( src, w, dst );
 
 			src = src+job->srcPitch;
 			dst = (u16*) ( (u8*) (dst) + job->dstPitch );
@@ -620,7 +726,7 @@ static void executeBlit_TextureCopy_16_to_32( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u16*) ( (u8*) (job->src) + job->srcPitch*src_y );
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -635,10 +741,7 @@ static void executeBlit_TextureCopy_16_to_32( const SBlitJob * job )
 	{
 		for ( u32 dy = 0; dy != h; ++dy )
 		{
-			for ( u32 dx = 0; dx != w; ++dx )
-			{
-				dst[dx] = video::A1R5G5B5toA8R8G8B8( src[dx] );
-			}
+			video::CColorConverter::convert_A1R5G5B5toA8R8G8B8( src, w, dst );
 
 			src = (u16*) ( (u8*) (src) + job->srcPitch );
 			dst = (u32*) ( (u8*) (dst) + job->dstPitch );
@@ -660,7 +763,7 @@ static void executeBlit_TextureCopy_16_to_24( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u16*) ( (u8*) (job->src) + job->srcPitch*src_y );
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -710,7 +813,7 @@ static void executeBlit_TextureCopy_24_to_32( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (const u8*)job->src+(job->srcPitch*src_y);
 			
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -723,15 +826,9 @@ static void executeBlit_TextureCopy_24_to_32( const SBlitJob * job )
 	}
 	else
 	{
-		for ( s32 dy = 0; dy != job->height; ++dy )
+		for ( u32 dy = 0; dy != h; ++dy )
 		{
-			const u8* s = src;
-
-			for ( s32 dx = 0; dx != job->width; ++dx )
-			{
-				dst[dx] = 0xFF000000 | s[0] << 16 | s[1] << 8 | s[2];
-				s += 3;
-			}
+			video::CColorConverter::convert_R8G8B8toA8R8G8B8( src, w, dst );
 
 			src = src + job->srcPitch;
 			dst = (u32*) ( (u8*) (dst) + job->dstPitch );
@@ -753,7 +850,7 @@ static void executeBlit_TextureCopy_32_to_24( const SBlitJob * job )
 
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u32*) ( (u8*) (job->src) + job->srcPitch*src_y);
 
 			for ( u32 dx = 0; dx < w; ++dx )
@@ -771,13 +868,7 @@ static void executeBlit_TextureCopy_32_to_24( const SBlitJob * job )
 	{
 		for ( u32 dy = 0; dy != h; ++dy )
 		{
-			for ( u32 dx = 0; dx != w; ++dx )
-			{
-				u8 * writeTo = &dst[dx * 3];
-				*writeTo++ = (src[dx] >> 16)& 0xFF;
-				*writeTo++ = (src[dx] >> 8) & 0xFF;
-				*writeTo++ = src[dx] & 0xFF;
-			}
+			video::CColorConverter::convert_A8R8G8B8toR8G8B8( src, w, dst );
 
 			src = (u32*) ( (u8*) (src) + job->srcPitch );
 			dst += job->dstPitch;
@@ -803,7 +894,7 @@ static void executeBlit_TextureBlend_16_to_16( const SBlitJob * job )
 		const u32 off = core::if_c_a_else_b(w&1, (u32)((w-1)*wscale), 0);
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u32*) ( (u8*) (job->src) + job->srcPitch*src_y );
 			
 			for ( u32 dx = 0; dx < rdx; ++dx )
@@ -853,15 +944,25 @@ static void executeBlit_TextureBlend_32_to_32( const SBlitJob * job )
 	{
 		const float wscale = 1.f/job->x_stretch;
 		const float hscale = 1.f/job->y_stretch;
+		// source columns are the same for all rows
+		core::array<u32> src_x ( w );
+		src_x.set_used ( w );
+		for ( u32 dx = 0; dx < w; ++dx )
+			src_x[dx] = (u32)(dx*wscale);
+
+		// gather the stretched source in pieces, then blend those like a row
+		u32 line[64];
 		for ( u32 dy = 0; dy < h; ++dy )
 		{
-			const u32 src_y = (u32)(dy*hscale);
+			const u32 src_y = (u32)((job->firstRow + dy)*hscale);
 			src = (u32*) ( (u8*) (job->src) + job->srcPitch*src_y );
-			
-			for ( u32 dx = 0; dx < w; ++dx )
+
+			for ( u32 x0 = 0; x0 < w; x0 += 64 )
 			{
-				const u32 src_x = (u32)(dx*wscale);
-				dst[dx] = PixelBlend32( dst[dx], src[src_x] );
+				const u32 count = core::min_ ( w - x0, 64u );
+				for ( u32 dx = 0; dx != count; ++dx )
+					line[dx] = src[src_x[x0 + dx]];
+				blendRow32 ( dst + x0, line, count );
 			}
 
 			dst = (u32*) ( (u8*) (dst) + job->dstPitch );
@@ -871,10 +972,7 @@ static void executeBlit_TextureBlend_32_to_32( const SBlitJob * job )
 	{
 		for ( u32 dy = 0; dy != h; ++dy )
 		{
-			for ( u32 dx = 0; dx != w; ++dx )
-			{
-				dst[dx] = PixelBlend32( dst[dx], src[dx] );
-			}
+			blendRow32 ( dst, src, w );
 			src = (u32*) ( (u8*) (src) + job->srcPitch );
 			dst = (u32*) ( (u8*) (dst) + job->dstPitch );
 		}
@@ -911,9 +1009,22 @@ static void executeBlit_TextureBlendColor_32_to_32( const SBlitJob * job )
 	u32 *src = (u32*) job->src;
 	u32 *dst = (u32*) job->dst;
 
+#ifdef SOFTWARE_DRIVER_2_SSE2
+	const __m128i color = _mm_set1_epi32 ( job->argb );
+#endif
+
 	for ( s32 dy = 0; dy != job->height; ++dy )
 	{
-		for ( s32 dx = 0; dx != job->width; ++dx )
+		s32 dx = 0;
+#ifdef SOFTWARE_DRIVER_2_SSE2
+		for ( ; dx + 4 <= job->width; dx += 4 )
+		{
+			const __m128i s = PixelMul32_2_sse2 ( _mm_loadu_si128 ( (const __m128i*) ( src + dx ) ), color );
+			const __m128i d = _mm_loadu_si128 ( (const __m128i*) ( dst + dx ) );
+			_mm_storeu_si128 ( (__m128i*) ( dst + dx ), PixelBlend32_sse2 ( d, s ) );
+		}
+#endif
+		for ( ; dx != job->width; ++dx )
 		{
 			dst[dx] = PixelBlend32( dst[dx], PixelMul32_2( src[dx], job->argb ) );
 		}
@@ -979,9 +1090,23 @@ static void executeBlit_ColorAlpha_32_to_32( const SBlitJob * job )
 	const u32 alpha = extractAlpha( job->argb );
 	const u32 src = job->argb;
 
+#ifdef SOFTWARE_DRIVER_2_SSE2
+	const __m128i srcAlpha = _mm_set1_epi32 ( job->argb & 0xFF000000 );
+	const __m128i srcColor = _mm_set1_epi32 ( src );
+	const __m128i alpha2 = _mm_set1_epi32 ( alpha | alpha << 16 );
+#endif
+
 	for ( s32 dy = 0; dy != job->height; ++dy )
 	{
-		for ( s32 dx = 0; dx != job->width; ++dx )
+		s32 dx = 0;
+#ifdef SOFTWARE_DRIVER_2_SSE2
+		for ( ; dx + 4 <= job->width; dx += 4 )
+		{
+			const __m128i d = _mm_loadu_si128 ( (const __m128i*) ( dst + dx ) );
+			_mm_storeu_si128 ( (__m128i*) ( dst + dx ), _mm_or_si128 ( srcAlpha, PixelBlend32_sse2 ( d, srcColor, alpha2 ) ) );
+		}
+#endif
+		for ( ; dx != job->width; ++dx )
 		{
 			dst[dx] = (job->argb & 0xFF000000 ) | PixelBlend32( dst[dx], src, alpha );
 		}
@@ -1058,6 +1183,58 @@ static inline tExecuteBlit getBlitter2( eBlitter operation,const video::IImage *
 }
 
 
+/*!
+	runs a blitter on bands of rows of a job
+*/
+class CBlitBands : public CThreadPool::IJob
+{
+public:
+	CBlitBands ( tExecuteBlit blitter, const SBlitJob& job, u32 rows )
+		: Blitter ( blitter ), Job ( job ), Rows ( rows ) {}
+
+	virtual void run ( u32 index, u32 thread )
+	{
+		const u32 y0 = index * Rows;
+
+		SBlitJob band = Job;
+		band.firstRow = y0;
+		band.height = core::min_ ( Rows, (u32) Job.height - y0 );
+		band.dst = (u8*) Job.dst + y0 * Job.dstPitch;
+
+		// stretched blits find their source rows from firstRow
+		if ( Job.src && !Job.stretch )
+			band.src = (u8*) Job.src + y0 * Job.srcPitch;
+
+		Blitter ( &band );
+	}
+
+private:
+	tExecuteBlit Blitter;
+	const SBlitJob& Job;
+	u32 Rows;
+};
+
+/*!
+	executes a job, large ones split into bands of rows over the threads of a pool
+*/
+static inline void executeBlit ( tExecuteBlit blitter, const SBlitJob& job, CThreadPool* threads )
+{
+	const u32 threadCount = threads ? threads->getThreadCount() : 1;
+
+	// waking up the threads costs more than small blits
+	if ( threadCount > 1 && (u32) ( job.width * job.height ) >= 65536 && (u32) job.height >= threadCount * 2 )
+	{
+		// two bands per thread to even out blended spans of different cost
+		const u32 rows = ( job.height + threadCount * 2 - 1 ) / ( threadCount * 2 );
+		CBlitBands bands ( blitter, job, rows );
+		threads->run ( bands, ( job.height + rows - 1 ) / rows );
+	}
+	else
+	{
+		blitter ( &job );
+	}
+}
+
 // bounce clipping to texture
 inline void setClip ( AbsRectangle &out, const core::rect<s32> *clip,
 					 const video::IImage * tex, s32 passnative )
@@ -1099,7 +1276,8 @@ static s32 Blit(eBlitter operation,
 		const core::position2d<s32> *destPos,
 		video::IImage * const source,
 		const core::rect<s32> *sourceClipping,
-		u32 argb)
+		u32 argb,
+		CThreadPool* threads = 0)
 {
 	tExecuteBlit blitter = getBlitter2( operation, dest, source );
 	if ( 0 == blitter )
@@ -1151,7 +1329,7 @@ static s32 Blit(eBlitter operation,
 	job.dstPixelMul = dest->getBytesPerPixel();
 	job.dst = (void*) ( (u8*) dest->lock() + ( job.Dest.y0 * job.dstPitch ) + ( job.Dest.x0 * job.dstPixelMul ) );
 
-	blitter( &job );
+	executeBlit( blitter, job, threads );
 
 	if ( source )
 		source->unlock();
@@ -1165,7 +1343,8 @@ static s32 Blit(eBlitter operation,
 static s32 StretchBlit(eBlitter operation,
 		video::IImage* dest, const core::rect<s32> *destRect,
 		const core::rect<s32> *srcRect, video::IImage* const source,
-		u32 argb)
+		u32 argb,
+		CThreadPool* threads = 0)
 {
 	tExecuteBlit blitter = getBlitter2( operation, dest, source );
 	if ( 0 == blitter )
@@ -1205,7 +1384,7 @@ static s32 StretchBlit(eBlitter operation,
 	job.dstPixelMul = dest->getBytesPerPixel();
 	job.dst = (void*) ( (u8*) dest->lock() + ( job.Dest.y0 * job.dstPitch ) + ( job.Dest.x0 * job.dstPixelMul ) );
 
-	blitter( &job );
+	executeBlit( blitter, job, threads );
 
 	if ( source )
 		source->unlock();
@@ -1219,10 +1398,11 @@ static s32 StretchBlit(eBlitter operation,
 
 // Methods for Software drivers
 //! draws a rectangle
-static void drawRectangle(video::IImage* img, const core::rect<s32>& rect, const video::SColor &color)
+static void drawRectangle(video::IImage* img, const core::rect<s32>& rect, const video::SColor &color,
+			CThreadPool* threads = 0)
 {
 	Blit(color.getAlpha() == 0xFF ? BLITTER_COLOR : BLITTER_COLOR_ALPHA,
-			img, 0, &rect.UpperLeftCorner, 0, &rect, color.color);
+			img, 0, &rect.UpperLeftCorner, 0, &rect, color.color, threads);
 }
 
 
@@ -977,8 +977,11 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 				line.t[i][scan.right] = scan.t[i][1];
 			}
 
-			// render a scanline
-			scanline ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -1092,8 +1095,11 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 				line.t[i][scan.right] = scan.t[i][1];
 			}
 
-			// render a scanline
-			scanline ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
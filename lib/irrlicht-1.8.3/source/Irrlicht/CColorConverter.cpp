@@ -7,11 +7,455 @@
 #include "os.h"
 #include "irrString.h"
 
+// sse2 is part of every x86-64 cpu. the ssse3 and avx2 kernels are compiled
+// for all of them and chosen at runtime by the cpu
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define _IRR_CONVERTER_SSE2_
+	#include <emmintrin.h>
+	#if defined ( _MSC_VER ) && _MSC_VER >= 1800
+		#define _IRR_CONVERTER_DISPATCH_
+		#define _IRR_CONVERTER_TARGET_(isa)
+		#include <immintrin.h>
+		#include <intrin.h>
+	#elif defined ( __clang__ ) || ( defined ( __GNUC__ ) && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) ) )
+		#define _IRR_CONVERTER_DISPATCH_
+		#define _IRR_CONVERTER_TARGET_(isa) __attribute__ ((target (isa)))
+		#include <immintrin.h>
+	#endif
+#endif
+
 namespace irr
 {
 namespace video
 {
 
+namespace
+{
+#ifdef _IRR_CONVERTER_DISPATCH_
+	//! instruction sets beyond sse2 which the cpu and the os support
+	struct SCpuFeatures
+	{
+		SCpuFeatures() : SSSE3(false), AVX2(false)
+		{
+#if defined ( _MSC_VER )
+			int info[4];
+			__cpuid(info, 0);
+			const int maxLeaf = info[0];
+			__cpuid(info, 1);
+			SSSE3 = (info[2] & (1 << 9)) != 0;
+			// the os has to save the ymm registers
+			if (maxLeaf >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6)
+			{
+				__cpuidex(info, 7, 0);
+				AVX2 = (info[1] & (1 << 5)) != 0;
+			}
+#else
+			__builtin_cpu_init();
+			SSSE3 = __builtin_cpu_supports("ssse3") != 0;
+			AVX2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+		}
+
+		bool SSSE3;
+		bool AVX2;
+	};
+
+	const SCpuFeatures& getCpuFeatures()
+	{
+		static const SCpuFeatures features;
+		return features;
+	}
+#endif
+
+#ifdef _IRR_CONVERTER_SSE2_
+	//! the per pixel conversions of the kernels, on 32 bit lanes
+	struct SA8R8G8B8toR5G6B5
+	{
+		static inline __m128i run(__m128i c)
+		{
+			return _mm_or_si128(_mm_or_si128(
+				_mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xF800)),
+				_mm_and_si128(_mm_srli_epi32(c, 5), _mm_set1_epi32(0x07E0))),
+				_mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001F)));
+		}
+#ifdef _IRR_CONVERTER_DISPATCH_
+		static inline _IRR_CONVERTER_TARGET_("avx2") __m256i run(__m256i c)
+		{
+			return _mm256_or_si256(_mm256_or_si256(
+				_mm256_and_si256(_mm256_srli_epi32(c, 8), _mm256_set1_epi32(0xF800)),
+				_mm256_and_si256(_mm256_srli_epi32(c, 5), _mm256_set1_epi32(0x07E0))),
+				_mm256_and_si256(_mm256_srli_epi32(c, 3), _mm256_set1_epi32(0x001F)));
+		}
+#endif
+	};
+
+	struct SA8R8G8B8toA1R5G5B5
+	{
+		static inline __m128i run(__m128i c)
+		{
+			return _mm_or_si128(_mm_or_si128(
+				_mm_and_si128(_mm_srli_epi32(c, 16), _mm_set1_epi32(0x8000)),
+				_mm_and_si128(_mm_srli_epi32(c, 9), _mm_set1_epi32(0x7C00))),
+				_mm_or_si128(
+				_mm_and_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0x03E0)),
+				_mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001F))));
+		}
+#ifdef _IRR_CONVERTER_DISPATCH_
+		static inline _IRR_CONVERTER_TARGET_("avx2") __m256i run(__m256i c)
+		{
+			return _mm256_or_si256(_mm256_or_si256(
+				_mm256_and_si256(_mm256_srli_epi32(c, 16), _mm256_set1_epi32(0x8000)),
+				_mm256_and_si256(_mm256_srli_epi32(c, 9), _mm256_set1_epi32(0x7C00))),
+				_mm256_or_si256(
+				_mm256_and_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0x03E0)),
+				_mm256_and_si256(_mm256_srli_epi32(c, 3), _mm256_set1_epi32(0x001F))));
+		}
+#endif
+	};
+
+	struct SR5G6B5toA8R8G8B8
+	{
+		static inline __m128i run(__m128i c)
+		{
+			return _mm_or_si128(_mm_or_si128(_mm_set1_epi32((int)0xFF000000),
+				_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF800)), 8)),
+				_mm_or_si128(
+				_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x07E0)), 5),
+				_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x001F)), 3)));
+		}
+#ifdef _IRR_CONVERTER_DISPATCH_
+		static inline _IRR_CONVERTER_TARGET_("avx2") __m256i run(__m256i c)
+		{
+			return _mm256_or_si256(_mm256_or_si256(_mm256_set1_epi32((int)0xFF000000),
+				_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0xF800)), 8)),
+				_mm256_or_si256(
+				_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x07E0)), 5),
+				_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x001F)), 3)));
+		}
+#endif
+	};
+
+	//! extends the lower bits with the high bits, like video::A1R5G5B5toA8R8G8B8()
+	struct SA1R5G5B5toA8R8G8B8
+	{
+		static inline __m128i run(__m128i c)
+		{
+			const __m128i a = _mm_and_si128(_mm_srai_epi32(_mm_slli_epi32(c, 16), 31), _mm_set1_epi32((int)0xFF000000));
+			const __m128i r = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x7C00)), 9),
+				_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x7000)), 4));
+			const __m128i g = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x03E0)), 6),
+				_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x0380)), 1));
+			const __m128i b = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x001F)), 3),
+				_mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x001C)), 2));
+			return _mm_or_si128(_mm_or_si128(a, r), _mm_or_si128(g, b));
+		}
+#ifdef _IRR_CONVERTER_DISPATCH_
+		static inline _IRR_CONVERTER_TARGET_("avx2") __m256i run(__m256i c)
+		{
+			const __m256i a = _mm256_and_si256(_mm256_srai_epi32(_mm256_slli_epi32(c, 16), 31), _mm256_set1_epi32((int)0xFF000000));
+			const __m256i r = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x7C00)), 9),
+				_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x7000)), 4));
+			const __m256i g = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x03E0)), 6),
+				_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x0380)), 1));
+			const __m256i b = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x001F)), 3),
+				_mm256_srli_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x001C)), 2));
+			return _mm256_or_si256(_mm256_or_si256(a, r), _mm256_or_si256(g, b));
+		}
+#endif
+	};
+
+	//! reverses the bytes, B8G8R8A8 to A8R8G8B8
+	struct SB8G8R8A8toA8R8G8B8
+	{
+		static inline __m128i run(__m128i c)
+		{
+			return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(c, 24), _mm_srli_epi32(c, 24)),
+				_mm_or_si128(_mm_and_si128(_mm_slli_epi32(c, 8), _mm_set1_epi32(0x00FF0000)),
+				_mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0x0000FF00))));
+		}
+#ifdef _IRR_CONVERTER_DISPATCH_
+		static inline _IRR_CONVERTER_TARGET_("avx2") __m256i run(__m256i c)
+		{
+			return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(c, 24), _mm256_srli_epi32(c, 24)),
+				_mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(c, 8), _mm256_set1_epi32(0x00FF0000)),
+				_mm256_and_si256(_mm256_srli_epi32(c, 8), _mm256_set1_epi32(0x0000FF00))));
+		}
+#endif
+	};
+
+	//! packs the low 16 bits of the 32 bit lanes
+	inline __m128i packLow16(__m128i a, __m128i b)
+	{
+		// sign extended, the saturation of packs keeps all bits
+		return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+			_mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+	}
+
+	//! the kernels return the number of pixels they converted, the rest
+	//! is left to the scalar loops
+	template <class F>
+	s32 convert32to16SSE2(const u32* sB, s32 sN, u16* dB)
+	{
+		s32 x = 0;
+		for (; x + 8 <= sN; x += 8)
+		{
+			const __m128i lo = F::run(_mm_loadu_si128((const __m128i*)(sB + x)));
+			const __m128i hi = F::run(_mm_loadu_si128((const __m128i*)(sB + x + 4)));
+			_mm_storeu_si128((__m128i*)(dB + x), packLow16(lo, hi));
+		}
+		return x;
+	}
+
+	template <class F>
+	s32 convert16to32SSE2(const u16* sB, s32 sN, u32* dB)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		s32 x = 0;
+		for (; x + 8 <= sN; x += 8)
+		{
+			const __m128i c = _mm_loadu_si128((const __m128i*)(sB + x));
+			_mm_storeu_si128((__m128i*)(dB + x), F::run(_mm_unpacklo_epi16(c, zero)));
+			_mm_storeu_si128((__m128i*)(dB + x + 4), F::run(_mm_unpackhi_epi16(c, zero)));
+		}
+		return x;
+	}
+
+	template <class F>
+	s32 convert32to32SSE2(const u32* sB, s32 sN, u32* dB)
+	{
+		s32 x = 0;
+		for (; x + 4 <= sN; x += 4)
+			_mm_storeu_si128((__m128i*)(dB + x), F::run(_mm_loadu_si128((const __m128i*)(sB + x))));
+		return x;
+	}
+
+	//! swaps the first and the third byte of 3 byte pixels
+	s32 swap24SSE2(const u8* sB, s32 sN, u8* dB)
+	{
+		// bytes at offsets 0, 1 and 2 of the pixels of the first vector,
+		// the next vectors start at offset 1 and 2
+		const __m128i e0 = _mm_setr_epi8(-1,0,0, -1,0,0, -1,0,0, -1,0,0, -1,0,0, -1);
+		const __m128i e1 = _mm_slli_si128(e0, 1);
+		const __m128i e2 = _mm_slli_si128(e0, 2);
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16, sB += 48, dB += 48)
+		{
+			const __m128i a = _mm_loadu_si128((const __m128i*)sB);
+			const __m128i b = _mm_loadu_si128((const __m128i*)(sB + 16));
+			const __m128i c = _mm_loadu_si128((const __m128i*)(sB + 32));
+
+			// the bytes two ahead and two behind
+			const __m128i aNext = _mm_or_si128(_mm_srli_si128(a, 2), _mm_slli_si128(b, 14));
+			const __m128i bNext = _mm_or_si128(_mm_srli_si128(b, 2), _mm_slli_si128(c, 14));
+			const __m128i cNext = _mm_srli_si128(c, 2);
+			const __m128i aPrev = _mm_slli_si128(a, 2);
+			const __m128i bPrev = _mm_or_si128(_mm_slli_si128(b, 2), _mm_srli_si128(a, 14));
+			const __m128i cPrev = _mm_or_si128(_mm_slli_si128(c, 2), _mm_srli_si128(b, 14));
+
+			_mm_storeu_si128((__m128i*)dB, _mm_or_si128(_mm_and_si128(a, e1),
+				_mm_or_si128(_mm_and_si128(aNext, e0), _mm_and_si128(aPrev, e2))));
+			_mm_storeu_si128((__m128i*)(dB + 16), _mm_or_si128(_mm_and_si128(b, e0),
+				_mm_or_si128(_mm_and_si128(bNext, e2), _mm_and_si128(bPrev, e1))));
+			_mm_storeu_si128((__m128i*)(dB + 32), _mm_or_si128(_mm_and_si128(c, e2),
+				_mm_or_si128(_mm_and_si128(cNext, e1), _mm_and_si128(cPrev, e0))));
+		}
+		return x;
+	}
+#else
+	struct SA8R8G8B8toR5G6B5 {};
+	struct SA8R8G8B8toA1R5G5B5 {};
+	struct SR5G6B5toA8R8G8B8 {};
+	struct SA1R5G5B5toA8R8G8B8 {};
+	struct SB8G8R8A8toA8R8G8B8 {};
+#endif
+
+#ifdef _IRR_CONVERTER_DISPATCH_
+	template <class F>
+	_IRR_CONVERTER_TARGET_("avx2") s32 convert32to16AVX2(const u32* sB, s32 sN, u16* dB)
+	{
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16)
+		{
+			const __m256i lo = F::run(_mm256_loadu_si256((const __m256i*)(sB + x)));
+			const __m256i hi = F::run(_mm256_loadu_si256((const __m256i*)(sB + x + 8)));
+			// packs works on the 128 bit halves, put the quarters back in order
+			const __m256i packed = _mm256_packs_epi32(
+				_mm256_srai_epi32(_mm256_slli_epi32(lo, 16), 16),
+				_mm256_srai_epi32(_mm256_slli_epi32(hi, 16), 16));
+			_mm256_storeu_si256((__m256i*)(dB + x), _mm256_permute4x64_epi64(packed, 0xD8));
+		}
+		return x;
+	}
+
+	template <class F>
+	_IRR_CONVERTER_TARGET_("avx2") s32 convert16to32AVX2(const u16* sB, s32 sN, u32* dB)
+	{
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16)
+		{
+			_mm256_storeu_si256((__m256i*)(dB + x),
+				F::run(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(sB + x)))));
+			_mm256_storeu_si256((__m256i*)(dB + x + 8),
+				F::run(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(sB + x + 8)))));
+		}
+		return x;
+	}
+
+	template <class F>
+	_IRR_CONVERTER_TARGET_("avx2") s32 convert32to32AVX2(const u32* sB, s32 sN, u32* dB)
+	{
+		s32 x = 0;
+		for (; x + 8 <= sN; x += 8)
+			_mm256_storeu_si256((__m256i*)(dB + x), F::run(_mm256_loadu_si256((const __m256i*)(sB + x))));
+		return x;
+	}
+
+	//! 3 byte pixels to A8R8G8B8, bgr keeps the byte order of B8G8R8
+	_IRR_CONVERTER_TARGET_("ssse3") s32 convert24to32SSSE3(const u8* sB, s32 sN, u32* dB, bool bgr)
+	{
+		const __m128i shuffle = bgr ?
+			_mm_setr_epi8(0,1,2,-128, 3,4,5,-128, 6,7,8,-128, 9,10,11,-128) :
+			_mm_setr_epi8(2,1,0,-128, 5,4,3,-128, 8,7,6,-128, 11,10,9,-128);
+		const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16, sB += 48)
+		{
+			const __m128i a = _mm_loadu_si128((const __m128i*)sB);
+			const __m128i b = _mm_loadu_si128((const __m128i*)(sB + 16));
+			const __m128i c = _mm_loadu_si128((const __m128i*)(sB + 32));
+			_mm_storeu_si128((__m128i*)(dB + x), _mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha));
+			_mm_storeu_si128((__m128i*)(dB + x + 4), _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha));
+			_mm_storeu_si128((__m128i*)(dB + x + 8), _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha));
+			_mm_storeu_si128((__m128i*)(dB + x + 12), _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha));
+		}
+		return x;
+	}
+
+	//! A8R8G8B8 to 3 byte pixels, bgr keeps the byte order, to B8G8R8
+	_IRR_CONVERTER_TARGET_("ssse3") s32 convert32to24SSSE3(const u32* sB, s32 sN, u8* dB, bool bgr)
+	{
+		const __m128i shuffle = bgr ?
+			_mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -128,-128,-128,-128) :
+			_mm_setr_epi8(2,1,0, 6,5,4, 10,9,8, 14,13,12, -128,-128,-128,-128);
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16, dB += 48)
+		{
+			const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(sB + x)), shuffle);
+			const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(sB + x + 4)), shuffle);
+			const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(sB + x + 8)), shuffle);
+			const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(sB + x + 12)), shuffle);
+			_mm_storeu_si128((__m128i*)dB, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+			_mm_storeu_si128((__m128i*)(dB + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+			_mm_storeu_si128((__m128i*)(dB + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+		}
+		return x;
+	}
+
+	//! R8G8B8 to 16 bit colors through A8R8G8B8
+	template <class F>
+	_IRR_CONVERTER_TARGET_("ssse3") s32 convert24to16SSSE3(const u8* sB, s32 sN, u16* dB)
+	{
+		const __m128i shuffle = _mm_setr_epi8(2,1,0,-128, 5,4,3,-128, 8,7,6,-128, 11,10,9,-128);
+		const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+		s32 x = 0;
+		for (; x + 16 <= sN; x += 16, sB += 48)
+		{
+			const __m128i a = _mm_loadu_si128((const __m128i*)sB);
+			const __m128i b = _mm_loadu_si128((const __m128i*)(sB + 16));
+			const __m128i c = _mm_loadu_si128((const __m128i*)(sB + 32));
+			const __m128i p0 = F::run(_mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha));
+			const __m128i p1 = F::run(_mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha));
+			const __m128i p2 = F::run(_mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha));
+			const __m128i p3 = F::run(_mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha));
+			_mm_storeu_si128((__m128i*)(dB + x), packLow16(p0, p1));
+			_mm_storeu_si128((__m128i*)(dB + x + 8), packLow16(p2, p3));
+		}
+		return x;
+	}
+#endif
+
+	//! picks the widest kernel the cpu runs, returns the number of pixels converted
+	template <class F>
+	s32 convert32to16(const void* sP, s32 sN, void* dP)
+	{
+		s32 x = 0;
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().AVX2)
+			x = convert32to16AVX2<F>((const u32*)sP, sN, (u16*)dP);
+#endif
+#ifdef _IRR_CONVERTER_SSE2_
+		x += convert32to16SSE2<F>((const u32*)sP + x, sN - x, (u16*)dP + x);
+#endif
+		return x;
+	}
+
+	template <class F>
+	s32 convert16to32(const void* sP, s32 sN, void* dP)
+	{
+		s32 x = 0;
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().AVX2)
+			x = convert16to32AVX2<F>((const u16*)sP, sN, (u32*)dP);
+#endif
+#ifdef _IRR_CONVERTER_SSE2_
+		x += convert16to32SSE2<F>((const u16*)sP + x, sN - x, (u32*)dP + x);
+#endif
+		return x;
+	}
+
+	template <class F>
+	s32 convert32to32(const void* sP, s32 sN, void* dP)
+	{
+		s32 x = 0;
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().AVX2)
+			x = convert32to32AVX2<F>((const u32*)sP, sN, (u32*)dP);
+#endif
+#ifdef _IRR_CONVERTER_SSE2_
+		x += convert32to32SSE2<F>((const u32*)sP + x, sN - x, (u32*)dP + x);
+#endif
+		return x;
+	}
+
+	s32 convert24to32(const void* sP, s32 sN, void* dP, bool bgr)
+	{
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().SSSE3)
+			return convert24to32SSSE3((const u8*)sP, sN, (u32*)dP, bgr);
+#endif
+		return 0;
+	}
+
+	s32 convert32to24(const void* sP, s32 sN, void* dP, bool bgr)
+	{
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().SSSE3)
+			return convert32to24SSSE3((const u32*)sP, sN, (u8*)dP, bgr);
+#endif
+		return 0;
+	}
+
+	template <class F>
+	s32 convert24to16(const void* sP, s32 sN, void* dP)
+	{
+#ifdef _IRR_CONVERTER_DISPATCH_
+		if (getCpuFeatures().SSSE3)
+			return convert24to16SSSE3<F>((const u8*)sP, sN, (u16*)dP);
+#endif
+		return 0;
+	}
+
+	s32 swap24(const void* sP, s32 sN, void* dP)
+	{
+#ifdef _IRR_CONVERTER_SSE2_
+		return swap24SSE2((const u8*)sP, sN, (u8*)dP);
+#else
+		return 0;
+#endif
+	}
+}
+
+
 //! converts a monochrome bitmap to A1R5G5B5 data
 void CColorConverter::convert1BitTo16Bit(const u8* in, s16* out, s32 width, s32 height, s32 linepad, bool flip)
 {
@@ -245,7 +689,7 @@ void CColorConverter::convert24BitTo24Bit(const u8* in, u8* out, s32 width, s32
 			out -= lineWidth;
 		if (bgr)
 		{
-			for (s32 x=0; x<lineWidth; x+=3)
+			for (s32 x=swap24(in, width, out)*3; x<lineWidth; x+=3)
 			{
 				out[x+0] = in[x+2];
 				out[x+1] = in[x+1];
@@ -360,10 +804,11 @@ void CColorConverter::convert_A1R5G5B5toB8G8R8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_A1R5G5B5toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convert16to32<SA1R5G5B5toA8R8G8B8>(sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = A1R5G5B5toA8R8G8B8(*sB++);
 }
 
@@ -383,10 +828,11 @@ void CColorConverter::convert_A1R5G5B5toR5G6B5(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_A8R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convert32to24(sP, sN, dP, false);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 3;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		// sB[3] is alpha
 		dB[0] = sB[2];
@@ -400,10 +846,11 @@ void CColorConverter::convert_A8R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_A8R8G8B8toB8G8R8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convert32to24(sP, sN, dP, true);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 3;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		// sB[3] is alpha
 		dB[0] = sB[0];
@@ -422,19 +869,21 @@ void CColorConverter::convert_A8R8G8B8toA8R8G8B8(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_A8R8G8B8toA1R5G5B5(const void* sP, s32 sN, void* dP)
 {
-	u32* sB = (u32*)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convert32to16<SA8R8G8B8toA1R5G5B5>(sP, sN, dP);
+	u32* sB = (u32*)sP + done;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = A8R8G8B8toA1R5G5B5(*sB++);
 }
 
 void CColorConverter::convert_A8R8G8B8toR5G6B5(const void* sP, s32 sN, void* dP)
 {
-	u8 * sB = (u8 *)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convert32to16<SA8R8G8B8toR5G6B5>(sP, sN, dP);
+	u8 * sB = (u8 *)sP + done * 4;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		s32 r = sB[2] >> 3;
 		s32 g = sB[1] >> 2;
@@ -472,10 +921,11 @@ void CColorConverter::convert_R8G8B8toR8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_R8G8B8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8*  sB = (u8* )sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convert24to32(sP, sN, dP, false);
+	u8*  sB = (u8* )sP + done * 3;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB = 0xff000000 | (sB[0]<<16) | (sB[1]<<8) | sB[2];
 
@@ -486,10 +936,11 @@ void CColorConverter::convert_R8G8B8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_R8G8B8toA1R5G5B5(const void* sP, s32 sN, void* dP)
 {
-	u8 * sB = (u8 *)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convert24to16<SA8R8G8B8toA1R5G5B5>(sP, sN, dP);
+	u8 * sB = (u8 *)sP + done * 3;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		s32 r = sB[0] >> 3;
 		s32 g = sB[1] >> 3;
@@ -504,10 +955,11 @@ void CColorConverter::convert_R8G8B8toA1R5G5B5(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_B8G8R8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8*  sB = (u8* )sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convert24to32(sP, sN, dP, true);
+	u8*  sB = (u8* )sP + done * 3;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		*dB = 0xff000000 | (sB[2]<<16) | (sB[1]<<8) | sB[0];
 
@@ -518,10 +970,11 @@ void CColorConverter::convert_B8G8R8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_B8G8R8A8toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u8* sB = (u8*)sP;
-	u8* dB = (u8*)dP;
+	const s32 done = convert32to32<SB8G8R8A8toA8R8G8B8>(sP, sN, dP);
+	u8* sB = (u8*)sP + done * 4;
+	u8* dB = (u8*)dP + done * 4;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		dB[0] = sB[3];
 		dB[1] = sB[2];
@@ -536,10 +989,11 @@ void CColorConverter::convert_B8G8R8A8toA8R8G8B8(const void* sP, s32 sN, void* d
 
 void CColorConverter::convert_R8G8B8toR5G6B5(const void* sP, s32 sN, void* dP)
 {
-	u8 * sB = (u8 *)sP;
-	u16* dB = (u16*)dP;
+	const s32 done = convert24to16<SA8R8G8B8toR5G6B5>(sP, sN, dP);
+	u8 * sB = (u8 *)sP + done * 3;
+	u16* dB = (u16*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 	{
 		s32 r = sB[0] >> 3;
 		s32 g = sB[1] >> 2;
@@ -591,10 +1045,11 @@ void CColorConverter::convert_R5G6B5toB8G8R8(const void* sP, s32 sN, void* dP)
 
 void CColorConverter::convert_R5G6B5toA8R8G8B8(const void* sP, s32 sN, void* dP)
 {
-	u16* sB = (u16*)sP;
-	u32* dB = (u32*)dP;
+	const s32 done = convert16to32<SR5G6B5toA8R8G8B8>(sP, sN, dP);
+	u16* sB = (u16*)sP + done;
+	u32* dB = (u32*)dP + done;
 
-	for (s32 x = 0; x < sN; ++x)
+	for (s32 x = done; x < sN; ++x)
 		*dB++ = R5G6B5toA8R8G8B8(*sB++);
 }
 
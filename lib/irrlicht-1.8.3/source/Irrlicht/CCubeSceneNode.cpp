@@ -40,6 +40,7 @@ CCubeSceneNode::CCubeSceneNode(f32 size, ISceneNode* parent, ISceneManager* mgr,
 	#endif
 
 	setSize();
+	Material = Mesh->getMeshBuffer(0)->getMaterial();
 }
 
 
@@ -56,7 +57,8 @@ void CCubeSceneNode::setSize()
 {
 	if (Mesh)
 		Mesh->drop();
-	Mesh = SceneManager->getGeometryCreator()->createCubeMesh(core::vector3df(Size));
+	// the mesh is shared by all cubes of this size, the material stays with the node
+	Mesh = SceneManager->getGeometryCreator()->getSharedCubeMesh(core::vector3df(Size));
 }
 
 
@@ -70,7 +72,7 @@ void CCubeSceneNode::render()
 		Shadow->updateShadowVolumes();
 
 	// for debug purposes only:
-	video::SMaterial mat = Mesh->getMeshBuffer(0)->getMaterial();
+	video::SMaterial mat = Material;
 
 	// overwrite half transparency
 	if (DebugDataVisible & scene::EDS_HALF_TRANSPARENCY)
@@ -98,8 +100,8 @@ void CCubeSceneNode::render()
 		if (DebugDataVisible & scene::EDS_NORMALS)
 		{
 			// draw normals
-			const f32 debugNormalLength = SceneManager->getParameters()->getAttributeAsFloat(DEBUG_NORMAL_LENGTH);
-			const video::SColor debugNormalColor = SceneManager->getParameters()->getAttributeAsColor(DEBUG_NORMAL_COLOR);
+			const f32 debugNormalLength = SceneManager->getSceneParameters().DebugNormalLength;
+			const video::SColor debugNormalColor = SceneManager->getSceneParameters().DebugNormalColor;
 			const u32 count = Mesh->getMeshBufferCount();
 
 			for (u32 i=0; i != count; ++i)
@@ -172,7 +174,7 @@ void CCubeSceneNode::OnRegisterSceneNode()
 //! returns the material based on the zero based index i.
 video::SMaterial& CCubeSceneNode::getMaterial(u32 i)
 {
-	return Mesh->getMeshBuffer(0)->getMaterial();
+	return Material;
 }
 
 
@@ -63,6 +63,7 @@ namespace scene
 		virtual void setMesh(IMesh* mesh) {}
 
 		//! Returns the current mesh
+		/** It is shared with all cubes of the same size and must not be modified. */
 		virtual IMesh* getMesh(void) { return Mesh; }
 
 		//! Sets if the scene node should not copy the materials of the mesh but use them in a read only style.
@@ -83,6 +84,7 @@ namespace scene
 
 		IMesh* Mesh;
 		IShadowVolumeSceneNode* Shadow;
+		video::SMaterial Material;
 		f32 Size;
 	};
 
@@ -1358,6 +1358,8 @@ bool CD3D8Driver::setRenderStates3DMode()
 
 	if (ResetRenderStates || LastMaterial != Material)
 	{
+		++MaterialChanges;
+
 		// unset old material
 
 		if (CurrentRenderMode == ERM_3D &&
@@ -16,7 +16,7 @@ namespace video
 
 //! constructor
 CDepthBuffer::CDepthBuffer(const core::dimension2d<u32>& size)
-: Buffer(0), Size(0,0)
+: Buffer(0), Size(0,0), TileColumns(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CDepthBuffer");
@@ -36,20 +36,25 @@ CDepthBuffer::~CDepthBuffer()
 
 
 
-//! clears the zbuffer
-void CDepthBuffer::clear()
+//! returns the bits of the depth of a cleared buffer
+static inline u32 getClearValue()
 {
-
 #ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
 	f32 zMax = 0.f;
 #else
 	f32 zMax = 1.f;
 #endif
 
-	u32 zMaxValue;
-	zMaxValue = IR(zMax);
+	return IR(zMax);
+}
+
+
+//! clears the zbuffer
+void CDepthBuffer::clear()
+{
+	memset32 ( Buffer, getClearValue(), TotalSize );
 
-	memset32 ( Buffer, zMaxValue, TotalSize );
+	clearFarthest ();
 }
 
 
@@ -68,6 +73,13 @@ void CDepthBuffer::setSize(const core::dimension2d<u32>& size)
 	Pitch = size.Width * sizeof ( fp24 );
 	TotalSize = Pitch * size.Height;
 	Buffer = new u8[TotalSize];
+
+#ifdef SOFTWARE_DRIVER_2_HIERARCHICAL_Z
+	const u32 tileSize = 1 << TILE_SIZE_LOG2;
+	TileColumns = ( size.Width + tileSize - 1 ) >> TILE_SIZE_LOG2;
+	TileDepth.set_used ( TileColumns * ( ( size.Height + tileSize - 1 ) >> TILE_SIZE_LOG2 ) );
+#endif
+
 	clear ();
 }
 
@@ -79,6 +91,103 @@ const core::dimension2d<u32>& CDepthBuffer::getSize() const
 	return Size;
 }
 
+
+//! returns true if no pixel of an area passes the depth test of a triangle
+bool CDepthBuffer::isHidden(s32 x0, s32 y0, s32 x1, s32 y1, f32 nearest)
+{
+#ifdef SOFTWARE_DRIVER_2_HIERARCHICAL_Z
+	// leave room for the rounding errors of the interpolation over the triangle
+	nearest += nearest * ( 1.f / 256.f );
+
+	const s32 tileX0 = x0 >> TILE_SIZE_LOG2;
+	const s32 tileX1 = x1 >> TILE_SIZE_LOG2;
+	const s32 tileY1 = y1 >> TILE_SIZE_LOG2;
+
+	for ( s32 tileY = y0 >> TILE_SIZE_LOG2; tileY <= tileY1; ++tileY )
+	{
+		f32* depth = TileDepth.pointer() + tileY * TileColumns;
+		for ( s32 tileX = tileX0; tileX <= tileX1; ++tileX )
+		{
+			if ( depth[tileX] < 0.f )
+				depth[tileX] = getFarthest ( tileX, tileY );
+
+			if ( !( nearest < depth[tileX] ) )
+				return false;
+		}
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+//! marks the tiles of an area for update after a renderer wrote to them
+void CDepthBuffer::markTiles(s32 x0, s32 y0, s32 x1, s32 y1)
+{
+#ifdef SOFTWARE_DRIVER_2_HIERARCHICAL_Z
+	const s32 tileX0 = x0 >> TILE_SIZE_LOG2;
+	const s32 tileX1 = x1 >> TILE_SIZE_LOG2;
+	const s32 tileY1 = y1 >> TILE_SIZE_LOG2;
+
+	for ( s32 tileY = y0 >> TILE_SIZE_LOG2; tileY <= tileY1; ++tileY )
+	{
+		f32* depth = TileDepth.pointer() + tileY * TileColumns;
+		for ( s32 tileX = tileX0; tileX <= tileX1; ++tileX )
+			depth[tileX] = -1.f;
+	}
+#endif
+}
+
+
+//! sets the coarse depth buffer to the one of a cleared buffer
+void CDepthBuffer::clearFarthest()
+{
+	if ( TileDepth.size() )
+		memset32 ( TileDepth.pointer(), getClearValue(), TileDepth.size() * sizeof ( f32 ) );
+}
+
+
+//! clears one tile of the buffer
+void CDepthBuffer::clearTile(u32 tileX, u32 tileY)
+{
+	const u32 x0 = tileX << TILE_SIZE_LOG2;
+	const u32 y0 = tileY << TILE_SIZE_LOG2;
+	const u32 x1 = core::min_ ( x0 + ( 1 << TILE_SIZE_LOG2 ), Size.Width );
+	const u32 y1 = core::min_ ( y0 + ( 1 << TILE_SIZE_LOG2 ), Size.Height );
+
+	const u32 value = getClearValue();
+	u8* row = Buffer + y0 * Pitch + x0 * sizeof ( fp24 );
+	for ( u32 y = y0; y != y1; ++y )
+	{
+		memset32 ( row, value, ( x1 - x0 ) * sizeof ( fp24 ) );
+		row += Pitch;
+	}
+}
+
+
+//! returns the farthest depth of a tile
+f32 CDepthBuffer::getFarthest(u32 tileX, u32 tileY) const
+{
+	const u32 x0 = tileX << TILE_SIZE_LOG2;
+	const u32 y0 = tileY << TILE_SIZE_LOG2;
+	const u32 x1 = core::min_ ( x0 + ( 1 << TILE_SIZE_LOG2 ), Size.Width );
+	const u32 y1 = core::min_ ( y0 + ( 1 << TILE_SIZE_LOG2 ), Size.Height );
+
+	const fp24* row = (const fp24*) ( Buffer + y0 * Pitch );
+	f32 farthest = row[x0];
+	for ( u32 y = y0; y != y1; ++y )
+	{
+		for ( u32 x = x0; x != x1; ++x )
+		{
+			if ( row[x] < farthest )
+				farthest = row[x];
+		}
+		row = (const fp24*) ( (const u8*) row + Pitch );
+	}
+	return farthest;
+}
+
 // -----------------------------------------------------------------
 
 //! constructor
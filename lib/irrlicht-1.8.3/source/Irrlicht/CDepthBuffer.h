@@ -5,7 +5,9 @@
 #ifndef __C_Z_BUFFER_H_INCLUDED__
 #define __C_Z_BUFFER_H_INCLUDED__
 
+#include "SoftwareDriver2_compile_config.h"
 #include "IDepthBuffer.h"
+#include "irrArray.h"
 
 namespace irr
 {
@@ -40,13 +42,46 @@ namespace video
 		//! returns pitch of depthbuffer (in bytes)
 		virtual u32 getPitch() const { return Pitch; }
 
+		//! edge length of the tiles of the coarse depth buffer, as power of two
+		enum { TILE_SIZE_LOG2 = 3 };
+
+		//! returns true if no pixel of an area passes the depth test of a triangle
+		/** The renderers draw a pixel if its depth is greater or equal
+		to the one in the buffer, and the depths they interpolate over a
+		triangle are at most the largest depth of its vertices, apart from
+		rounding. So a triangle is hidden in a tile whose farthest depth
+		is greater. Always false without SOFTWARE_DRIVER_2_HIERARCHICAL_Z.
+		\param x0,y0,x1,y1 Inclusive area in the buffer.
+		\param nearest Largest depth of the triangle. */
+		bool isHidden(s32 x0, s32 y0, s32 x1, s32 y1, f32 nearest);
+
+		//! marks the tiles of an area for update after a renderer wrote to them
+		/** Renderers which only write depths which passed the depth test
+		do not have to call this, their depths only get nearer. */
+		void markTiles(s32 x0, s32 y0, s32 x1, s32 y1);
+
+		//! sets the coarse depth buffer to the one of a cleared buffer
+		/** For a clear which leaves the buffer itself to clearTile(),
+		called for each tile before a renderer uses it. */
+		void clearFarthest();
+
+		//! clears one tile of the buffer
+		void clearTile(u32 tileX, u32 tileY);
 
 	private:
 
+		//! returns the farthest depth of a tile
+		f32 getFarthest(u32 tileX, u32 tileY) const;
+
 		u8* Buffer;
 		core::dimension2d<u32> Size;
 		u32 TotalSize;
 		u32 Pitch;
+
+		//! farthest depth of each tile, or less than the farthest depth,
+		//! negative if it has to be recalculated
+		core::array<f32> TileDepth;
+		u32 TileColumns;
 	};
 
 
@@ -0,0 +1,305 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CFrameCapture.h"
+#include "IrrCompileConfig.h"
+#include "CImage.h"
+#include "IVideoDriver.h"
+#include "IFileSystem.h"
+#include "IWriteFile.h"
+#include "coreutil.h"
+#include "os.h"
+#include <stdio.h>
+
+#ifdef _IRR_WINDOWS_API_
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+namespace irr
+{
+namespace video
+{
+
+#ifdef _IRR_WINDOWS_API_
+
+struct CFrameCapture::SThreads
+{
+	CRITICAL_SECTION Mutex;
+	//! one count for each queued buffer, and one for each thread to end it
+	HANDLE QueuedSemaphore;
+	//! one count for each free buffer
+	HANDLE FreeSemaphore;
+	core::array<HANDLE> Handles;
+
+	static DWORD WINAPI threadMain(LPVOID data)
+	{
+		((CFrameCapture*)data)->encode();
+		return 0;
+	}
+};
+
+#else
+
+struct CFrameCapture::SThreads
+{
+	pthread_mutex_t Mutex;
+	pthread_cond_t QueuedCondition;
+	pthread_cond_t FreeCondition;
+	core::array<pthread_t> Handles;
+	bool Quit;
+
+	static void* threadMain(void* data)
+	{
+		((CFrameCapture*)data)->encode();
+		return 0;
+	}
+};
+
+#endif
+
+
+//! constructor, starts the threads
+CFrameCapture::CFrameCapture(IVideoDriver* driver, io::IFileSystem* fileSystem,
+		const io::path& fileName, u32 threadCount, u32 bufferCount)
+: Threads(new SThreads), Driver(driver), FileSystem(fileSystem), FileName(fileName),
+	Raw(core::hasFileExtension(fileName, "raw")), FrameCount(0), FailedCount(0)
+{
+	threadCount = core::clamp(threadCount, 1u, 64u);
+	bufferCount = core::max_(bufferCount, 1u);
+
+	Buffers.set_used(bufferCount);
+	BufferFrames.set_used(bufferCount);
+	for (u32 i=0; i<bufferCount; ++i)
+	{
+		Buffers[i] = 0;
+		FreeBuffers.push_back(i);
+	}
+
+#ifdef _IRR_WINDOWS_API_
+	InitializeCriticalSection(&Threads->Mutex);
+	Threads->QueuedSemaphore = CreateSemaphore(0, 0, 0x7fffffff, 0);
+	Threads->FreeSemaphore = CreateSemaphore(0, bufferCount, 0x7fffffff, 0);
+#else
+	pthread_mutex_init(&Threads->Mutex, 0);
+	pthread_cond_init(&Threads->QueuedCondition, 0);
+	pthread_cond_init(&Threads->FreeCondition, 0);
+	Threads->Quit = false;
+#endif
+
+	for (u32 i=0; i<threadCount; ++i)
+	{
+#ifdef _IRR_WINDOWS_API_
+		HANDLE handle = CreateThread(0, 0, SThreads::threadMain, this, 0, 0);
+		if (!handle)
+			break;
+#else
+		pthread_t handle;
+		if (pthread_create(&handle, 0, SThreads::threadMain, this) != 0)
+			break;
+#endif
+		Threads->Handles.push_back(handle);
+	}
+
+	if (Threads->Handles.empty())
+		os::Printer::log("Could not start the frame capture threads, frames are written when presented.", ELL_WARNING);
+}
+
+
+//! destructor, writes the remaining frames and ends the threads
+CFrameCapture::~CFrameCapture()
+{
+	const u32 threadCount = Threads->Handles.size();
+#ifdef _IRR_WINDOWS_API_
+	if (threadCount)
+	{
+		ReleaseSemaphore(Threads->QueuedSemaphore, threadCount, 0);
+		WaitForMultipleObjects(threadCount, Threads->Handles.pointer(), TRUE, INFINITE);
+	}
+	for (u32 i=0; i<threadCount; ++i)
+		CloseHandle(Threads->Handles[i]);
+	CloseHandle(Threads->FreeSemaphore);
+	CloseHandle(Threads->QueuedSemaphore);
+	DeleteCriticalSection(&Threads->Mutex);
+#else
+	pthread_mutex_lock(&Threads->Mutex);
+	Threads->Quit = true;
+	pthread_cond_broadcast(&Threads->QueuedCondition);
+	pthread_mutex_unlock(&Threads->Mutex);
+	for (u32 i=0; i<threadCount; ++i)
+		pthread_join(Threads->Handles[i], 0);
+	pthread_cond_destroy(&Threads->FreeCondition);
+	pthread_cond_destroy(&Threads->QueuedCondition);
+	pthread_mutex_destroy(&Threads->Mutex);
+#endif
+	delete Threads;
+
+	for (u32 i=0; i<Buffers.size(); ++i)
+	{
+		if (Buffers[i])
+			Buffers[i]->drop();
+	}
+
+	core::stringc msg = "Captured ";
+	msg += FrameCount;
+	msg += " frames";
+	os::Printer::log(msg.c_str(), FileName.c_str(), ELL_INFORMATION);
+	if (FailedCount)
+	{
+		msg = "Could not write ";
+		msg += FailedCount;
+		msg += " captured frames";
+		os::Printer::log(msg.c_str(), FileName.c_str(), ELL_WARNING);
+	}
+}
+
+
+//! copies a frame into a buffer and queues it for writing
+void CFrameCapture::capture(IImage* frame)
+{
+	if (!frame)
+		return;
+
+	// wait for a free buffer, only when the threads fall behind
+#ifdef _IRR_WINDOWS_API_
+	if (!Threads->Handles.empty())
+		WaitForSingleObject(Threads->FreeSemaphore, INFINITE);
+	EnterCriticalSection(&Threads->Mutex);
+	const u32 buffer = FreeBuffers.getLast();
+	FreeBuffers.erase(FreeBuffers.size()-1);
+	LeaveCriticalSection(&Threads->Mutex);
+#else
+	pthread_mutex_lock(&Threads->Mutex);
+	while (FreeBuffers.empty())
+		pthread_cond_wait(&Threads->FreeCondition, &Threads->Mutex);
+	const u32 buffer = FreeBuffers.getLast();
+	FreeBuffers.erase(FreeBuffers.size()-1);
+	pthread_mutex_unlock(&Threads->Mutex);
+#endif
+
+	// frames are stored without alpha, which also makes them faster to encode
+	if (Buffers[buffer] && Buffers[buffer]->getDimension() != frame->getDimension())
+	{
+		Buffers[buffer]->drop();
+		Buffers[buffer] = 0;
+	}
+	if (!Buffers[buffer])
+		Buffers[buffer] = new CImage(ECF_R8G8B8, frame->getDimension());
+
+	frame->copyTo(Buffers[buffer]);
+	BufferFrames[buffer] = FrameCount++;
+
+	if (Threads->Handles.empty())
+	{
+		write(Buffers[buffer], BufferFrames[buffer]);
+		FreeBuffers.push_back(buffer);
+		return;
+	}
+
+#ifdef _IRR_WINDOWS_API_
+	EnterCriticalSection(&Threads->Mutex);
+	QueuedBuffers.push_back(buffer);
+	LeaveCriticalSection(&Threads->Mutex);
+	ReleaseSemaphore(Threads->QueuedSemaphore, 1, 0);
+#else
+	pthread_mutex_lock(&Threads->Mutex);
+	QueuedBuffers.push_back(buffer);
+	pthread_cond_signal(&Threads->QueuedCondition);
+	pthread_mutex_unlock(&Threads->Mutex);
+#endif
+}
+
+
+//! writes queued frames until the capture ends
+void CFrameCapture::encode()
+{
+	for (;;)
+	{
+#ifdef _IRR_WINDOWS_API_
+		WaitForSingleObject(Threads->QueuedSemaphore, INFINITE);
+		EnterCriticalSection(&Threads->Mutex);
+		// the destructor releases the semaphore once for each thread
+		if (QueuedBuffers.empty())
+		{
+			LeaveCriticalSection(&Threads->Mutex);
+			return;
+		}
+		const u32 buffer = QueuedBuffers[0];
+		QueuedBuffers.erase(0);
+		LeaveCriticalSection(&Threads->Mutex);
+#else
+		pthread_mutex_lock(&Threads->Mutex);
+		while (QueuedBuffers.empty() && !Threads->Quit)
+			pthread_cond_wait(&Threads->QueuedCondition, &Threads->Mutex);
+		// write all queued frames before ending
+		if (QueuedBuffers.empty())
+		{
+			pthread_mutex_unlock(&Threads->Mutex);
+			return;
+		}
+		const u32 buffer = QueuedBuffers[0];
+		QueuedBuffers.erase(0);
+		pthread_mutex_unlock(&Threads->Mutex);
+#endif
+
+		write(Buffers[buffer], BufferFrames[buffer]);
+
+#ifdef _IRR_WINDOWS_API_
+		EnterCriticalSection(&Threads->Mutex);
+		FreeBuffers.push_back(buffer);
+		LeaveCriticalSection(&Threads->Mutex);
+		ReleaseSemaphore(Threads->FreeSemaphore, 1, 0);
+#else
+		pthread_mutex_lock(&Threads->Mutex);
+		FreeBuffers.push_back(buffer);
+		pthread_cond_signal(&Threads->FreeCondition);
+		pthread_mutex_unlock(&Threads->Mutex);
+#endif
+	}
+}
+
+
+//! writes a buffer to the file of a frame
+void CFrameCapture::write(IImage* image, u32 frame)
+{
+	c8 name[1024];
+	snprintf(name, sizeof(name), FileName.c_str(), frame);
+
+	// the image writers and the file system keep no state while writing,
+	// so several threads can use them at once
+	bool written = false;
+	if (Raw)
+	{
+		io::IWriteFile* file = FileSystem->createAndWriteFile(name);
+		if (file)
+		{
+			const s32 size = (s32)image->getImageDataSizeInBytes();
+			written = file->write(image->lock(), size) == size;
+			image->unlock();
+			file->drop();
+		}
+	}
+	else
+		written = Driver->writeImageToFile(image, name);
+
+	if (written)
+		return;
+
+#ifdef _IRR_WINDOWS_API_
+	EnterCriticalSection(&Threads->Mutex);
+	const bool first = (FailedCount++ == 0);
+	LeaveCriticalSection(&Threads->Mutex);
+#else
+	pthread_mutex_lock(&Threads->Mutex);
+	const bool first = (FailedCount++ == 0);
+	pthread_mutex_unlock(&Threads->Mutex);
+#endif
+	if (first)
+		os::Printer::log("Could not write captured frame", name, ELL_WARNING);
+}
+
+} // end namespace video
+} // end namespace irr
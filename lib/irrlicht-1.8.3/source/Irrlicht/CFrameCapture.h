@@ -0,0 +1,83 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_FRAME_CAPTURE_H_INCLUDED__
+#define __C_FRAME_CAPTURE_H_INCLUDED__
+
+#include "IImage.h"
+#include "path.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace io
+{
+	class IFileSystem;
+} // end namespace io
+namespace video
+{
+	class IVideoDriver;
+
+	//! Writes presented frames to numbered files on background threads.
+	/** capture() copies a frame into one of a fixed number of buffers
+	and returns, the threads encode the buffers with the image writers of
+	the driver. Only when all buffers wait for encoding, capture() waits
+	until one of them is written. */
+	class CFrameCapture
+	{
+	public:
+
+		//! constructor, starts the threads
+		/** \param driver Its image writers encode the frames.
+		\param fileSystem Creates the files.
+		\param fileName printf() format of the file names with the
+		frame number, the extension selects the writer. The extension
+		"raw" writes the R8G8B8 pixels without a header.
+		\param threadCount Number of threads which encode frames.
+		\param bufferCount Number of frames which can wait for encoding. */
+		CFrameCapture(IVideoDriver* driver, io::IFileSystem* fileSystem,
+			const io::path& fileName, u32 threadCount, u32 bufferCount);
+
+		//! destructor, writes the remaining frames and ends the threads
+		~CFrameCapture();
+
+		//! copies a frame into a buffer and queues it for writing
+		void capture(IImage* frame);
+
+		//! returns the number of frames captured so far
+		u32 getFrameCount() const { return FrameCount; }
+
+	private:
+
+		//! writes queued frames until the capture ends
+		void encode();
+
+		//! writes a buffer to the file of a frame
+		void write(IImage* image, u32 frame);
+
+		struct SThreads;
+		SThreads* Threads;
+
+		IVideoDriver* Driver;
+		io::IFileSystem* FileSystem;
+		core::stringc FileName;
+		bool Raw;
+
+		//! frame buffers, created at the size of the first frame put into them
+		core::array<IImage*> Buffers;
+		//! buffers which can take a frame
+		core::array<u32> FreeBuffers;
+		//! buffers waiting for encoding, in capture order
+		core::array<u32> QueuedBuffers;
+		//! frame number of each buffer
+		core::array<u32> BufferFrames;
+
+		u32 FrameCount;
+		u32 FailedCount;
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
@@ -15,6 +15,17 @@ namespace irr
 namespace scene
 {
 
+//! destructor
+CGeometryCreator::~CGeometryCreator()
+{
+	// meshes still used by scene nodes stay alive until those drop them
+	core::map<SSharedMeshKey, IMesh*>::Iterator it = SharedMeshes.getIterator();
+	for (; !it.atEnd(); it++)
+		it->getValue()->drop();
+	SharedMeshes.clear();
+}
+
+
 IMesh* CGeometryCreator::createCubeMesh(const core::vector3df& size) const
 {
 	SMeshBuffer* buffer = new SMeshBuffer();
@@ -887,6 +898,129 @@ IMesh* CGeometryCreator::createVolumeLightMesh(
 }
 
 
+IMesh* CGeometryCreator::getSharedCubeMesh(const core::vector3df& size) const
+{
+	SSharedMeshKey key(ESMT_CUBE);
+	key.Size[0] = size.X;
+	key.Size[1] = size.Y;
+	key.Size[2] = size.Z;
+
+	IMesh* mesh = findSharedMesh(key);
+	if (!mesh)
+		mesh = addSharedMesh(key, createCubeMesh(size));
+	return mesh;
+}
+
+
+IMesh* CGeometryCreator::getSharedSphereMesh(f32 radius, u32 polyCountX, u32 polyCountY) const
+{
+	SSharedMeshKey key(ESMT_SPHERE);
+	key.Size[0] = radius;
+	key.Count[0] = polyCountX;
+	key.Count[1] = polyCountY;
+
+	IMesh* mesh = findSharedMesh(key);
+	if (!mesh)
+		mesh = addSharedMesh(key, createSphereMesh(radius, polyCountX, polyCountY));
+	return mesh;
+}
+
+
+IMesh* CGeometryCreator::getSharedCylinderMesh(f32 radius, f32 length,
+			u32 tesselation, const video::SColor& color,
+			bool closeTop, f32 oblique) const
+{
+	SSharedMeshKey key(ESMT_CYLINDER);
+	key.Size[0] = radius;
+	key.Size[1] = length;
+	key.Size[2] = oblique;
+	key.Count[0] = tesselation;
+	key.Count[1] = closeTop ? 1 : 0;
+	key.Color[0] = color.color;
+
+	IMesh* mesh = findSharedMesh(key);
+	if (!mesh)
+		mesh = addSharedMesh(key, createCylinderMesh(radius, length, tesselation, color, closeTop, oblique));
+	return mesh;
+}
+
+
+IMesh* CGeometryCreator::getSharedVolumeLightMesh(
+		const u32 subdivideU, const u32 subdivideV,
+		const video::SColor footColor, const video::SColor tailColor,
+		const f32 lpDistance, const core::vector3df& lightDim) const
+{
+	SSharedMeshKey key(ESMT_VOLUME_LIGHT);
+	key.Size[0] = lightDim.X;
+	key.Size[1] = lightDim.Y;
+	key.Size[2] = lightDim.Z;
+	key.Size[3] = lpDistance;
+	key.Count[0] = subdivideU;
+	key.Count[1] = subdivideV;
+	key.Color[0] = footColor.color;
+	key.Color[1] = tailColor.color;
+
+	IMesh* mesh = findSharedMesh(key);
+	if (!mesh)
+		mesh = addSharedMesh(key, createVolumeLightMesh(subdivideU, subdivideV,
+				footColor, tailColor, lpDistance, lightDim));
+	return mesh;
+}
+
+
+u32 CGeometryCreator::removeUnusedSharedMeshes() const
+{
+	// a reference count of one means only the cache holds the mesh
+	core::array<SSharedMeshKey> unused;
+	core::map<SSharedMeshKey, IMesh*>::Iterator it = SharedMeshes.getIterator();
+	for (; !it.atEnd(); it++)
+	{
+		if (it->getValue()->getReferenceCount() == 1)
+			unused.push_back(it->getKey());
+	}
+
+	for (u32 i=0; i<unused.size(); ++i)
+	{
+		core::map<SSharedMeshKey, IMesh*>::Node* node = SharedMeshes.find(unused[i]);
+		node->getValue()->drop();
+		SharedMeshes.remove(node);
+	}
+	return unused.size();
+}
+
+
+u32 CGeometryCreator::getSharedMeshCount() const
+{
+	return SharedMeshes.size();
+}
+
+
+IMesh* CGeometryCreator::findSharedMesh(const SSharedMeshKey& key) const
+{
+	core::map<SSharedMeshKey, IMesh*>::Node* node = SharedMeshes.find(key);
+	if (!node)
+		return 0;
+
+	node->getValue()->grab();
+	return node->getValue();
+}
+
+
+IMesh* CGeometryCreator::addSharedMesh(const SSharedMeshKey& key, IMesh* mesh) const
+{
+	if (!mesh)
+		return 0;
+
+	// new meshes are rare, so this is a good time to forget the unused ones
+	removeUnusedSharedMeshes();
+
+	// one reference for the cache, the one from create*Mesh goes to the caller
+	mesh->grab();
+	SharedMeshes.insert(key, mesh);
+	return mesh;
+}
+
+
 } // end namespace scene
 } // end namespace irr
 
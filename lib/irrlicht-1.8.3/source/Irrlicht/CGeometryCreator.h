@@ -7,6 +7,8 @@
 
 #include "IGeometryCreator.h"
 #include "SMeshBuffer.h"
+#include "irrMap.h"
+#include <string.h>
 
 namespace irr
 {
@@ -19,6 +21,9 @@ class CGeometryCreator : public IGeometryCreator
 {
 	void addToBuffer(const video::S3DVertex& v, SMeshBuffer* Buffer) const;
 public:
+	//! destructor
+	~CGeometryCreator();
+
 	IMesh* createCubeMesh(const core::vector3df& size) const;
 
 	IMesh* createHillPlaneMesh(
@@ -55,6 +60,71 @@ public:
 			const video::SColor tailColor=0xffffffff,
 			const f32 lpDistance = 8.f,
 			const core::vector3df& lightDim = core::vector3df(1.f,1.2f,1.f)) const;
+
+	IMesh* getSharedCubeMesh(const core::vector3df& size) const;
+
+	IMesh* getSharedSphereMesh(f32 radius, u32 polyCountX, u32 polyCountY) const;
+
+	IMesh* getSharedCylinderMesh(f32 radius, f32 length, u32 tesselation,
+				const video::SColor& color=0xffffffff,
+				bool closeTop=true, f32 oblique=0.f) const;
+
+	IMesh* getSharedVolumeLightMesh(
+			const u32 subdivideU=32, const u32 subdivideV=32,
+			const video::SColor footColor=0xffffffff,
+			const video::SColor tailColor=0xffffffff,
+			const f32 lpDistance = 8.f,
+			const core::vector3df& lightDim = core::vector3df(1.f,1.2f,1.f)) const;
+
+	u32 removeUnusedSharedMeshes() const;
+
+	u32 getSharedMeshCount() const;
+
+private:
+
+	enum E_SHARED_MESH_TYPE
+	{
+		ESMT_CUBE = 0,
+		ESMT_SPHERE,
+		ESMT_CYLINDER,
+		ESMT_VOLUME_LIGHT
+	};
+
+	//! Identifies a shared mesh by its primitive type and creation parameters.
+	/** All members are 32 bit, so there is no padding and keys can be
+	compared bytewise. Unused parameters stay zero. */
+	struct SSharedMeshKey
+	{
+		SSharedMeshKey(E_SHARED_MESH_TYPE type)
+		{
+			memset(this, 0, sizeof(SSharedMeshKey));
+			Type = type;
+		}
+
+		bool operator<(const SSharedMeshKey& other) const
+		{
+			return memcmp(this, &other, sizeof(SSharedMeshKey)) < 0;
+		}
+
+		bool operator==(const SSharedMeshKey& other) const
+		{
+			return memcmp(this, &other, sizeof(SSharedMeshKey)) == 0;
+		}
+
+		u32 Type;
+		f32 Size[4];
+		u32 Count[2];
+		u32 Color[2];
+	};
+
+	//! returns the cached mesh for the key, grabbed, or 0
+	IMesh* findSharedMesh(const SSharedMeshKey& key) const;
+
+	//! adds a newly created mesh to the cache and returns it
+	IMesh* addSharedMesh(const SSharedMeshKey& key, IMesh* mesh) const;
+
+	//! the cache holds one reference to each mesh
+	mutable core::map<SSharedMeshKey, IMesh*> SharedMeshes;
 };
 
 
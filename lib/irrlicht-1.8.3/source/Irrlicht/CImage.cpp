@@ -6,12 +6,158 @@
 #include "irrString.h"
 #include "CColorConverter.h"
 #include "CBlit.h"
+#include "CThreadPool.h"
+
+// sse2 is part of every x86-64 cpu
+#if defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define _IRR_IMAGE_USE_SSE2_
+	#include <emmintrin.h>
+#endif
 
 namespace irr
 {
 namespace video
 {
 
+namespace
+{
+	//! sums up the 2x2 blocks of a row of pixels, or 2x1 and 1x2 blocks once a side is one pixel long
+	template <class T>
+	void sumBlocks(u32* dest, const T* row0, const T* row1, u32 x, u32 width,
+		u32 channels, u32 stepX, u32 stepY)
+	{
+		for ( ; x < width; ++x )
+		{
+			const T* a = row0 + x * stepX * channels;
+			const T* b = row1 + x * stepX * channels;
+			for ( u32 c = 0; c != channels; ++c )
+			{
+				u32 sum = a[c];
+				if ( stepX == 2 )
+					sum += a[c + channels];
+				if ( stepY == 2 )
+				{
+					sum += b[c];
+					if ( stepX == 2 )
+						sum += b[c + channels];
+				}
+				dest[x * channels + c] = sum;
+			}
+		}
+	}
+
+
+	//! one halving step of CImage::copyToMipMapLevels()
+	/** Sums up the channels of each block of the source level, which are
+	either the bytes of the image or the sums of the step before, and
+	writes the sums shifted down into the pixels of the target, if any. */
+	class CBoxFilterStep : public CThreadPool::IJob
+	{
+	public:
+
+		virtual void run(u32 index, u32 thread)
+		{
+			const u32 end = core::min_(Height, (index + 1) * RowsPerItem);
+			for (u32 y = index * RowsPerItem; y < end; ++y)
+			{
+				sumRow(y);
+				if (Target)
+					writeRow(y);
+			}
+		}
+
+		const u8* SourceBytes;
+		const u32* SourceSums;
+		u32 SourceWidth;
+		u32 SourceHeight;
+		u32* Sums;
+		u32 Width;
+		u32 Height;
+		u32 Channels;
+		u8* Target;
+		u32 TargetPitch;
+		u32 Shift;
+		u32 RowsPerItem;
+
+	private:
+
+		void sumRow(u32 y)
+		{
+			const u32 stepX = SourceWidth > 1 ? 2 : 1;
+			const u32 stepY = SourceHeight > 1 ? 2 : 1;
+			const u32 sourcePitch = SourceWidth * Channels;
+			const u32 row0 = y * stepY * sourcePitch;
+			const u32 row1 = row0 + (stepY - 1) * sourcePitch;
+			u32* dest = Sums + y * Width * Channels;
+			u32 x = 0;
+
+			if (SourceBytes)
+			{
+#ifdef _IRR_IMAGE_USE_SSE2_
+				if (Channels == 4 && stepX == 2 && stepY == 2)
+				{
+					// two blocks of 16 bit sums at once
+					const u8* a = SourceBytes + row0;
+					const u8* b = SourceBytes + row1;
+					const __m128i zero = _mm_setzero_si128();
+					for (; x + 2 <= Width; x += 2)
+					{
+						const __m128i p0 = _mm_loadu_si128((const __m128i*)(a + x * 8));
+						const __m128i p1 = _mm_loadu_si128((const __m128i*)(b + x * 8));
+						const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(p0, zero), _mm_unpacklo_epi8(p1, zero));
+						const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(p0, zero), _mm_unpackhi_epi8(p1, zero));
+						const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+						_mm_storeu_si128((__m128i*)(dest + x * 4), _mm_unpacklo_epi16(sum, zero));
+						_mm_storeu_si128((__m128i*)(dest + x * 4 + 4), _mm_unpackhi_epi16(sum, zero));
+					}
+				}
+#endif
+				sumBlocks(dest, SourceBytes + row0, SourceBytes + row1, x, Width, Channels, stepX, stepY);
+			}
+			else
+			{
+#ifdef _IRR_IMAGE_USE_SSE2_
+				if (Channels == 4 && stepX == 2 && stepY == 2)
+				{
+					const __m128i* a = (const __m128i*)(SourceSums + row0);
+					const __m128i* b = (const __m128i*)(SourceSums + row1);
+					for (; x < Width; ++x)
+					{
+						const __m128i top = _mm_add_epi32(_mm_loadu_si128(a + x * 2), _mm_loadu_si128(a + x * 2 + 1));
+						const __m128i bottom = _mm_add_epi32(_mm_loadu_si128(b + x * 2), _mm_loadu_si128(b + x * 2 + 1));
+						_mm_storeu_si128((__m128i*)(dest + x * 4), _mm_add_epi32(top, bottom));
+					}
+				}
+#endif
+				sumBlocks(dest, SourceSums + row0, SourceSums + row1, x, Width, Channels, stepX, stepY);
+			}
+		}
+
+		void writeRow(u32 y)
+		{
+			const u32* sums = Sums + y * Width * Channels;
+			u8* dest = Target + y * TargetPitch;
+			const u32 count = Width * Channels;
+			u32 i = 0;
+#ifdef _IRR_IMAGE_USE_SSE2_
+			const __m128i shift = _mm_cvtsi32_si128(Shift);
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m128i* s = (const __m128i*)(sums + i);
+				const __m128i lo = _mm_packs_epi32(_mm_srl_epi32(_mm_loadu_si128(s), shift),
+					_mm_srl_epi32(_mm_loadu_si128(s + 1), shift));
+				const __m128i hi = _mm_packs_epi32(_mm_srl_epi32(_mm_loadu_si128(s + 2), shift),
+					_mm_srl_epi32(_mm_loadu_si128(s + 3), shift));
+				_mm_storeu_si128((__m128i*)(dest + i), _mm_packus_epi16(lo, hi));
+			}
+#endif
+			for (; i < count; ++i)
+				dest[i] = (u8)(sums[i] >> Shift);
+		}
+	};
+}
+
+
 //! Constructor of empty image
 CImage::CImage(ECOLOR_FORMAT format, const core::dimension2d<u32>& size)
 :Data(0), Size(size), Format(format), DeleteMemory(true)
@@ -386,6 +532,101 @@ void CImage::copyToScalingBoxFilter(IImage* target, s32 bias, bool blend)
 }
 
 
+//! box filters this image into the levels of a mip map chain
+void CImage::copyToMipMapLevels(IImage** targets, u32 count, CThreadPool* threads)
+{
+	// the channels are summed up byte by byte, the order does not matter
+	const u32 channels = Format == ECF_A8R8G8B8 ? 4 : Format == ECF_R8G8B8 ? 3 : 0;
+
+	// sums of the last step, one buffer is read while the other is written
+	core::array<u32> sums[2];
+	u32 step = 0;
+	u32 width = Size.Width;
+	u32 height = Size.Height;
+	u32 shift = 0;
+	IImage* last = 0;
+
+	for (u32 i = 0; i != count; ++i)
+	{
+		IImage* target = targets[i];
+		if (!target)
+			continue;
+
+		// count the halvings from the last step to the target. sides
+		// which do not halve exactly are left to the old filter
+		const core::dimension2d<u32>& dim = target->getDimension();
+		bool exact = channels && target->getColorFormat() == Format;
+		u32 halvings = 0;
+		u32 w = width;
+		u32 h = height;
+		while (exact && (w != dim.Width || h != dim.Height))
+		{
+			if ((w == 1 && h == 1) || (w > 1 && (w & 1)) || (h > 1 && (h & 1)))
+				exact = false;
+			w = core::max_(1u, w >> 1);
+			h = core::max_(1u, h >> 1);
+			++halvings;
+		}
+
+		if (!exact || (!halvings && !last))
+		{
+			copyToScalingBoxFilter(target);
+			continue;
+		}
+
+		if (!halvings)
+		{
+			// the same size as the level before
+			memcpy(target->lock(), last->lock(), target->getImageDataSizeInBytes());
+			last->unlock();
+			target->unlock();
+			continue;
+		}
+
+		u8* dest = (u8*)target->lock();
+		for (u32 k = 0; k != halvings; ++k)
+		{
+			CBoxFilterStep job;
+			job.SourceBytes = step ? 0 : Data;
+			job.SourceSums = step ? sums[(step - 1) & 1].const_pointer() : 0;
+			job.SourceWidth = width;
+			job.SourceHeight = height;
+
+			shift += (width > 1 ? 1 : 0) + (height > 1 ? 1 : 0);
+			width = core::max_(1u, width >> 1);
+			height = core::max_(1u, height >> 1);
+
+			core::array<u32>& out = sums[step & 1];
+			out.set_used(width * height * channels);
+			job.Sums = out.pointer();
+			job.Width = width;
+			job.Height = height;
+			job.Channels = channels;
+			job.Target = k + 1 == halvings ? dest : 0;
+			job.TargetPitch = target->getPitch();
+			job.Shift = shift;
+
+			// small levels are not worth waking up the threads for
+			const u32 threadCount = threads ? threads->getThreadCount() : 1;
+			if (threadCount > 1 && width * height >= 16384)
+			{
+				const u32 items = core::min_(height, threadCount * 4);
+				job.RowsPerItem = (height + items - 1) / items;
+				threads->run(job, (height + job.RowsPerItem - 1) / job.RowsPerItem);
+			}
+			else
+			{
+				job.RowsPerItem = height;
+				job.run(0, 0);
+			}
+			++step;
+		}
+		target->unlock();
+		last = target;
+	}
+}
+
+
 //! fills the surface with given color
 void CImage::fill(const SColor &color)
 {
@@ -10,6 +10,8 @@
 
 namespace irr
 {
+class CThreadPool;
+
 namespace video
 {
 
@@ -100,6 +102,15 @@ public:
 	//! copies this surface into another, scaling it to fit, appyling a box filter
 	virtual void copyToScalingBoxFilter(IImage* target, s32 bias = 0, bool blend = false);
 
+	//! box filters this image into the levels of a mip map chain
+	/** Each level gets the same pixels as copyToScalingBoxFilter() into it.
+	A8R8G8B8 and R8G8B8 levels which halve the size of the level before
+	are summed up from the sums of that level, instead of from this image.
+	\param targets Levels, largest first. Null entries are skipped.
+	\param count Number of entries in targets.
+	\param threads Pool to split the rows of large levels over, may be 0. */
+	void copyToMipMapLevels(IImage** targets, u32 count, CThreadPool* threads = 0);
+
 	//! fills the surface with given color
 	virtual void fill(const SColor &color);
 
@@ -31,6 +31,19 @@ namespace video
 namespace
 {
 
+/*!
+	DDSColorToPixel()
+	returns a color as pixel of the image. copied, as the compiler may assume
+	the bytes of a ddsColor are never read as u32
+*/
+inline u32 DDSColorToPixel( const ddsColor& color )
+{
+	u32 pixel;
+	memcpy( &pixel, &color, sizeof( pixel ) );
+	return pixel;
+}
+
+
 /*!
 	DDSDecodePixelFormat()
 	determines which pixel format the dds texture is in
@@ -112,7 +125,7 @@ void DDSGetColorBlockColors( ddsColorBlock *block, ddsColor colors[ 4 ] )
 	word >>= 5;
 	colors[ 0 ].g = (u8) word;
 	colors[ 0 ].g <<= 2;
-	colors[ 0 ].g |= (colors[ 0 ].g >> 5);
+	colors[ 0 ].g |= (colors[ 0 ].g >> 6);
 	word >>= 6;
 	colors[ 0 ].r = (u8) word;
 	colors[ 0 ].r <<= 3;
@@ -129,7 +142,7 @@ void DDSGetColorBlockColors( ddsColorBlock *block, ddsColor colors[ 4 ] )
 	word >>= 5;
 	colors[ 1 ].g = (u8) word;
 	colors[ 1 ].g <<= 2;
-	colors[ 1 ].g |= (colors[ 1 ].g >> 5);
+	colors[ 1 ].g |= (colors[ 1 ].g >> 6);
 	word >>= 6;
 	colors[ 1 ].r = (u8) word;
 	colors[ 1 ].r <<= 3;
@@ -192,10 +205,14 @@ decodes a dds color block
 fixme: make endian-safe
 */
 
-void DDSDecodeColorBlock( u32 *pixel, ddsColorBlock *block, s32 width, u32 colors[ 4 ] )
+void DDSDecodeColorBlock( u32 *pixel, ddsColorBlock *block, s32 width, const ddsColor blockColors[ 4 ] )
 {
 	s32				r, n;
 	u32	bits;
+	u32	colors[ 4 ];
+
+	for( n = 0; n < 4; n++ )
+		colors[ n ] = DDSColorToPixel( blockColors[ n ] );
 	u32	masks[] = { 3, 12, 3 << 4, 3 << 6 };	/* bit masks = 00000011, 00001100, 00110000, 11000000 */
 	s32				shift[] = { 0, 2, 4, 6 };
 
@@ -271,7 +288,7 @@ void DDSDecodeAlphaExplicit( u32 *pixel, ddsAlphaBlockExplicit *alphaBlock, s32
 			*pixel &= alphaZero;
 			color.a = word & 0x000F;
 			color.a = color.a | (color.a << 4);
-			*pixel |= *((u32*) &color);
+			*pixel |= DDSColorToPixel( color );
 			word >>= 4;		/* move next bits to lowest 4 */
 			pixel++;		/* move to next pixel in the row */
 		}
@@ -382,7 +399,7 @@ void DDSDecodeAlpha3BitLinear( u32 *pixel, ddsAlphaBlock3BitLinear *alphaBlock,
 			*pixel &= alphaZero;
 
 			/* or the bits into the prev. nulled alpha */
-			*pixel |= *((u32*) &(aColors[ row ][ pix ]));
+			*pixel |= DDSColorToPixel( aColors[ row ][ pix ] );
 			pixel++;
 		}
 	}
@@ -415,7 +432,7 @@ s32 DDSDecompressDXT1( ddsBuffer *dds, s32 width, s32 height, u8 *pixels )
 		{
 			DDSGetColorBlockColors( block, colors );
 			pixel = (u32*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (u32*) colors );
+			DDSDecodeColorBlock( pixel, block, width, colors );
 		}
 	}
 
@@ -446,7 +463,7 @@ s32 DDSDecompressDXT3( ddsBuffer *dds, s32 width, s32 height, u8 *pixels )
 	colors[ 0 ].r = 0xFF;
 	colors[ 0 ].g = 0xFF;
 	colors[ 0 ].b = 0xFF;
-	alphaZero = *((u32*) &colors[ 0 ]);
+	alphaZero = DDSColorToPixel( colors[ 0 ] );
 
 	/* walk y */
 	for( y = 0; y < yBlocks; y++ )
@@ -466,7 +483,7 @@ s32 DDSDecompressDXT3( ddsBuffer *dds, s32 width, s32 height, u8 *pixels )
 
 			/* decode color block */
 			pixel = (u32*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (u32*) colors );
+			DDSDecodeColorBlock( pixel, block, width, colors );
 
 			/* overwrite alpha bits with alpha block */
 			DDSDecodeAlphaExplicit( pixel, alphaBlock, width, alphaZero );
@@ -499,7 +516,7 @@ s32 DDSDecompressDXT5( ddsBuffer *dds, s32 width, s32 height, u8 *pixels )
 	colors[ 0 ].r = 0xFF;
 	colors[ 0 ].g = 0xFF;
 	colors[ 0 ].b = 0xFF;
-	alphaZero = *((u32*) &colors[ 0 ]);
+	alphaZero = DDSColorToPixel( colors[ 0 ] );
 
 	/* walk y */
 	for( y = 0; y < yBlocks; y++ )
@@ -519,7 +536,7 @@ s32 DDSDecompressDXT5( ddsBuffer *dds, s32 width, s32 height, u8 *pixels )
 
 			/* decode color block */
 			pixel = (u32*) (pixels + x * 16 + (y * 4) * width * 4);
-			DDSDecodeColorBlock( pixel, block, width, (u32*) colors );
+			DDSDecodeColorBlock( pixel, block, width, colors );
 
 			/* overwrite alpha bits with alpha block */
 			DDSDecodeAlpha3BitLinear( pixel, alphaBlock, width, alphaZero );
@@ -698,6 +715,58 @@ IImage* CImageLoaderDDS::loadImage(io::IReadFile* file) const
 }
 
 
+//! reads the blocks of a dxt1 or dxt5 compressed file without decompressing them
+u8* readDDSBlocks(io::IReadFile* file, core::dimension2d<u32>& size, u32& blockSize, u32& mipMapCount)
+{
+	if ( !core::hasFileExtension ( file->getFileName(), "dds" ) )
+		return 0;
+
+	ddsBuffer header;
+	const s32 headerSize = sizeof(ddsBuffer) - sizeof(header.data);
+	s32 width, height;
+	eDDSPixelFormat pixelFormat;
+
+	if ( file->read ( &header, headerSize ) != headerSize ||
+		DDSGetInfo( &header, &width, &height, &pixelFormat ) ||
+		width <= 0 || width > 0x8000 || height <= 0 || height > 0x8000 )
+		return 0;
+
+	if ( pixelFormat == DDS_PF_DXT1 )
+		blockSize = 8;
+	else if ( pixelFormat == DDS_PF_DXT5 )
+		blockSize = 16;
+	else
+		return 0;
+
+	mipMapCount = 1;
+	if ( DDSLittleLong( header.flags ) & DDSD_MIPMAPCOUNT )
+		mipMapCount = core::clamp( (u32) DDSLittleLong( header.mipMapCount ), 1u, 16u );
+
+	// each level has at least one block
+	u32 dataSize = 0;
+	core::dimension2d<u32> levelSize( width, height );
+	for ( u32 i = 0; i != mipMapCount; ++i )
+	{
+		dataSize += ( ( levelSize.Width + 3 ) >> 2 ) * ( ( levelSize.Height + 3 ) >> 2 ) * blockSize;
+		levelSize.Width = core::max_( levelSize.Width >> 1, 1u );
+		levelSize.Height = core::max_( levelSize.Height >> 1, 1u );
+	}
+
+	if ( dataSize > (u32) ( file->getSize() - headerSize ) )
+		return 0;
+
+	u8* blocks = new u8 [ dataSize ];
+	if ( file->read ( blocks, dataSize ) != (s32) dataSize )
+	{
+		delete [] blocks;
+		return 0;
+	}
+
+	size.set( width, height );
+	return blocks;
+}
+
+
 //! creates a loader which is able to load dds images
 IImageLoader* createImageLoaderDDS()
 {
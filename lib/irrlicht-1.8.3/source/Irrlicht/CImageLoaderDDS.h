@@ -36,6 +36,9 @@ enum eDDSPixelFormat
 #define DDS_MID_555		0x03E0;
 #define DDS_HI_555		0x7C00;
 
+/* header flags */
+#define DDSD_MIPMAPCOUNT	0x00020000
+
 
 // byte-align structures
 #include "irrpack.h"
@@ -136,7 +139,8 @@ struct ddsBuffer
 	};
 	u32		alphaBitDepth;
 	u32		reserved;
-	void				*surface;
+	/* a pointer in the writing process, 32 bit in the file */
+	u32		surface;
 	union
 	{
 		ddsColorKey	ckDestOverlay;
@@ -181,7 +185,8 @@ struct ddsAlphaBlock3BitLinear
 
 struct ddsColor
 {
-	u8		r, g, b, a;
+	/* in the order of ECF_A8R8G8B8 in memory */
+	u8		b, g, r, a;
 } PACK_STRUCT;
 
 // Default alignment
@@ -206,11 +211,11 @@ floatSwapUnion;
 
 #ifdef __BIG_ENDIAN__
 
-	s32   DDSBigLong( s32 src ) { return src; }
-	s16 DDSBigShort( s16 src ) { return src; }
-	f32 DDSBigFloat( f32 src ) { return src; }
+	inline s32   DDSBigLong( s32 src ) { return src; }
+	inline s16 DDSBigShort( s16 src ) { return src; }
+	inline f32 DDSBigFloat( f32 src ) { return src; }
 
-	s32 DDSLittleLong( s32 src )
+	inline s32 DDSLittleLong( s32 src )
 	{
 		return ((src & 0xFF000000) >> 24) |
 			((src & 0x00FF0000) >> 8) |
@@ -218,13 +223,13 @@ floatSwapUnion;
 			((src & 0x000000FF) << 24);
 	}
 
-	s16 DDSLittleShort( s16 src )
+	inline s16 DDSLittleShort( s16 src )
 	{
 		return ((src & 0xFF00) >> 8) |
 			((src & 0x00FF) << 8);
 	}
 
-	f32 DDSLittleFloat( f32 src )
+	inline f32 DDSLittleFloat( f32 src )
 	{
 		floatSwapUnion in,out;
 		in.f = src;
@@ -237,11 +242,11 @@ floatSwapUnion;
 
 #else /*__BIG_ENDIAN__*/
 
-	s32   DDSLittleLong( s32 src ) { return src; }
-	s16 DDSLittleShort( s16 src ) { return src; }
-	f32 DDSLittleFloat( f32 src ) { return src; }
+	inline s32   DDSLittleLong( s32 src ) { return src; }
+	inline s16 DDSLittleShort( s16 src ) { return src; }
+	inline f32 DDSLittleFloat( f32 src ) { return src; }
 
-	s32 DDSBigLong( s32 src )
+	inline s32 DDSBigLong( s32 src )
 	{
 		return ((src & 0xFF000000) >> 24) |
 			((src & 0x00FF0000) >> 8) |
@@ -249,13 +254,13 @@ floatSwapUnion;
 			((src & 0x000000FF) << 24);
 	}
 
-	s16 DDSBigShort( s16 src )
+	inline s16 DDSBigShort( s16 src )
 	{
 		return ((src & 0xFF00) >> 8) |
 			((src & 0x00FF) << 8);
 	}
 
-	f32 DDSBigFloat( f32 src )
+	inline f32 DDSBigFloat( f32 src )
 	{
 		floatSwapUnion in,out;
 		in.f = src;
@@ -288,6 +293,12 @@ public:
 };
 
 
+//! reads the blocks of a dxt1 or dxt5 compressed file without decompressing them
+/** Returns the blocks of all mip map levels stored in the file, to be
+deleted with delete [], or 0 if the file is not compressed this way. */
+u8* readDDSBlocks(io::IReadFile* file, core::dimension2d<u32>& size, u32& blockSize, u32& mipMapCount);
+
+
 } // end namespace video
 } // end namespace irr
 
@@ -0,0 +1,239 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CInstancedMeshSceneNode.h"
+#include "IVideoDriver.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "SViewFrustum.h"
+#include "IMaterialRenderer.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CInstancedMeshSceneNode::CInstancedMeshSceneNode(IMesh* mesh, ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position, const core::vector3df& rotation,
+			const core::vector3df& scale)
+: IInstancedMeshSceneNode(parent, mgr, id, position, rotation, scale), Mesh(mesh),
+	BoxDirty(false)
+{
+	#ifdef _DEBUG
+	setDebugName("CInstancedMeshSceneNode");
+	#endif
+
+	if (Mesh)
+	{
+		Mesh->grab();
+		if (Mesh->getMeshBufferCount())
+			Material = Mesh->getMeshBuffer(0)->getMaterial();
+	}
+}
+
+
+//! destructor
+CInstancedMeshSceneNode::~CInstancedMeshSceneNode()
+{
+	if (Mesh)
+		Mesh->drop();
+}
+
+
+//! Adds an instance of the mesh.
+u32 CInstancedMeshSceneNode::addInstance(const core::matrix4& transform, video::SColor color)
+{
+	Transforms.push_back(transform);
+	Colors.push_back(color);
+	BoxDirty = true;
+	return Transforms.size() - 1;
+}
+
+
+//! Removes all instances.
+void CInstancedMeshSceneNode::clearInstances()
+{
+	Transforms.clear();
+	Colors.clear();
+	Box.reset(0,0,0);
+	BoxDirty = false;
+}
+
+
+//! Sets the transformation of an instance.
+void CInstancedMeshSceneNode::setInstanceTransform(u32 index, const core::matrix4& transform)
+{
+	Transforms[index] = transform;
+	BoxDirty = true;
+}
+
+
+//! Sets the color of an instance.
+void CInstancedMeshSceneNode::setInstanceColor(u32 index, video::SColor color)
+{
+	Colors[index] = color;
+}
+
+
+//! recalculates the bounding box of the node from the instances
+void CInstancedMeshSceneNode::updateBoundingBox()
+{
+	if (!BoxDirty)
+		return;
+
+	// transforming the box of the mesh is cheaper than visiting every vertex
+	const core::aabbox3d<f32>& meshBox = Mesh->getBoundingBox();
+	for (u32 i=0; i<Transforms.size(); ++i)
+	{
+		core::aabbox3d<f32> instanceBox(meshBox);
+		Transforms[i].transformBoxEx(instanceBox);
+		if (i == 0)
+			Box = instanceBox;
+		else
+			Box.addInternalBox(instanceBox);
+	}
+	BoxDirty = false;
+}
+
+
+//! frame
+void CInstancedMeshSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible && Mesh && Transforms.size())
+	{
+		updateBoundingBox();
+
+		video::IMaterialRenderer* rnd =
+			SceneManager->getVideoDriver()->getMaterialRenderer(Material.MaterialType);
+
+		if (rnd && rnd->isTransparent())
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_TRANSPARENT);
+		else
+			SceneManager->registerNodeForRendering(this, scene::ESNRP_SOLID);
+	}
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! renders the node.
+void CInstancedMeshSceneNode::render()
+{
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+
+	if (!Mesh || !driver)
+		return;
+
+	// skip the instances the camera cannot see
+	const ICameraSceneNode* camera = SceneManager->getActiveCamera();
+	const bool cull = camera && getAutomaticCulling() != EAC_OFF;
+	core::aabbox3d<f32> frustumBox;
+	if (cull)
+		frustumBox = camera->getViewFrustum()->getBoundingBox();
+
+	// the color of an instance replaces the vertex colors in lit materials
+	video::SMaterial material(Material);
+	material.ColorMaterial = video::ECM_NONE;
+	bool materialSet = false;
+
+	const core::aabbox3d<f32>& meshBox = Mesh->getBoundingBox();
+	core::matrix4 world;
+
+	for (u32 i=0; i<Transforms.size(); ++i)
+	{
+		world.setbyproduct_nocheck(AbsoluteTransformation, Transforms[i]);
+
+		if (cull)
+		{
+			core::aabbox3d<f32> box(meshBox);
+			world.transformBoxEx(box);
+			if (!box.intersectsWithBox(frustumBox))
+				continue;
+		}
+
+		// instances of the same color keep the material of the previous one
+		if (!materialSet || material.DiffuseColor != Colors[i])
+		{
+			material.DiffuseColor = Colors[i];
+			material.AmbientColor = Colors[i];
+			driver->setMaterial(material);
+			materialSet = true;
+		}
+
+		driver->setTransform(video::ETS_WORLD, world);
+		for (u32 j=0; j<Mesh->getMeshBufferCount(); ++j)
+			driver->drawMeshBuffer(Mesh->getMeshBuffer(j));
+	}
+
+	// for debug purposes only:
+	if (DebugDataVisible & (scene::EDS_BBOX | scene::EDS_BBOX_BUFFERS))
+	{
+		video::SMaterial m;
+		m.Lighting = false;
+		driver->setMaterial(m);
+		driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
+
+		if (DebugDataVisible & scene::EDS_BBOX)
+			driver->draw3DBox(Box, video::SColor(255,255,255,255));
+
+		if (DebugDataVisible & scene::EDS_BBOX_BUFFERS)
+		{
+			for (u32 i=0; i<Transforms.size(); ++i)
+			{
+				core::aabbox3d<f32> box(meshBox);
+				Transforms[i].transformBoxEx(box);
+				driver->draw3DBox(box, video::SColor(255,190,128,128));
+			}
+		}
+	}
+}
+
+
+//! returns the axis aligned bounding box of this node
+const core::aabbox3d<f32>& CInstancedMeshSceneNode::getBoundingBox() const
+{
+	return Box;
+}
+
+
+//! returns the material based on the zero based index i.
+video::SMaterial& CInstancedMeshSceneNode::getMaterial(u32 i)
+{
+	return Material;
+}
+
+
+//! returns amount of materials used by this scene node.
+u32 CInstancedMeshSceneNode::getMaterialCount() const
+{
+	return 1;
+}
+
+
+//! Creates a clone of this scene node and its children.
+ISceneNode* CInstancedMeshSceneNode::clone(ISceneNode* newParent, ISceneManager* newManager)
+{
+	if (!newParent)
+		newParent = Parent;
+	if (!newManager)
+		newManager = SceneManager;
+
+	CInstancedMeshSceneNode* nb = new CInstancedMeshSceneNode(Mesh, newParent,
+		newManager, ID, RelativeTranslation, RelativeRotation, RelativeScale);
+
+	nb->cloneMembers(this, newManager);
+	nb->Material = Material;
+	for (u32 i=0; i<Transforms.size(); ++i)
+		nb->addInstance(Transforms[i], Colors[i]);
+
+	if ( newParent )
+		nb->drop();
+	return nb;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,94 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_INSTANCED_MESH_SCENE_NODE_H_INCLUDED__
+#define __C_INSTANCED_MESH_SCENE_NODE_H_INCLUDED__
+
+#include "IInstancedMeshSceneNode.h"
+#include "IMesh.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	class CInstancedMeshSceneNode : public IInstancedMeshSceneNode
+	{
+	public:
+
+		//! constructor
+		CInstancedMeshSceneNode(IMesh* mesh, ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position = core::vector3df(0,0,0),
+			const core::vector3df& rotation = core::vector3df(0,0,0),
+			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f));
+
+		//! destructor
+		virtual ~CInstancedMeshSceneNode();
+
+		//! frame
+		virtual void OnRegisterSceneNode();
+
+		//! renders the node.
+		virtual void render();
+
+		//! returns the axis aligned bounding box of this node
+		virtual const core::aabbox3d<f32>& getBoundingBox() const;
+
+		//! returns the material based on the zero based index i.
+		virtual video::SMaterial& getMaterial(u32 i);
+
+		//! returns amount of materials used by this scene node.
+		virtual u32 getMaterialCount() const;
+
+		//! Returns type of the scene node
+		virtual ESCENE_NODE_TYPE getType() const { return ESNT_INSTANCED_MESH; }
+
+		//! Creates a clone of this scene node and its children.
+		virtual ISceneNode* clone(ISceneNode* newParent=0, ISceneManager* newManager=0);
+
+		//! Get the mesh which is drawn for every instance.
+		virtual IMesh* getMesh() { return Mesh; }
+
+		//! Adds an instance of the mesh.
+		virtual u32 addInstance(const core::matrix4& transform, video::SColor color);
+
+		//! Get the number of instances.
+		virtual u32 getInstanceCount() const { return Transforms.size(); }
+
+		//! Removes all instances.
+		virtual void clearInstances();
+
+		//! Sets the transformation of an instance.
+		virtual void setInstanceTransform(u32 index, const core::matrix4& transform);
+
+		//! Get the transformation of an instance.
+		virtual const core::matrix4& getInstanceTransform(u32 index) const { return Transforms[index]; }
+
+		//! Sets the color of an instance.
+		virtual void setInstanceColor(u32 index, video::SColor color);
+
+		//! Get the color of an instance.
+		virtual video::SColor getInstanceColor(u32 index) const { return Colors[index]; }
+
+	private:
+
+		//! recalculates the bounding box of the node from the instances
+		void updateBoundingBox();
+
+		IMesh* Mesh;
+		video::SMaterial Material;
+
+		core::array<core::matrix4> Transforms;
+		core::array<video::SColor> Colors;
+
+		core::aabbox3d<f32> Box;
+		//! true if the bounding box has to be recalculated
+		bool BoxDirty;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -0,0 +1,184 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CIrrDeviceOffscreen.h"
+
+#ifdef _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+
+#include "os.h"
+#include "CFrameCapture.h"
+
+#ifdef _IRR_WINDOWS_API_
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
+
+namespace irr
+{
+
+//! constructor
+CIrrDeviceOffscreen::CIrrDeviceOffscreen(const SIrrlichtCreationParameters& params)
+  : CIrrDeviceStub(params), Capture(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CIrrDeviceOffscreen");
+	#endif
+
+	switch (params.DriverType)
+	{
+	case video::EDT_SOFTWARE:
+		#ifdef _IRR_COMPILE_WITH_SOFTWARE_
+		VideoDriver = video::createSoftwareDriver(CreationParams.WindowSize, CreationParams.Fullscreen, FileSystem, this);
+		#else
+		os::Printer::log("Software driver was not compiled in.", ELL_ERROR);
+		#endif
+		break;
+
+	case video::EDT_BURNINGSVIDEO:
+		#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
+		VideoDriver = video::createBurningVideoDriver(CreationParams, FileSystem, this);
+		#else
+		os::Printer::log("Burning's Video driver was not compiled in.", ELL_ERROR);
+		#endif
+		break;
+
+	case video::EDT_DIRECT3D8:
+	case video::EDT_DIRECT3D9:
+	case video::EDT_OPENGL:
+		os::Printer::log("The offscreen device cannot use hardware drivers.", ELL_ERROR);
+		break;
+	case video::EDT_NULL:
+		VideoDriver = video::createNullDriver(FileSystem, CreationParams.WindowSize);
+		break;
+	default:
+		break;
+	}
+
+	if (VideoDriver)
+	{
+		createGUIAndScene();
+
+		if (CreationParams.CaptureFileName.size())
+			Capture = new video::CFrameCapture(VideoDriver, FileSystem, CreationParams.CaptureFileName,
+				CreationParams.CaptureThreads, CreationParams.CaptureQueueSize);
+	}
+}
+
+//! destructor
+CIrrDeviceOffscreen::~CIrrDeviceOffscreen()
+{
+	// write the last frames while the driver still exists
+	delete Capture;
+}
+
+//! runs the device. Returns false if device wants to be deleted
+bool CIrrDeviceOffscreen::run()
+{
+	os::Timer::tick();
+	return !Close;
+}
+
+//! Cause the device to temporarily pause execution and let other processes to run
+// This should bring down processor usage without major performance loss for Irrlicht
+void CIrrDeviceOffscreen::yield()
+{
+#ifdef _IRR_WINDOWS_API_
+	Sleep(1);
+#else
+	struct timespec ts = {0,0};
+	nanosleep(&ts, NULL);
+#endif
+}
+
+//! Pause execution and let other processes to run for a specified amount of time.
+void CIrrDeviceOffscreen::sleep(u32 timeMs, bool pauseTimer)
+{
+	const bool wasStopped = Timer ? Timer->isStopped() : true;
+
+	if (pauseTimer && !wasStopped)
+		Timer->stop();
+
+#ifdef _IRR_WINDOWS_API_
+	Sleep(timeMs);
+#else
+	struct timespec ts;
+	ts.tv_sec = (time_t) (timeMs / 1000);
+	ts.tv_nsec = (long) (timeMs % 1000) * 1000000;
+	nanosleep(&ts, NULL);
+#endif
+
+	if (pauseTimer && !wasStopped)
+		Timer->start();
+}
+
+//! sets the caption of the window
+void CIrrDeviceOffscreen::setWindowCaption(const wchar_t* text)
+{
+	// there is no window
+}
+
+//! returns if window is active. if not, nothing need to be drawn
+bool CIrrDeviceOffscreen::isWindowActive() const
+{
+	// there is no window, but we always assume it is active
+	return true;
+}
+
+//! returns if window has focus
+bool CIrrDeviceOffscreen::isWindowFocused() const
+{
+	return true;
+}
+
+//! returns if window is minimized
+bool CIrrDeviceOffscreen::isWindowMinimized() const
+{
+	return false;
+}
+
+//! presents a surface in the client area
+bool CIrrDeviceOffscreen::present(video::IImage* surface, void* windowId, core::rect<s32>* src)
+{
+	if (Capture)
+		Capture->capture(surface);
+
+	return surface != 0;
+}
+
+//! notifies the device that it should close itself
+void CIrrDeviceOffscreen::closeDevice()
+{
+	// return false next time we run()
+	Close = true;
+}
+
+//! Sets if the window should be resizable in windowed mode.
+void CIrrDeviceOffscreen::setResizable(bool resize)
+{
+	// do nothing
+}
+
+//! Minimize the window.
+void CIrrDeviceOffscreen::minimizeWindow()
+{
+	// do nothing
+}
+
+//! Maximize window
+void CIrrDeviceOffscreen::maximizeWindow()
+{
+	// do nothing
+}
+
+//! Restore original window size
+void CIrrDeviceOffscreen::restoreWindow()
+{
+	// do nothing
+}
+
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
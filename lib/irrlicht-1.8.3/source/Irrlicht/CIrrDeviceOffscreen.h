@@ -0,0 +1,90 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_IRR_DEVICE_OFFSCREEN_H_INCLUDED__
+#define __C_IRR_DEVICE_OFFSCREEN_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+
+#include "SIrrCreationParameters.h"
+#include "CIrrDeviceStub.h"
+#include "IImagePresenter.h"
+
+namespace irr
+{
+namespace video
+{
+	class CFrameCapture;
+}
+
+	//! Device without window, input and console output.
+	/** The software drivers render into memory. Presented frames are
+	written to files by a video::CFrameCapture when
+	SIrrlichtCreationParameters::CaptureFileName is set. */
+	class CIrrDeviceOffscreen : public CIrrDeviceStub, video::IImagePresenter
+	{
+	public:
+
+		//! constructor
+		CIrrDeviceOffscreen(const SIrrlichtCreationParameters& params);
+
+		//! destructor
+		virtual ~CIrrDeviceOffscreen();
+
+		//! runs the device. Returns false if device wants to be deleted
+		virtual bool run();
+
+		//! Cause the device to temporarily pause execution and let other processes to run
+		// This should bring down processor usage without major performance loss for Irrlicht
+		virtual void yield();
+
+		//! Pause execution and let other processes to run for a specified amount of time.
+		virtual void sleep(u32 timeMs, bool pauseTimer);
+
+		//! sets the caption of the window
+		virtual void setWindowCaption(const wchar_t* text);
+
+		//! returns if window is active. if not, nothing need to be drawn
+		virtual bool isWindowActive() const;
+
+		//! returns if window has focus
+		virtual bool isWindowFocused() const;
+
+		//! returns if window is minimized
+		virtual bool isWindowMinimized() const;
+
+		//! presents a surface in the client area
+		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0);
+
+		//! notifies the device that it should close itself
+		virtual void closeDevice();
+
+		//! Sets if the window should be resizable in windowed mode.
+		virtual void setResizable(bool resize=false);
+
+		//! Minimizes the window.
+		virtual void minimizeWindow();
+
+		//! Maximizes the window.
+		virtual void maximizeWindow();
+
+		//! Restores the window size.
+		virtual void restoreWindow();
+
+		//! Get the device type
+		virtual E_DEVICE_TYPE getType() const
+		{
+				return EIDT_OFFSCREEN;
+		}
+
+	private:
+
+		video::CFrameCapture* Capture;
+	};
+
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_OFFSCREEN_DEVICE_
+#endif // __C_IRR_DEVICE_OFFSCREEN_H_INCLUDED__
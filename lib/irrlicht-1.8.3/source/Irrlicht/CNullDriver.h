@@ -250,6 +250,12 @@ namespace video
 		//! very useful method for statistics.
 		virtual u32 getPrimitiveCountDrawn( u32 param = 0 ) const;
 
+		//! returns the number of draw calls made since beginScene()
+		virtual u32 getDrawCallCount() const;
+
+		//! returns how often a changed material was applied since beginScene()
+		virtual u32 getMaterialChangeCount() const;
+
 		//! deletes all dynamic lights there are
 		virtual void deleteAllDynamicLights();
 
@@ -466,6 +472,9 @@ namespace video
 		actual value of pixels. */
 		virtual u32 getOcclusionQueryResult(scene::ISceneNode* node) const;
 
+		//! Test boxes for visibility against the depth buffer.
+		virtual void testOcclusionBoxes(const core::aabbox3df* boxes, u32 count, u32* samples);
+
 		//! Only used by the engine internally.
 		/** Used to notify the driver that the window was resized. */
 		virtual void OnResize(const core::dimension2d<u32>& size);
@@ -667,7 +676,7 @@ namespace video
 		void deleteAllTextures();
 
 		//! opens the file and loads it into the surface
-		video::ITexture* loadTextureFromFile(io::IReadFile* file, const io::path& hashName = "");
+		virtual video::ITexture* loadTextureFromFile(io::IReadFile* file, const io::path& hashName = "");
 
 		//! adds a surface, not loaded or created by the Irrlicht Engine
 		void addTexture(video::ITexture* surface);
@@ -817,6 +826,11 @@ namespace video
 		CFPSCounter FPSCounter;
 
 		u32 PrimitivesDrawn;
+		u32 DrawCalls;
+		u32 MaterialChanges;
+
+		//! last material set on the null driver, to count material changes
+		SMaterial CountedMaterial;
 		u32 MinVertexCountForVBO;
 
 		u32 TextureCreationFlags;
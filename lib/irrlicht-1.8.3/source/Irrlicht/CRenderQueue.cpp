@@ -0,0 +1,159 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CRenderQueue.h"
+#include "ISceneNode.h"
+#include "SMaterial.h"
+#include "irrMath.h"
+#include <string.h>
+
+namespace irr
+{
+namespace scene
+{
+
+// Layout of the keys, from the highest bit:
+// solid:       pass (3), material (45), depth (16)
+// transparent: pass (3), inverted depth (32), material (29)
+// material:    type (8), texture 0 (20), texture 1 (12), flags (5)
+
+namespace
+{
+	const u32 MATERIAL_BITS = 45;
+
+	//! returns the number of the pass, for the 3 pass bits of the keys
+	u64 getPassBits(E_SCENE_NODE_RENDER_PASS pass)
+	{
+		u64 n = 0;
+		for (u32 p = (u32)pass; p > 1; p >>= 1)
+			++n;
+		return n << 61;
+	}
+
+	//! returns bits of a texture pointer, equal textures get equal bits
+	/** Different textures may get the same bits, which only makes them
+	less likely to be drawn one after another. */
+	u32 getTextureBits(const video::ITexture* texture, u32 bits)
+	{
+		const u32 h = (u32)((size_t)texture / sizeof(void*)) * 2654435761u;
+		return texture ? (h >> (32 - bits)) : 0;
+	}
+}
+
+
+//! adds a node which uses solid material state
+void CRenderQueue::pushSolid(ISceneNode* node, const video::SMaterial* material,
+		E_SCENE_NODE_RENDER_PASS pass, const core::vector3df& camera)
+{
+	push(node, getPassBits(pass) |
+		(getMaterialKey(material) << 16) |
+		(getDepth(node, camera) >> 16));
+}
+
+
+//! adds a node which has to be drawn back to front
+void CRenderQueue::pushTransparent(ISceneNode* node, const video::SMaterial* material,
+		E_SCENE_NODE_RENDER_PASS pass, const core::vector3df& camera)
+{
+	push(node, getPassBits(pass) |
+		((u64)~getDepth(node, camera) << 29) |
+		(getMaterialKey(material) >> (MATERIAL_BITS - 29)));
+}
+
+
+void CRenderQueue::push(ISceneNode* node, u64 key)
+{
+	const u32 n = Entries.size();
+	// set_used() alone would reallocate for every node
+	if (Entries.allocated_size() == n)
+		Entries.reallocate(core::max_(2 * n, 64u));
+	Entries.set_used(n + 1);
+	Entries[n].Key = key;
+	Entries[n].Node = node;
+}
+
+
+//! returns the key bits of the material type, textures and flags
+u64 CRenderQueue::getMaterialKey(const video::SMaterial* material)
+{
+	if (!material)
+		return 0;
+
+	const u32 flags =
+		(material->Lighting ? 1 : 0) |
+		(material->ZWriteEnable ? 2 : 0) |
+		(material->BackfaceCulling ? 4 : 0) |
+		(material->FogEnable ? 8 : 0) |
+		(material->Wireframe ? 16 : 0);
+
+	return ((u64)core::min_((u32)material->MaterialType, 255u) << 37) |
+		((u64)getTextureBits(material->getTexture(0), 20) << 17) |
+		((u64)getTextureBits(material->getTexture(1), 12) << 5) |
+		flags;
+}
+
+
+//! returns the squared distance of a node to the camera as ordered bits
+u32 CRenderQueue::getDepth(const ISceneNode* node, const core::vector3df& camera)
+{
+	// the bits of a positive float sort like the float
+	const f32 distance = (f32)node->getAbsoluteTransformation().getTranslation().getDistanceFromSQ(camera);
+	return IR(distance);
+}
+
+
+//! sorts the nodes by their keys, keeping the order of equal keys
+void CRenderQueue::sort()
+{
+	const u32 n = Entries.size();
+	if (n < 2)
+		return;
+
+	// count all 8 digits of 8 bits in one pass
+	u32 count[8][256];
+	memset(count, 0, sizeof(count));
+	for (u32 i=0; i<n; ++i)
+	{
+		const u64 key = Entries[i].Key;
+		for (u32 d=0; d<8; ++d)
+			++count[d][(key >> (d * 8)) & 0xff];
+	}
+
+	if (Sorted.allocated_size() < n)
+		Sorted.reallocate(n);
+	Sorted.set_used(n);
+
+	SEntry* src = Entries.pointer();
+	SEntry* dst = Sorted.pointer();
+
+	for (u32 d=0; d<8; ++d)
+	{
+		const u32 shift = d * 8;
+
+		// a digit which is the same in all keys does not change the order
+		if (count[d][(src[0].Key >> shift) & 0xff] == n)
+			continue;
+
+		u32 offset[256];
+		u32 sum = 0;
+		for (u32 b=0; b<256; ++b)
+		{
+			offset[b] = sum;
+			sum += count[d][b];
+		}
+
+		for (u32 i=0; i<n; ++i)
+			dst[offset[(src[i].Key >> shift) & 0xff]++] = src[i];
+
+		core::swap(src, dst);
+	}
+
+	if (src != Entries.pointer())
+		memcpy(Entries.pointer(), src, n * sizeof(SEntry));
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,80 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_RENDER_QUEUE_H_INCLUDED__
+#define __C_RENDER_QUEUE_H_INCLUDED__
+
+#include "irrArray.h"
+#include "vector3d.h"
+#include "ISceneManager.h"
+
+namespace irr
+{
+namespace video
+{
+	struct SMaterial;
+} // end namespace video
+
+namespace scene
+{
+	class ISceneNode;
+
+	//! Scene nodes of one render pass, sorted by a 64 bit key.
+	/** The key packs the pass, the material type, the textures, a few
+	material flags and the depth of a node. Solid nodes are ordered by
+	material state first and front to back last, so nodes with equal
+	materials are drawn one after another and the driver does not have to
+	change its states between them. Transparent nodes are ordered back to
+	front first and by material state only at equal depth.
+	The keys are sorted with a stable radix sort. */
+	class CRenderQueue
+	{
+	public:
+
+		//! adds a node which uses solid material state
+		/** \param material The first material of the node, or 0. */
+		void pushSolid(ISceneNode* node, const video::SMaterial* material,
+			E_SCENE_NODE_RENDER_PASS pass, const core::vector3df& camera);
+
+		//! adds a node which has to be drawn back to front
+		/** \param material The transparent material of the node, or 0. */
+		void pushTransparent(ISceneNode* node, const video::SMaterial* material,
+			E_SCENE_NODE_RENDER_PASS pass, const core::vector3df& camera);
+
+		//! sorts the nodes by their keys, keeping the order of equal keys
+		void sort();
+
+		//! removes all nodes, keeping the memory
+		void clear() { Entries.set_used(0); }
+
+		u32 size() const { return Entries.size(); }
+		bool empty() const { return Entries.empty(); }
+
+		ISceneNode* operator [](u32 i) const { return Entries[i].Node; }
+
+	private:
+
+		struct SEntry
+		{
+			u64 Key;
+			ISceneNode* Node;
+		};
+
+		//! returns the key bits of the material type, textures and flags
+		static u64 getMaterialKey(const video::SMaterial* material);
+
+		//! returns the squared distance of a node to the camera as ordered bits
+		static u32 getDepth(const ISceneNode* node, const core::vector3df& camera);
+
+		void push(ISceneNode* node, u64 key);
+
+		core::array<SEntry> Entries;
+		core::array<SEntry> Sorted;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -140,6 +140,7 @@
 #include "CLightSceneNode.h"
 #include "CBillboardSceneNode.h"
 #include "CMeshSceneNode.h"
+#include "CInstancedMeshSceneNode.h"
 #include "CSkyBoxSceneNode.h"
 #include "CSkyDomeSceneNode.h"
 #include "CParticleSystemSceneNode.h"
@@ -178,6 +179,131 @@ namespace irr
 namespace scene
 {
 
+namespace
+{
+	//! nodes which use data shared with other nodes in OnAnimate()
+	bool hasSharedAnimationState(ESCENE_NODE_TYPE type)
+	{
+		switch (type)
+		{
+		case ESNT_ANIMATED_MESH:	// the frames of the mesh
+		case ESNT_MD3_SCENE_NODE:
+		case ESNT_WATER_SURFACE:	// the vertices of the mesh
+		case ESNT_TEXT:			// the active camera
+		case ESNT_CAMERA:
+		case ESNT_CAMERA_FPS:
+		case ESNT_CAMERA_MAYA:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	//! animators which use data shared with other nodes
+	bool hasSharedAnimationState(ESCENE_NODE_ANIMATOR_TYPE type)
+	{
+		// the cursor, or the triangles of other nodes
+		return type == ESNAT_CAMERA_FPS || type == ESNAT_CAMERA_MAYA ||
+			type == ESNAT_COLLISION_RESPONSE;
+	}
+
+	//! nodes which do not override ISceneNode::OnAnimate()
+	bool hasDefaultAnimation(ESCENE_NODE_TYPE type)
+	{
+		switch (type)
+		{
+		case ESNT_EMPTY:
+		case ESNT_DUMMY_TRANSFORMATION:
+		case ESNT_CUBE:
+		case ESNT_SPHERE:
+		case ESNT_MESH:
+		case ESNT_OCTREE:
+		case ESNT_INSTANCED_MESH:
+		case ESNT_BILLBOARD:
+		case ESNT_LIGHT:
+		case ESNT_PARTICLE_SYSTEM:
+		case ESNT_TERRAIN:
+		case ESNT_SKY_BOX:
+		case ESNT_SKY_DOME:
+		case ESNT_SHADOW_VOLUME:
+		case ESNT_VOLUME_LIGHT:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool hasSharedAnimators(const ISceneNode* node)
+	{
+		const ISceneNodeAnimatorList& list = node->getAnimators();
+		ISceneNodeAnimatorList::ConstIterator it = list.begin();
+		for (; it != list.end(); ++it)
+			if (hasSharedAnimationState((*it)->getType()))
+				return true;
+		return false;
+	}
+
+	//! returns if OnAnimate() of a subtree may run in parallel to other subtrees
+	bool canAnimateInParallel(const ISceneNode* node)
+	{
+		// OnAnimate() does nothing for invisible nodes
+		if (!node->isVisible())
+			return true;
+
+		if (hasSharedAnimationState(node->getType()) || hasSharedAnimators(node))
+			return false;
+
+		const ISceneNodeList& list = node->getChildren();
+		ISceneNodeList::ConstIterator it = list.begin();
+		for (; it != list.end(); ++it)
+			if (!canAnimateInParallel(*it))
+				return false;
+		return true;
+	}
+
+	//! does what ISceneNode::OnAnimate() does for a visible node, without the children
+	void animateWithoutChildren(ISceneNode* node, u32 timeMs)
+	{
+		const ISceneNodeAnimatorList& list = node->getAnimators();
+		ISceneNodeAnimatorList::ConstIterator it = list.begin();
+		while (it != list.end())
+		{
+			// the animator may remove itself
+			ISceneNodeAnimator* anim = *it;
+			++it;
+			anim->animateNode(node, timeMs);
+		}
+
+		node->updateAbsolutePosition();
+	}
+
+	//! animates the subtrees which can be animated in parallel
+	class CAnimationJob : public CThreadPool::IJob
+	{
+	public:
+
+		CAnimationJob(ISceneNode* const* tasks, u8* parallel, u32 timeMs)
+			: Tasks(tasks), Parallel(parallel), TimeMs(timeMs) {}
+
+		virtual void run(u32 index, u32 thread)
+		{
+			Parallel[index] = canAnimateInParallel(Tasks[index]);
+			if (Parallel[index])
+				Tasks[index]->OnAnimate(TimeMs);
+		}
+
+	private:
+
+		ISceneNode* const* Tasks;
+		u8* Parallel;
+		u32 TimeMs;
+	};
+
+	//! the scene is split into about this many subtrees, for any number of threads
+	const u32 ANIMATION_TASK_COUNT = 64;
+}
+
+
 //! constructor
 CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 		gui::ICursorControl* cursorControl, IMeshCache* cache,
@@ -185,8 +311,10 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 : ISceneNode(0, 0), Driver(driver), FileSystem(fs), GUIEnvironment(gui),
 	CursorControl(cursorControl), CollisionManager(0),
 	ActiveCamera(0), ShadowColor(150,0,0,0), AmbientLight(0,0,0,0),
-	MeshCache(cache), CurrentRendertime(ESNRP_NONE), LightManager(0),
-	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type")
+	SceneParametersID(0), MeshCache(cache), CurrentRendertime(ESNRP_NONE), LightManager(0),
+	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type"),
+	SceneNodeIndexEnabled(false), CullingHierarchyEnabled(false),
+	AnimatingInParallel(false)
 {
 	#ifdef _DEBUG
 	ISceneManager::setDebugName("CSceneManager ISceneManager");
@@ -363,6 +491,8 @@ CSceneManager::~CSceneManager()
 	// remove all nodes and animators before dropping the driver
 	// as render targets may be destroyed twice
 
+	setSceneNodeIndexEnabled(false);
+	setCullingHierarchyEnabled(false);
 	removeAll();
 	removeAnimators();
 
@@ -610,6 +740,25 @@ IMeshSceneNode* CSceneManager::addMeshSceneNode(IMesh* mesh, ISceneNode* parent,
 }
 
 
+//! adds a scene node drawing many instances of a static mesh
+//! the returned pointer must not be dropped.
+IInstancedMeshSceneNode* CSceneManager::addInstancedMeshSceneNode(IMesh* mesh, ISceneNode* parent, s32 id,
+	const core::vector3df& position, const core::vector3df& rotation,
+	const core::vector3df& scale)
+{
+	if (!mesh)
+		return 0;
+
+	if (!parent)
+		parent = this;
+
+	IInstancedMeshSceneNode* node = new CInstancedMeshSceneNode(mesh, parent, this, id, position, rotation, scale);
+	node->drop();
+
+	return node;
+}
+
+
 //! Adds a scene node for rendering a animated water surface mesh.
 ISceneNode* CSceneManager::addWaterSurfaceSceneNode(IMesh* mesh, f32 waveHeight, f32 waveSpeed, f32 waveLength,
 	ISceneNode* parent, s32 id, const core::vector3df& position,
@@ -1135,6 +1284,192 @@ void CSceneManager::setActiveCamera(ICameraSceneNode* camera)
 		ActiveCamera->drop();
 
 	ActiveCamera = camera;
+	CullingHierarchy.invalidate();
+}
+
+
+//! animates the scene, on several threads if enabled
+void CSceneManager::OnAnimate(u32 timeMs)
+{
+	if (AnimationThreads.getThreadCount() > 1 && !AnimatingInParallel)
+		animateInParallel(timeMs);
+	else
+		ISceneNode::OnAnimate(timeMs);
+}
+
+
+//! animates subtrees of the scene on the threads of AnimationThreads
+void CSceneManager::animateInParallel(u32 timeMs)
+{
+	if (!IsVisible)
+		return;
+
+	// changes made while splitting belong to no task yet, so they are
+	// made first
+	AnimationTaskIndex.set_used(0);
+	AnimatingInParallel = true;
+	animateWithoutChildren(this, timeMs);
+
+	// split nodes below the root until there are enough subtrees,
+	// animating the split nodes first
+	AnimationTasks.set_used(0);
+	ISceneNodeList::Iterator it = Children.begin();
+	for (; it != Children.end(); ++it)
+		AnimationTasks.push_back(*it);
+
+	core::array<ISceneNode*> tasks;
+	bool split = true;
+	while (split && AnimationTasks.size() < ANIMATION_TASK_COUNT)
+	{
+		split = false;
+		tasks.set_used(0);
+		for (u32 i=0; i<AnimationTasks.size(); ++i)
+		{
+			ISceneNode* node = AnimationTasks[i];
+			if (!node->isVisible() || node->getChildren().empty() ||
+				!hasDefaultAnimation(node->getType()) || hasSharedAnimators(node))
+			{
+				tasks.push_back(node);
+				continue;
+			}
+
+			animateWithoutChildren(node, timeMs);
+			const ISceneNodeList& list = node->getChildren();
+			ISceneNodeList::ConstIterator child = list.begin();
+			for (; child != list.end(); ++child)
+				tasks.push_back(*child);
+			split = true;
+		}
+		AnimationTasks.swap(tasks);
+	}
+
+	const u32 count = AnimationTasks.size();
+	AnimationTaskIndex.set_used(count);
+	for (u32 i=0; i<count; ++i)
+	{
+		AnimationTaskIndex[i].Node = AnimationTasks[i];
+		AnimationTaskIndex[i].Index = i;
+	}
+	AnimationTaskIndex.sort();
+	AnimationTaskParallel.set_used(count);
+
+	CAnimationJob job(AnimationTasks.const_pointer(), AnimationTaskParallel.pointer(), timeMs);
+	AnimationThreads.run(job, count);
+
+	for (u32 i=0; i<count; ++i)
+		if (!AnimationTaskParallel[i])
+			AnimationTasks[i]->OnAnimate(timeMs);
+
+	AnimatingInParallel = false;
+	applySceneChanges();
+}
+
+
+//! Delays changes of the scene graph while the scene is animated on several threads.
+bool CSceneManager::OnSceneNodeChanging(ISceneNode* parent, ISceneNode* child, bool add)
+{
+	if (!AnimatingInParallel)
+		return false;
+
+	deferSceneChange(parent, child, add ? ESC_ADD_CHILD : (child ? ESC_REMOVE_CHILD : ESC_REMOVE_ALL));
+	return true;
+}
+
+
+//! remembers a change of the scene graph made while animating in parallel
+void CSceneManager::deferSceneChange(ISceneNode* node, ISceneNode* child, E_SCENE_CHANGE type)
+{
+	SSceneChange change;
+	change.Node = node;
+	change.Child = child;
+	change.Type = type;
+	change.Task = 0;
+
+	// the graph does not change until all tasks are done, so the task
+	// of a node is the first of its parents which is a task
+	const core::array<SAnimationTask>& index = AnimationTaskIndex;
+	SAnimationTask key;
+	for (key.Node = node; key.Node; key.Node = key.Node->getParent())
+	{
+		const s32 i = index.binary_search(key);
+		if (i != -1)
+		{
+			change.Task = index[i].Index + 1;
+			break;
+		}
+	}
+
+	AnimationThreads.lock();
+	node->grab();
+	if (child)
+		child->grab();
+	SceneChanges.push_back(change);
+	AnimationThreads.unlock();
+}
+
+
+//! makes the changes remembered while animating in parallel
+void CSceneManager::applySceneChanges()
+{
+	const u32 count = SceneChanges.size();
+	if (!count)
+		return;
+
+	// sort by task, keeping the order of each task
+	core::array<u32> first;
+	first.set_used(AnimationTasks.size() + 2);
+	for (u32 i=0; i<first.size(); ++i)
+		first[i] = 0;
+	for (u32 i=0; i<count; ++i)
+	{
+		_IRR_DEBUG_BREAK_IF(SceneChanges[i].Task > AnimationTasks.size())
+		if (SceneChanges[i].Task > AnimationTasks.size())
+			SceneChanges[i].Task = 0;
+		++first[SceneChanges[i].Task + 1];
+	}
+	for (u32 i=1; i<first.size(); ++i)
+		first[i] += first[i-1];
+
+	core::array<SSceneChange> changes;
+	changes.set_used(count);
+	for (u32 i=0; i<count; ++i)
+		changes[first[SceneChanges[i].Task]++] = SceneChanges[i];
+	SceneChanges.set_used(0);
+
+	for (u32 i=0; i<count; ++i)
+	{
+		const SSceneChange& change = changes[i];
+		switch (change.Type)
+		{
+		case ESC_ADD_CHILD:
+			change.Node->addChild(change.Child);
+			break;
+		case ESC_REMOVE_CHILD:
+			change.Node->removeChild(change.Child);
+			break;
+		case ESC_REMOVE_ALL:
+			change.Node->removeAll();
+			break;
+		case ESC_DELETE:
+			// keeps the grab of the deletion queue
+			DeletionList.push_back(change.Node);
+			continue;
+		case ESC_NODE_CHANGED:
+			OnSceneNodeChanged(change.Node, false);
+			break;
+		}
+
+		if (change.Child)
+			change.Child->drop();
+		change.Node->drop();
+	}
+}
+
+
+//! Sets the number of threads which animate the scene in drawAll().
+void CSceneManager::setAnimationThreadCount(u32 count)
+{
+	AnimationThreads.setThreadCount(count);
 }
 
 
@@ -1171,12 +1506,23 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 		result = (Driver->getOcclusionQueryResult(const_cast<ISceneNode*>(node))==0);
 	}
 
+	// tested by the culling hierarchy in drawAll() ?
+	u32 state = 0;
+	const bool hierarchy = !result && CullingHierarchyEnabled &&
+		(node->getAutomaticCulling() & (scene::EAC_BOX | scene::EAC_FRUSTUM_BOX)) &&
+		CullingHierarchy.getCullState(node, state);
+
 	// can be seen by a bounding box ?
 	if (!result && (node->getAutomaticCulling() & scene::EAC_BOX))
 	{
-		core::aabbox3d<f32> tbox = node->getBoundingBox();
-		node->getAbsoluteTransformation().transformBoxEx(tbox);
-		result = !(tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox() ));
+		if (hierarchy)
+			result = (state & CSceneNodeBVH::ECS_BOX_CULLED) != 0;
+		else
+		{
+			core::aabbox3d<f32> tbox = node->getBoundingBox();
+			node->getAbsoluteTransformation().transformBoxEx(tbox);
+			result = !(tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox() ));
+		}
 	}
 
 	// can be seen by a bounding sphere
@@ -1184,8 +1530,13 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 	{ // requires bbox diameter
 	}
 
+	if (!result && hierarchy && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX) &&
+		!(state & CSceneNodeBVH::ECS_FRUSTUM_UNKNOWN))
+	{
+		result = (state & CSceneNodeBVH::ECS_FRUSTUM_CULLED) != 0;
+	}
 	// can be seen by cam pyramid planes ?
-	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX))
+	else if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX))
 	{
 		SViewFrustum frust = *cam->getViewFrustum();
 
@@ -1265,21 +1616,24 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 	case ESNRP_SOLID:
 		if (!isCulled(node))
 		{
-			SolidNodeList.push_back(node);
+			SolidNodeList.pushSolid(node, node->getMaterialCount() ? &node->getMaterial(0) : 0,
+				ESNRP_SOLID, camWorldPos);
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT:
 		if (!isCulled(node))
 		{
-			TransparentNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
+			TransparentNodeList.pushTransparent(node, node->getMaterialCount() ? &node->getMaterial(0) : 0,
+				ESNRP_TRANSPARENT, camWorldPos);
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT_EFFECT:
 		if (!isCulled(node))
 		{
-			TransparentEffectNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
+			TransparentEffectNodeList.pushTransparent(node, node->getMaterialCount() ? &node->getMaterial(0) : 0,
+				ESNRP_TRANSPARENT_EFFECT, camWorldPos);
 			taken = 1;
 		}
 		break;
@@ -1291,13 +1645,13 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 			taken = 0;
 			for (u32 i=0; i<count; ++i)
 			{
+				const video::SMaterial& material = node->getMaterial(i);
 				video::IMaterialRenderer* rnd =
-					Driver->getMaterialRenderer(node->getMaterial(i).MaterialType);
+					Driver->getMaterialRenderer(material.MaterialType);
 				if (rnd && rnd->isTransparent())
 				{
 					// register as transparent node
-					TransparentNodeEntry e(node, camWorldPos);
-					TransparentNodeList.push_back(e);
+					TransparentNodeList.pushTransparent(node, &material, ESNRP_TRANSPARENT, camWorldPos);
 					taken = 1;
 					break;
 				}
@@ -1306,7 +1660,8 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 			// not transparent, register as solid
 			if (!taken)
 			{
-				SolidNodeList.push_back(node);
+				SolidNodeList.pushSolid(node, count ? &node->getMaterial(0) : 0,
+					ESNRP_SOLID, camWorldPos);
 				taken = 1;
 			}
 		}
@@ -1323,16 +1678,9 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		break;
 	}
 
-#ifdef _IRR_SCENEMANAGER_DEBUG
-	s32 index = Parameters.findAttribute ( "calls" );
-	Parameters.setAttribute ( index, Parameters.getAttributeAsInt ( index ) + 1 );
-
+	++SceneStatistics.Registered;
 	if (!taken)
-	{
-		index = Parameters.findAttribute ( "culled" );
-		Parameters.setAttribute ( index, Parameters.getAttributeAsInt ( index ) + 1 );
-	}
-#endif
+		++SceneStatistics.Culled;
 
 	return taken;
 }
@@ -1345,14 +1693,10 @@ void CSceneManager::drawAll()
 	if (!Driver)
 		return;
 
-#ifdef _IRR_SCENEMANAGER_DEBUG
-	// reset attributes
-	Parameters.setAttribute ( "culled", 0 );
-	Parameters.setAttribute ( "calls", 0 );
-	Parameters.setAttribute ( "drawn_solid", 0 );
-	Parameters.setAttribute ( "drawn_transparent", 0 );
-	Parameters.setAttribute ( "drawn_transparent_effect", 0 );
-#endif
+	const u32 startTime = os::Timer::getRealTimeMicroseconds();
+	SceneStatistics.reset();
+	const u32 drawCalls = Driver->getDrawCallCount();
+	const u32 materialChanges = Driver->getMaterialChangeCount();
 
 	u32 i; // new ISO for scoping problem in some compilers
 
@@ -1364,8 +1708,7 @@ void CSceneManager::drawAll()
 	for (i=video::ETS_COUNT-1; i>=video::ETS_TEXTURE_0; --i)
 		Driver->setTransform ( (video::E_TRANSFORMATION_STATE)i, core::IdentityMatrix );
 
-	// TODO: This should not use an attribute here but a real parameter when necessary (too slow!)
-	Driver->setAllowZWriteOnTransparent(Parameters.getAttributeAsBool( ALLOW_ZWRITE_ON_TRANSPARENT) );
+	Driver->setAllowZWriteOnTransparent(getSceneParameters().AllowZWriteOnTransparent);
 
 	// do animations and other stuff.
 	OnAnimate(os::Timer::getTime());
@@ -1379,6 +1722,13 @@ void CSceneManager::drawAll()
 	{
 		ActiveCamera->render();
 		camWorldPos = ActiveCamera->getAbsolutePosition();
+
+		if (CullingHierarchyEnabled)
+		{
+			const u32 cullTime = os::Timer::getRealTimeMicroseconds();
+			CullingHierarchy.cull(*ActiveCamera->getViewFrustum());
+			SceneStatistics.CullTime = os::Timer::getRealTimeMicroseconds() - cullTime;
+		}
 	}
 
 	// let all nodes register themselves
@@ -1482,14 +1832,14 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_SOLID;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		SolidNodeList.sort(); // sort by textures
+		sortRenderQueue(SolidNodeList); // sort by material state
 
 		if (LightManager)
 		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
 			for (i=0; i<SolidNodeList.size(); ++i)
 			{
-				ISceneNode* node = SolidNodeList[i].Node;
+				ISceneNode* node = SolidNodeList[i];
 				LightManager->OnNodePreRender(node);
 				node->render();
 				LightManager->OnNodePostRender(node);
@@ -1498,13 +1848,11 @@ void CSceneManager::drawAll()
 		else
 		{
 			for (i=0; i<SolidNodeList.size(); ++i)
-				SolidNodeList[i].Node->render();
+				SolidNodeList[i]->render();
 		}
 
-#ifdef _IRR_SCENEMANAGER_DEBUG
-		Parameters.setAttribute("drawn_solid", (s32) SolidNodeList.size() );
-#endif
-		SolidNodeList.set_used(0);
+		SceneStatistics.DrawnSolid = SolidNodeList.size();
+		SolidNodeList.clear();
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
@@ -1547,14 +1895,14 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_TRANSPARENT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		TransparentNodeList.sort(); // sort by distance from camera
+		sortRenderQueue(TransparentNodeList); // sort by distance from camera
 		if (LightManager)
 		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
 
 			for (i=0; i<TransparentNodeList.size(); ++i)
 			{
-				ISceneNode* node = TransparentNodeList[i].Node;
+				ISceneNode* node = TransparentNodeList[i];
 				LightManager->OnNodePreRender(node);
 				node->render();
 				LightManager->OnNodePostRender(node);
@@ -1563,13 +1911,11 @@ void CSceneManager::drawAll()
 		else
 		{
 			for (i=0; i<TransparentNodeList.size(); ++i)
-				TransparentNodeList[i].Node->render();
+				TransparentNodeList[i]->render();
 		}
 
-#ifdef _IRR_SCENEMANAGER_DEBUG
-		Parameters.setAttribute ( "drawn_transparent", (s32) TransparentNodeList.size() );
-#endif
-		TransparentNodeList.set_used(0);
+		SceneStatistics.DrawnTransparent = TransparentNodeList.size();
+		TransparentNodeList.clear();
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
@@ -1580,7 +1926,7 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_TRANSPARENT_EFFECT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		TransparentEffectNodeList.sort(); // sort by distance from camera
+		sortRenderQueue(TransparentEffectNodeList); // sort by distance from camera
 
 		if (LightManager)
 		{
@@ -1588,7 +1934,7 @@ void CSceneManager::drawAll()
 
 			for (i=0; i<TransparentEffectNodeList.size(); ++i)
 			{
-				ISceneNode* node = TransparentEffectNodeList[i].Node;
+				ISceneNode* node = TransparentEffectNodeList[i];
 				LightManager->OnNodePreRender(node);
 				node->render();
 				LightManager->OnNodePostRender(node);
@@ -1597,12 +1943,10 @@ void CSceneManager::drawAll()
 		else
 		{
 			for (i=0; i<TransparentEffectNodeList.size(); ++i)
-				TransparentEffectNodeList[i].Node->render();
+				TransparentEffectNodeList[i]->render();
 		}
-#ifdef _IRR_SCENEMANAGER_DEBUG
-		Parameters.setAttribute ( "drawn_transparent_effect", (s32) TransparentEffectNodeList.size() );
-#endif
-		TransparentEffectNodeList.set_used(0);
+		SceneStatistics.DrawnTransparentEffect = TransparentEffectNodeList.size();
+		TransparentEffectNodeList.clear();
 	}
 
 	if (LightManager)
@@ -1611,9 +1955,25 @@ void CSceneManager::drawAll()
 	LightList.set_used(0);
 	clearDeletionList();
 
+	// the results are only valid while the nodes are registered
+	CullingHierarchy.invalidate();
+
+	SceneStatistics.DrawCalls = Driver->getDrawCallCount() - drawCalls;
+	SceneStatistics.StateChanges = Driver->getMaterialChangeCount() - materialChanges;
+	SceneStatistics.DrawTime = os::Timer::getRealTimeMicroseconds() - startTime;
+
 	CurrentRendertime = ESNRP_NONE;
 }
 
+//! sorts a render pass and adds the time it took to the statistics
+void CSceneManager::sortRenderQueue(CRenderQueue& queue)
+{
+	const u32 startTime = os::Timer::getRealTimeMicroseconds();
+	queue.sort();
+	SceneStatistics.SortTime += os::Timer::getRealTimeMicroseconds() - startTime;
+}
+
+
 void CSceneManager::setLightManager(ILightManager* lightManager)
 {
     if (lightManager)
@@ -1859,6 +2219,12 @@ void CSceneManager::addToDeletionQueue(ISceneNode* node)
 	if (!node)
 		return;
 
+	if (AnimatingInParallel)
+	{
+		deferSceneChange(node, 0, ESC_DELETE);
+		return;
+	}
+
 	node->grab();
 	DeletionList.push_back(node);
 }
@@ -1880,12 +2246,102 @@ void CSceneManager::clearDeletionList()
 }
 
 
+//! Enables or disables the index of scene node names and ids.
+void CSceneManager::setSceneNodeIndexEnabled(bool enable)
+{
+	SceneNodeIndex.clear();
+	SceneNodeIndexEnabled = enable;
+
+	if (enable)
+		updateSceneNodeIndex(this, true, true);
+}
+
+
+//! Enables or disables the bounding volume hierarchy used for culling.
+void CSceneManager::setCullingHierarchyEnabled(bool enable)
+{
+	CullingHierarchy.clear();
+	CullingHierarchyEnabled = enable;
+
+	if (enable)
+		updateCullingHierarchy(this, true);
+}
+
+
+//! Updates the index of scene node names and ids and the culling hierarchy.
+void CSceneManager::OnSceneNodeChanged(ISceneNode* node, bool recursive)
+{
+	if (!SceneNodeIndexEnabled && !CullingHierarchyEnabled)
+		return;
+
+	if (AnimatingInParallel)
+	{
+		deferSceneChange(node, 0, ESC_NODE_CHANGED);
+		return;
+	}
+
+	// removed nodes are told about after they left their parent
+	const ISceneNode* root = node;
+	while (root->getParent())
+		root = root->getParent();
+
+	if (SceneNodeIndexEnabled)
+		updateSceneNodeIndex(node, root == this, recursive);
+
+	// only added and removed nodes change the hierarchy
+	if (CullingHierarchyEnabled && recursive)
+		updateCullingHierarchy(node, root == this);
+}
+
+
+//! adds, updates or removes the index entries of a node
+void CSceneManager::updateSceneNodeIndex(ISceneNode* node, bool inScene, bool recursive)
+{
+	SceneNodeIndex.update(node, inScene);
+
+	if (recursive)
+	{
+		const ISceneNodeList& list = node->getChildren();
+		ISceneNodeList::ConstIterator it = list.begin();
+		for (; it!=list.end(); ++it)
+			updateSceneNodeIndex(*it, inScene, true);
+	}
+}
+
+
+//! adds or removes a node and its children to or from the culling hierarchy
+void CSceneManager::updateCullingHierarchy(ISceneNode* node, bool inScene)
+{
+	if (node != this)
+	{
+		if (inScene)
+			CullingHierarchy.add(node);
+		else
+			CullingHierarchy.remove(node);
+	}
+
+	const ISceneNodeList& list = node->getChildren();
+	ISceneNodeList::ConstIterator it = list.begin();
+	for (; it!=list.end(); ++it)
+		updateCullingHierarchy(*it, inScene);
+}
+
+
 //! Returns the first scene node with the specified name.
 ISceneNode* CSceneManager::getSceneNodeFromName(const char* name, ISceneNode* start)
 {
 	if (start == 0)
 		start = getRootSceneNode();
 
+	if (SceneNodeIndexEnabled && start == this)
+	{
+		// shared names are searched for below, to find the first node
+		bool shared;
+		ISceneNode* node = SceneNodeIndex.findByName(name, shared);
+		if (!shared)
+			return node;
+	}
+
 	if (!strcmp(start->getName(),name))
 		return start;
 
@@ -1910,6 +2366,15 @@ ISceneNode* CSceneManager::getSceneNodeFromId(s32 id, ISceneNode* start)
 	if (start == 0)
 		start = getRootSceneNode();
 
+	if (SceneNodeIndexEnabled && start == this)
+	{
+		// shared ids are searched for below, to find the first node
+		bool shared;
+		ISceneNode* node = SceneNodeIndex.findById(id, shared);
+		if (!shared)
+			return node;
+	}
+
 	if (start->getID() == id)
 		return start;
 
@@ -2000,6 +2465,9 @@ void CSceneManager::removeAll()
 void CSceneManager::clear()
 {
 	removeAll();
+
+	// free the shared primitive meshes no remaining node uses
+	GeometryCreator->removeUnusedSharedMeshes();
 }
 
 
@@ -2010,6 +2478,33 @@ io::IAttributes* CSceneManager::getParameters()
 }
 
 
+//! Returns typed copies of the parameters used while rendering.
+const SSceneParameters& CSceneManager::getSceneParameters()
+{
+	if (SceneParametersID != Parameters.getChangedID())
+		updateSceneParameters();
+	return SceneParameters;
+}
+
+
+//! copies the parameters used while rendering into SceneParameters
+void CSceneManager::updateSceneParameters()
+{
+	SceneParameters.DebugNormalLength = Parameters.getAttributeAsFloat(DEBUG_NORMAL_LENGTH);
+	SceneParameters.DebugNormalColor = Parameters.getAttributeAsColor(DEBUG_NORMAL_COLOR);
+	SceneParameters.AllowZWriteOnTransparent = Parameters.getAttributeAsBool(ALLOW_ZWRITE_ON_TRANSPARENT);
+	SceneParameters.IsEditor = Parameters.getAttributeAsBool(IRR_SCENE_MANAGER_IS_EDITOR);
+	SceneParametersID = Parameters.getChangedID();
+}
+
+
+//! Returns the counters of the last drawAll() call.
+const SSceneStatistics& CSceneManager::getSceneStatistics() const
+{
+	return SceneStatistics;
+}
+
+
 //! Returns current render pass.
 E_SCENE_NODE_RENDER_PASS CSceneManager::getSceneNodeRenderPass() const
 {
@@ -2409,8 +2904,8 @@ void CSceneManager::serializeAttributes(io::IAttributes* out, io::SAttributeRead
 //! Reads attributes of the scene node.
 void CSceneManager::deserializeAttributes(io::IAttributes* in, io::SAttributeReadWriteOptions* options)
 {
-	Name = in->getAttributeAsString("Name");
-	ID = in->getAttributeAsInt("Id");
+	setName(in->getAttributeAsString("Name"));
+	setID(in->getAttributeAsInt("Id"));
 	AmbientLight = in->getAttributeAsColorf("AmbientLight");
 
 	// fog attributes
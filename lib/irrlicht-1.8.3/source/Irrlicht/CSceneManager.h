@@ -13,6 +13,10 @@
 #include "IMeshLoader.h"
 #include "CAttributes.h"
 #include "ILightManager.h"
+#include "CSceneNodeIndex.h"
+#include "CRenderQueue.h"
+#include "CSceneNodeBVH.h"
+#include "CThreadPool.h"
 
 namespace irr
 {
@@ -95,12 +99,22 @@ namespace scene
 			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f),
 			bool alsoAddIfMeshPointerZero=false);
 
+		//! adds a scene node drawing many instances of a static mesh
+		//! the returned pointer must not be dropped.
+		virtual IInstancedMeshSceneNode* addInstancedMeshSceneNode(IMesh* mesh, ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0,0,0),
+			const core::vector3df& rotation = core::vector3df(0,0,0),
+			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f));
+
 		//! Adds a scene node for rendering a animated water surface mesh.
 		virtual ISceneNode* addWaterSurfaceSceneNode(IMesh* mesh, f32 waveHeight, f32 waveSpeed, f32 wlenght, ISceneNode* parent=0, s32 id=-1,
 			const core::vector3df& position = core::vector3df(0,0,0),
 			const core::vector3df& rotation = core::vector3df(0,0,0),
 			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f));
 
+		//! animates the scene, on several threads if enabled
+		virtual void OnAnimate(u32 timeMs);
+
 		//! renders the node.
 		virtual void render();
 
@@ -407,6 +421,30 @@ namespace scene
 		//! Returns the first scene node with the specified name.
 		virtual ISceneNode* getSceneNodeFromName(const c8* name, ISceneNode* start=0);
 
+		//! Enables or disables the index of scene node names and ids.
+		virtual void setSceneNodeIndexEnabled(bool enable);
+
+		//! Check if the index of scene node names and ids is enabled.
+		virtual bool isSceneNodeIndexEnabled() const { return SceneNodeIndexEnabled; }
+
+		//! Enables or disables the bounding volume hierarchy used for culling.
+		virtual void setCullingHierarchyEnabled(bool enable);
+
+		//! Check if the bounding volume hierarchy used for culling is enabled.
+		virtual bool isCullingHierarchyEnabled() const { return CullingHierarchyEnabled; }
+
+		//! Updates the index of scene node names and ids and the culling hierarchy.
+		virtual void OnSceneNodeChanged(ISceneNode* node, bool recursive);
+
+		//! Delays changes of the scene graph while the scene is animated on several threads.
+		virtual bool OnSceneNodeChanging(ISceneNode* parent, ISceneNode* child, bool add);
+
+		//! Sets the number of threads which animate the scene in drawAll().
+		virtual void setAnimationThreadCount(u32 count);
+
+		//! Get the number of threads which animate the scene in drawAll().
+		virtual u32 getAnimationThreadCount() const { return AnimationThreads.getThreadCount(); }
+
 		//! Returns the first scene node with the specified type.
 		virtual ISceneNode* getSceneNodeFromType(scene::ESCENE_NODE_TYPE type, ISceneNode* start=0);
 
@@ -426,6 +464,12 @@ namespace scene
 		//! Returns interface to the parameters set in this scene.
 		virtual io::IAttributes* getParameters();
 
+		//! Returns typed copies of the parameters used while rendering.
+		virtual const SSceneParameters& getSceneParameters();
+
+		//! Returns the counters of the last drawAll() call.
+		virtual const SSceneStatistics& getSceneStatistics() const;
+
 		//! Returns current render pass.
 		virtual E_SCENE_NODE_RENDER_PASS getSceneNodeRenderPass() const;
 
@@ -526,46 +570,39 @@ namespace scene
 		//! clears the deletion list
 		void clearDeletionList();
 
-		//! writes a scene node
-		void writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer, const fschar_t* currentPath=0, bool init=false);
+		//! adds, updates or removes the index entries of a node
+		void updateSceneNodeIndex(ISceneNode* node, bool inScene, bool recursive);
 
-		struct DefaultNodeEntry
-		{
-			DefaultNodeEntry(ISceneNode* n) :
-				Node(n), TextureValue(0)
-			{
-				if (n->getMaterialCount())
-					TextureValue = (n->getMaterial(0).getTexture(0));
-			}
+		//! adds or removes a node and its children to or from the culling hierarchy
+		void updateCullingHierarchy(ISceneNode* node, bool inScene);
 
-			bool operator < (const DefaultNodeEntry& other) const
-			{
-				return (TextureValue < other.TextureValue);
-			}
+		//! animates subtrees of the scene on the threads of AnimationThreads
+		void animateInParallel(u32 timeMs);
 
-			ISceneNode* Node;
-			private:
-			void* TextureValue;
+		//! kinds of SSceneChange
+		enum E_SCENE_CHANGE
+		{
+			ESC_ADD_CHILD,
+			ESC_REMOVE_CHILD,
+			ESC_REMOVE_ALL,
+			ESC_DELETE,
+			ESC_NODE_CHANGED
 		};
 
-		//! sort on distance (center) to camera
-		struct TransparentNodeEntry
-		{
-			TransparentNodeEntry(ISceneNode* n, const core::vector3df& camera)
-				: Node(n)
-			{
-				Distance = Node->getAbsoluteTransformation().getTranslation().getDistanceFromSQ(camera);
-			}
+		//! remembers a change of the scene graph made while animating in parallel
+		void deferSceneChange(ISceneNode* node, ISceneNode* child, E_SCENE_CHANGE type);
 
-			bool operator < (const TransparentNodeEntry& other) const
-			{
-				return Distance > other.Distance;
-			}
+		//! makes the changes remembered while animating in parallel
+		void applySceneChanges();
 
-			ISceneNode* Node;
-			private:
-				f64 Distance;
-		};
+		//! copies the parameters used while rendering into SceneParameters
+		void updateSceneParameters();
+
+		//! sorts a render pass and adds the time it took to the statistics
+		void sortRenderQueue(CRenderQueue& queue);
+
+		//! writes a scene node
+		void writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer, const fschar_t* currentPath=0, bool init=false);
 
 		//! sort on distance (sphere) to camera
 		struct DistanceNodeEntry
@@ -613,9 +650,9 @@ namespace scene
 		core::array<ISceneNode*> LightList;
 		core::array<ISceneNode*> ShadowNodeList;
 		core::array<ISceneNode*> SkyBoxList;
-		core::array<DefaultNodeEntry> SolidNodeList;
-		core::array<TransparentNodeEntry> TransparentNodeList;
-		core::array<TransparentNodeEntry> TransparentEffectNodeList;
+		CRenderQueue SolidNodeList;
+		CRenderQueue TransparentNodeList;
+		CRenderQueue TransparentEffectNodeList;
 
 		core::array<IMeshLoader*> MeshLoaderList;
 		core::array<ISceneLoader*> SceneLoaderList;
@@ -634,6 +671,12 @@ namespace scene
 		// NODE: Attributes are slow and should only be used for debug-info and not in release
 		io::CAttributes Parameters;
 
+		//! typed copies of Parameters, valid while SceneParametersID matches
+		SSceneParameters SceneParameters;
+		u32 SceneParametersID;
+
+		SSceneStatistics SceneStatistics;
+
 		//! Mesh cache
 		IMeshCache* MeshCache;
 
@@ -650,6 +693,42 @@ namespace scene
 		const core::stringw IRR_XML_FORMAT_NODE_ATTR_TYPE;
 
 		IGeometryCreator* GeometryCreator;
+
+		//! index of scene node names and ids
+		CSceneNodeIndex SceneNodeIndex;
+		bool SceneNodeIndexEnabled;
+
+		//! bounding volume hierarchy over all nodes of the scene
+		CSceneNodeBVH CullingHierarchy;
+		bool CullingHierarchyEnabled;
+
+		//! A change of the scene graph made while animating in parallel
+		struct SSceneChange
+		{
+			ISceneNode* Node;
+			ISceneNode* Child;
+			E_SCENE_CHANGE Type;
+			//! 0 for changes made outside of the tasks, else task index + 1
+			u32 Task;
+		};
+
+		//! A root node of AnimationTasks, sorted by the node
+		struct SAnimationTask
+		{
+			bool operator<(const SAnimationTask& other) const { return Node < other.Node; }
+			bool operator==(const SAnimationTask& other) const { return Node == other.Node; }
+
+			ISceneNode* Node;
+			u32 Index;
+		};
+
+		CThreadPool AnimationThreads;
+		//! subtrees animated in parallel, and if they could be
+		core::array<ISceneNode*> AnimationTasks;
+		core::array<u8> AnimationTaskParallel;
+		core::array<SAnimationTask> AnimationTaskIndex;
+		core::array<SSceneChange> SceneChanges;
+		bool AnimatingInParallel;
 	};
 
 } // end namespace video
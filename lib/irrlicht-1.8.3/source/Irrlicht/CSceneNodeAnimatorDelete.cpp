@@ -30,7 +30,7 @@ void CSceneNodeAnimatorDelete::animateNode(ISceneNode* node, u32 timeMs)
 		if(node && SceneManager)
 		{
 			// don't delete if scene manager is attached to an editor
-			if (!SceneManager->getParameters()->getAttributeAsBool(IRR_SCENE_MANAGER_IS_EDITOR))
+			if (!SceneManager->getSceneParameters().IsEditor)
 				SceneManager->addToDeletionQueue(node);
 		}
 	}
@@ -0,0 +1,521 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CSceneNodeBVH.h"
+#include "ISceneNode.h"
+#include "SViewFrustum.h"
+
+namespace irr
+{
+namespace scene
+{
+
+namespace
+{
+	//! most scene nodes in a node of the hierarchy without children
+	const u32 BUCKET_SIZE = 4;
+
+	//! results of testing a box
+	enum E_BOX_RELATION
+	{
+		EBR_OUTSIDE,
+		EBR_INSIDE,
+		EBR_PARTIAL
+	};
+
+	//! tests an absolute box against a frustum plane
+	/** CSceneManager::isCulled() tests the corners of the node box in the
+	space of the node, where distances are scaled and rounded differently.
+	Boxes closer to the plane than a small margin are left to that test. */
+	E_BOX_RELATION classifyBox(const core::aabbox3d<f32>& box, const core::plane3d<f32>& plane)
+	{
+		const core::vector3df& n = plane.Normal;
+		const f32 margin = 0.0001f * (1.f + core::abs_(plane.D));
+
+		const core::vector3df back(n.X >= 0 ? box.MinEdge.X : box.MaxEdge.X,
+			n.Y >= 0 ? box.MinEdge.Y : box.MaxEdge.Y,
+			n.Z >= 0 ? box.MinEdge.Z : box.MaxEdge.Z);
+		if (n.dotProduct(back) + plane.D > margin)
+			return EBR_OUTSIDE;
+
+		const core::vector3df front(n.X >= 0 ? box.MaxEdge.X : box.MinEdge.X,
+			n.Y >= 0 ? box.MaxEdge.Y : box.MinEdge.Y,
+			n.Z >= 0 ? box.MaxEdge.Z : box.MinEdge.Z);
+		if (n.dotProduct(front) + plane.D < -margin)
+			return EBR_INSIDE;
+
+		return EBR_PARTIAL;
+	}
+
+	//! tests a box against the bounding box of the frustum, like EAC_BOX
+	E_BOX_RELATION classifyBox(const core::aabbox3d<f32>& box, const core::aabbox3d<f32>& frustumBox)
+	{
+		if (!box.intersectsWithBox(frustumBox))
+			return EBR_OUTSIDE;
+		return box.isFullInside(frustumBox) ? EBR_INSIDE : EBR_PARTIAL;
+	}
+
+	//! tests a box against the planes in mask, removing the ones it is inside of
+	E_BOX_RELATION classifyPlanes(const core::aabbox3d<f32>& box, const SViewFrustum& frustum, u32& mask)
+	{
+		for (u32 i=0; i<SViewFrustum::VF_PLANE_COUNT; ++i)
+		{
+			if (!(mask & (1 << i)))
+				continue;
+
+			const E_BOX_RELATION r = classifyBox(box, frustum.planes[i]);
+			if (r == EBR_OUTSIDE)
+				return EBR_OUTSIDE;
+			if (r == EBR_INSIDE)
+				mask &= ~(1 << i);
+		}
+		return mask ? EBR_PARTIAL : EBR_INSIDE;
+	}
+
+	f32 getAxis(const core::vector3df& v, u32 axis)
+	{
+		return axis == 0 ? v.X : (axis == 1 ? v.Y : v.Z);
+	}
+
+	//! moves the k-th smallest center on the axis to position k
+	void selectCenter(u32* order, u32 count, u32 k, const core::vector3df* centers, u32 axis)
+	{
+		s32 left = 0;
+		s32 right = count - 1;
+		while (left < right)
+		{
+			const f32 pivot = getAxis(centers[order[(left + right) / 2]], axis);
+			s32 i = left;
+			s32 j = right;
+			while (i <= j)
+			{
+				while (getAxis(centers[order[i]], axis) < pivot)
+					++i;
+				while (getAxis(centers[order[j]], axis) > pivot)
+					--j;
+				if (i <= j)
+				{
+					core::swap(order[i], order[j]);
+					++i;
+					--j;
+				}
+			}
+			if ((s32)k <= j)
+				right = j;
+			else if ((s32)k >= i)
+				left = i;
+			else
+				break;
+		}
+	}
+}
+
+
+//! constructor
+CSceneNodeBVH::CSceneNodeBVH()
+: RemovedCount(0), MovedCount(0), NextLeaf(0), Culled(false)
+{
+}
+
+
+//! removes all nodes
+void CSceneNodeBVH::clear()
+{
+	Leaves.clear();
+	LeafOrder.clear();
+	Moved.clear();
+	Nodes.clear();
+	States.clear();
+	LeafTable.clear();
+	Pending.clear();
+	RemovedPending.clear();
+	RemovedCount = 0;
+	MovedCount = 0;
+	Culled = false;
+}
+
+
+//! adds a node
+void CSceneNodeBVH::add(ISceneNode* node)
+{
+	if (findLeaf(node) == -1)
+		Pending.push_back(node);
+}
+
+
+//! removes a node
+void CSceneNodeBVH::remove(ISceneNode* node)
+{
+	const s32 leaf = findLeaf(node);
+	if (leaf != -1)
+	{
+		// the leaf keeps its box until the next build
+		Leaves[leaf].Node = 0;
+		++RemovedCount;
+		return;
+	}
+
+	// instead of searching many added nodes, the next build drops them.
+	// Rebuilding here would change the leaves while drawAll() still asks
+	// for the results of the last cull().
+	if (Pending.size() > 64)
+	{
+		RemovedPending.push_back(node);
+		return;
+	}
+
+	for (u32 i=0; i<Pending.size(); ++i)
+	{
+		if (Pending[i] == node)
+		{
+			Pending[i] = Pending.getLast();
+			Pending.erase(Pending.size()-1);
+			return;
+		}
+	}
+}
+
+
+//! updates the boxes of moved nodes and classifies all nodes against the frustum
+void CSceneNodeBVH::cull(const SViewFrustum& frustum)
+{
+	const u32 live = Leaves.size() - RemovedCount;
+
+	// added and removed nodes are handled without the hierarchy until
+	// rebuilding pays off. Refitting lets the boxes of the hierarchy grow
+	// loose, so it is also rebuilt after as many moves as it has nodes,
+	// which also brings nodes up to date which were not asked for.
+	if (Pending.size() > core::max_(live / 8, 64u) || RemovedCount > Leaves.size() / 4 ||
+		MovedCount > core::max_(live, 1024u) || (Pending.size() && !live))
+		build();
+	else
+		refit();
+
+	classify(frustum);
+	Culled = true;
+}
+
+
+//! returns the result of the last cull() for a node
+bool CSceneNodeBVH::getCullState(const ISceneNode* node, u32& state) const
+{
+	if (!Culled)
+		return false;
+
+	// the scene graph mostly asks in the order of the leaves
+	s32 leaf = NextLeaf;
+	if (NextLeaf >= Leaves.size() || Leaves[NextLeaf].Node != node)
+	{
+		leaf = findLeaf(node);
+		if (leaf == -1)
+			return false;
+	}
+	NextLeaf = leaf + 1;
+
+	// the node moved since it was put into the hierarchy, so the next
+	// cull() has to refit it
+	const SLeaf& l = Leaves[leaf];
+	if (!(l.LocalBox == node->getBoundingBox()) || !(l.Transform == node->getAbsoluteTransformation()))
+	{
+		Moved.push_back(leaf);
+		return false;
+	}
+
+	state = States[leaf];
+	return true;
+}
+
+
+//! reads the boxes of a leaf from its node, returns true if they changed
+bool CSceneNodeBVH::updateLeaf(SLeaf& leaf)
+{
+	if (leaf.Transform == leaf.Node->getAbsoluteTransformation() &&
+		leaf.LocalBox == leaf.Node->getBoundingBox())
+		return false;
+
+	setLeafBoxes(leaf);
+	return true;
+}
+
+
+//! sets the boxes of a leaf to the ones of its node
+void CSceneNodeBVH::setLeafBoxes(SLeaf& leaf)
+{
+	// the same box as CSceneManager::isCulled() tests for EAC_BOX
+	leaf.Transform = leaf.Node->getAbsoluteTransformation();
+	leaf.LocalBox = leaf.Node->getBoundingBox();
+	leaf.Box = leaf.LocalBox;
+	leaf.Transform.transformBoxEx(leaf.Box);
+}
+
+
+//! rebuilds the hierarchy from the live and pending nodes
+void CSceneNodeBVH::build()
+{
+	// keep the order of the leaves, without the removed ones
+	u32 count = 0;
+	for (u32 i=0; i<Leaves.size(); ++i)
+	{
+		if (Leaves[i].Node)
+		{
+			if (count != i)
+				Leaves[count] = Leaves[i];
+			updateLeaf(Leaves[count]);
+			++count;
+		}
+	}
+	Leaves.set_used(count);
+
+	// a node which was added and removed again as often is dropped
+	core::array<u32> dropped;
+	if (RemovedPending.size())
+	{
+		RemovedPending.sort();
+		dropped.set_used(RemovedPending.size());
+		for (u32 i=0; i<dropped.size(); ++i)
+			dropped[i] = 0;
+	}
+
+	Leaves.reallocate(count + Pending.size());
+	for (u32 i=0; i<Pending.size(); ++i)
+	{
+		s32 last = 0;
+		const s32 first = RemovedPending.size() ? RemovedPending.binary_search_multi(Pending[i], last) : -1;
+		if (first != -1 && (s32)dropped[first] <= last - first)
+		{
+			++dropped[first];
+			continue;
+		}
+
+		Leaves.push_back(SLeaf());
+		Leaves.getLast().Node = Pending[i];
+		setLeafBoxes(Leaves.getLast());
+	}
+	Pending.clear();
+	RemovedPending.clear();
+
+	count = Leaves.size();
+	LeafOrder.set_used(count);
+	Centers.set_used(count);
+	for (u32 i=0; i<count; ++i)
+	{
+		LeafOrder[i] = i;
+		Centers[i] = Leaves[i].Box.getCenter();
+	}
+
+	Nodes.set_used(0);
+	if (count)
+		buildNode(0, count, -1);
+
+	for (u32 n=0; n<Nodes.size(); ++n)
+		if (Nodes[n].Right == -1)
+			for (u32 i=0; i<Nodes[n].LeafCount; ++i)
+				Leaves[LeafOrder[Nodes[n].FirstLeaf + i]].Owner = n;
+	refitNodes();
+
+	// at most half full, so the probing stays short
+	u32 size = 256;
+	while (size < count * 2)
+		size *= 2;
+	LeafTable.set_used(size);
+	for (u32 i=0; i<size; ++i)
+		LeafTable[i] = -1;
+	for (u32 i=0; i<count; ++i)
+	{
+		u32 slot = leafSlot(Leaves[i].Node);
+		while (LeafTable[slot] != -1)
+			slot = (slot + 1) & (size - 1);
+		LeafTable[slot] = i;
+	}
+
+	States.set_used(count);
+	Moved.set_used(0);
+	RemovedCount = 0;
+	MovedCount = 0;
+}
+
+
+//! builds the subtree of LeafOrder[first] to LeafOrder[first+count-1], returns its node
+s32 CSceneNodeBVH::buildNode(u32 first, u32 count, s32 parent)
+{
+	const s32 index = Nodes.size();
+	Nodes.push_back(SNode());
+	Nodes[index].FirstLeaf = first;
+	Nodes[index].LeafCount = count;
+	Nodes[index].Parent = parent;
+	Nodes[index].Right = -1;
+	// the box is set by refitNodes()
+	Nodes[index].Dirty = true;
+
+	if (count <= BUCKET_SIZE)
+		return index;
+
+	// split at the median center on the longest axis of the centers
+	core::aabbox3d<f32> centers(Centers[LeafOrder[first]]);
+	for (u32 i=1; i<count; ++i)
+		centers.addInternalPoint(Centers[LeafOrder[first + i]]);
+	const core::vector3df extent = centers.getExtent();
+	const u32 axis = (extent.X >= extent.Y && extent.X >= extent.Z) ? 0 : (extent.Y >= extent.Z ? 1 : 2);
+
+	const u32 half = count / 2;
+	selectCenter(LeafOrder.pointer() + first, count, half, Centers.pointer(), axis);
+
+	buildNode(first, half, index);
+	Nodes[index].Right = buildNode(first + half, count - half, index);
+	return index;
+}
+
+
+//! updates the boxes of the moved leaves and their parents
+void CSceneNodeBVH::refit()
+{
+	for (u32 i=0; i<Moved.size(); ++i)
+	{
+		SLeaf& leaf = Leaves[Moved[i]];
+		if (!leaf.Node || !updateLeaf(leaf))
+			continue;
+
+		++MovedCount;
+		for (s32 n=leaf.Owner; n != -1 && !Nodes[n].Dirty; n = Nodes[n].Parent)
+			Nodes[n].Dirty = true;
+	}
+
+	Moved.set_used(0);
+	refitNodes();
+}
+
+
+//! recalculates the boxes of dirty nodes from their children
+void CSceneNodeBVH::refitNodes()
+{
+	// children come after their parents
+	for (s32 n=(s32)Nodes.size()-1; n>=0; --n)
+	{
+		SNode& node = Nodes[n];
+		if (!node.Dirty)
+			continue;
+
+		if (node.Right == -1)
+		{
+			// removed leaves keep their last box
+			const u32* leaf = LeafOrder.const_pointer() + node.FirstLeaf;
+			node.Box = Leaves[leaf[0]].Box;
+			for (u32 i=1; i<node.LeafCount; ++i)
+				node.Box.addInternalBox(Leaves[leaf[i]].Box);
+		}
+		else
+		{
+			node.Box = Nodes[n + 1].Box;
+			node.Box.addInternalBox(Nodes[node.Right].Box);
+		}
+		node.Dirty = false;
+	}
+}
+
+
+//! classifies all leaves against the frustum
+void CSceneNodeBVH::classify(const SViewFrustum& frustum)
+{
+	if (Nodes.empty())
+		return;
+
+	const core::aabbox3d<f32>& frustumBox = frustum.getBoundingBox();
+
+	struct SEntry
+	{
+		s32 Node;
+		u32 Planes;
+		bool BoxInside;
+	};
+	// the hierarchy is balanced, so this is deep enough for any scene
+	SEntry stack[64];
+	u32 top = 0;
+	stack[top].Node = 0;
+	stack[top].Planes = (1 << SViewFrustum::VF_PLANE_COUNT) - 1;
+	stack[top].BoxInside = false;
+	++top;
+
+	while (top)
+	{
+		const SEntry e = stack[--top];
+		const SNode& node = Nodes[e.Node];
+
+		const E_BOX_RELATION box = e.BoxInside ? EBR_INSIDE : classifyBox(node.Box, frustumBox);
+		u32 planes = e.Planes;
+		const E_BOX_RELATION frust = planes ? classifyPlanes(node.Box, frustum, planes) : EBR_INSIDE;
+
+		// the whole subtree gets the same result
+		if (box != EBR_PARTIAL && frust != EBR_PARTIAL)
+		{
+			const u8 state = (box == EBR_OUTSIDE ? ECS_BOX_CULLED : 0) |
+				(frust == EBR_OUTSIDE ? ECS_FRUSTUM_CULLED : 0);
+			const u32* leaf = LeafOrder.const_pointer() + node.FirstLeaf;
+			for (u32 i=0; i<node.LeafCount; ++i)
+				States[leaf[i]] = state;
+			continue;
+		}
+
+		if (node.Right == -1)
+		{
+			for (u32 i=0; i<node.LeafCount; ++i)
+			{
+				const u32 leaf = LeafOrder[node.FirstLeaf + i];
+				const core::aabbox3d<f32>& leafBox = Leaves[leaf].Box;
+				u8 state = 0;
+
+				if (box == EBR_OUTSIDE || (box == EBR_PARTIAL && !leafBox.intersectsWithBox(frustumBox)))
+					state |= ECS_BOX_CULLED;
+
+				u32 leafPlanes = planes;
+				const E_BOX_RELATION leafFrust = frust == EBR_PARTIAL ?
+					classifyPlanes(leafBox, frustum, leafPlanes) : frust;
+				if (leafFrust == EBR_OUTSIDE)
+					state |= ECS_FRUSTUM_CULLED;
+				else if (leafFrust == EBR_PARTIAL)
+					state |= ECS_FRUSTUM_UNKNOWN;
+
+				States[leaf] = state;
+			}
+			continue;
+		}
+
+		stack[top].Node = node.Right;
+		stack[top].Planes = planes;
+		stack[top].BoxInside = box == EBR_INSIDE;
+		++top;
+		stack[top].Node = e.Node + 1;
+		stack[top].Planes = planes;
+		stack[top].BoxInside = box == EBR_INSIDE;
+		++top;
+	}
+}
+
+
+//! returns the position of a leaf, or -1
+s32 CSceneNodeBVH::findLeaf(const ISceneNode* node) const
+{
+	if (LeafTable.empty())
+		return -1;
+
+	for (u32 slot=leafSlot(node); LeafTable[slot] != -1; slot = (slot + 1) & (LeafTable.size() - 1))
+	{
+		const s32 leaf = LeafTable[slot];
+		if (Leaves[leaf].Node == node)
+			return leaf;
+	}
+	return -1;
+}
+
+
+//! returns the first slot of LeafTable to look for a node
+u32 CSceneNodeBVH::leafSlot(const ISceneNode* node) const
+{
+	const u32 h = (u32)((size_t)node / sizeof(void*)) * 2654435761u;
+	return (h ^ (h >> 16)) & (LeafTable.size() - 1);
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,161 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_SCENE_NODE_BVH_H_INCLUDED__
+#define __C_SCENE_NODE_BVH_H_INCLUDED__
+
+#include "irrArray.h"
+#include "aabbox3d.h"
+#include "matrix4.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ISceneNode;
+	struct SViewFrustum;
+
+	//! Bounding volume hierarchy over the absolute bounding boxes of scene nodes.
+	/** Used by the scene manager, see ISceneManager::setCullingHierarchyEnabled().
+	cull() classifies whole subtrees of the hierarchy against the view
+	frustum at once and remembers the result of each node, which isCulled()
+	then only has to look up. The results are the same as the tests of
+	EAC_BOX and EAC_FRUSTUM_BOX; where the absolute box of a node is not
+	enough to decide EAC_FRUSTUM_BOX, the node is marked so the scene manager
+	tests its transformed box as before.
+	getCullState() compares the node with the boxes the result is based on.
+	Nodes which moved are tested without the hierarchy that time and are
+	refitted into it by the next cull(), so cull() does not have to visit all
+	nodes. Added nodes are tested without the hierarchy until there are
+	enough of them to rebuild it. The hierarchy is only rebuilt by cull(),
+	so the results stay valid until the next one. */
+	class CSceneNodeBVH
+	{
+	public:
+
+		//! flags of getCullState()
+		enum E_CULL_STATE
+		{
+			//! EAC_BOX culls the node
+			ECS_BOX_CULLED = 1,
+			//! EAC_FRUSTUM_BOX culls the node
+			ECS_FRUSTUM_CULLED = 2,
+			//! EAC_FRUSTUM_BOX has to test the node itself
+			ECS_FRUSTUM_UNKNOWN = 4
+		};
+
+		//! constructor
+		CSceneNodeBVH();
+
+		//! removes all nodes
+		void clear();
+
+		//! adds a node
+		/** Adding a node twice without removing it in between is only
+		detected once cull() took it into the hierarchy. */
+		void add(ISceneNode* node);
+
+		//! removes a node
+		void remove(ISceneNode* node);
+
+		//! updates the boxes of moved nodes and classifies all nodes against the frustum
+		void cull(const SViewFrustum& frustum);
+
+		//! forgets the results of cull(), until it is called again
+		void invalidate() { Culled = false; }
+
+		//! returns the result of the last cull() for a node
+		/** \param state Set to the E_CULL_STATE flags of the node.
+		\return False if there is no result for the node, because it
+		is not in the hierarchy yet or moved since the last cull(). */
+		bool getCullState(const ISceneNode* node, u32& state) const;
+
+		//! returns the number of nodes in the hierarchy, including the ones waiting to be added
+		u32 size() const { return Leaves.size() - RemovedCount + Pending.size() - RemovedPending.size(); }
+
+	private:
+
+		//! A scene node and the boxes it had at the last cull()
+		struct SLeaf
+		{
+			ISceneNode* Node;
+			core::matrix4 Transform;
+			core::aabbox3d<f32> LocalBox;
+			core::aabbox3d<f32> Box;
+			s32 Owner;
+		};
+
+		//! A node of the hierarchy. Its leaves are the ones LeafOrder
+		//! lists from FirstLeaf to FirstLeaf+LeafCount-1. Inner nodes are
+		//! followed by their left child, Right is -1 for nodes without
+		//! children.
+		struct SNode
+		{
+			core::aabbox3d<f32> Box;
+			u32 FirstLeaf;
+			u32 LeafCount;
+			s32 Parent;
+			s32 Right;
+			bool Dirty;
+		};
+
+		//! rebuilds the hierarchy from the live and pending nodes
+		void build();
+
+		//! builds the subtree of LeafOrder[first] to LeafOrder[first+count-1], returns its node
+		s32 buildNode(u32 first, u32 count, s32 parent);
+
+		//! updates the boxes of the moved leaves and their parents
+		void refit();
+
+		//! recalculates the boxes of dirty nodes from their children
+		void refitNodes();
+
+		//! reads the boxes of a leaf from its node, returns true if they changed
+		bool updateLeaf(SLeaf& leaf);
+
+		//! sets the boxes of a leaf to the ones of its node
+		void setLeafBoxes(SLeaf& leaf);
+
+		//! classifies all leaves against the frustum
+		void classify(const SViewFrustum& frustum);
+
+		//! returns the position of a leaf, or -1
+		s32 findLeaf(const ISceneNode* node) const;
+
+		//! returns the first slot of LeafTable to look for a node
+		u32 leafSlot(const ISceneNode* node) const;
+
+		//! in the order the nodes were added, which is mostly the order
+		//! in which the scene graph visits them
+		core::array<SLeaf> Leaves;
+		//! positions of the leaves in the order of the hierarchy
+		core::array<u32> LeafOrder;
+		core::array<SNode> Nodes;
+		//! E_CULL_STATE of each leaf
+		core::array<u8> States;
+		//! leaves by node pointer, with open addressing
+		core::array<s32> LeafTable;
+		//! leaves which getCullState() found out of date
+		mutable core::array<u32> Moved;
+		//! added nodes which are not in the hierarchy yet
+		core::array<ISceneNode*> Pending;
+		//! nodes removed while many were pending, dropped from Pending by the next build
+		core::array<ISceneNode*> RemovedPending;
+
+		//! box centers of the leaves, used while building
+		core::array<core::vector3df> Centers;
+
+		u32 RemovedCount;
+		u32 MovedCount;
+		//! the leaf getCullState() looks at before searching
+		mutable u32 NextLeaf;
+		bool Culled;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -0,0 +1,267 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CSceneNodeIndex.h"
+#include "ISceneNode.h"
+#include <string.h>
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CSceneNodeIndex::CSceneNodeIndex()
+: FreeEntry(-1), Count(0)
+{
+}
+
+
+//! removes all nodes
+void CSceneNodeIndex::clear()
+{
+	Entries.clear();
+	NodeTable.clear();
+	NameTable.clear();
+	IdTable.clear();
+	FreeEntry = -1;
+	Count = 0;
+}
+
+
+//! adds a node, moves it to the lists of its new name and id, or removes it
+void CSceneNodeIndex::update(ISceneNode* node, bool inScene)
+{
+	s32 prev;
+	const s32 e = findEntry(node, &prev);
+
+	if (e != -1)
+	{
+		SEntry& entry = Entries[e];
+
+		if (inScene)
+		{
+			const u32 hash = hashName(node->getName());
+			if (entry.NameHash == hash && entry.ID == node->getID())
+				return;
+
+			unlinkKeys(e);
+			entry.NameHash = hash;
+			entry.ID = node->getID();
+			linkKeys(e);
+			return;
+		}
+
+		unlinkKeys(e);
+		if (prev == -1)
+			NodeTable[nodeSlot(node)] = entry.NextNode;
+		else
+			Entries[prev].NextNode = entry.NextNode;
+
+		entry.Node = 0;
+		entry.NextNode = FreeEntry;
+		FreeEntry = e;
+		--Count;
+		return;
+	}
+
+	if (!inScene)
+		return;
+
+	if (Count >= NodeTable.size())
+		grow();
+
+	s32 n = FreeEntry;
+	if (n != -1)
+		FreeEntry = Entries[n].NextNode;
+	else
+	{
+		n = Entries.size();
+		Entries.push_back(SEntry());
+	}
+
+	SEntry& entry = Entries[n];
+	entry.Node = node;
+	entry.NameHash = hashName(node->getName());
+	entry.ID = node->getID();
+
+	const u32 slot = nodeSlot(node);
+	entry.NextNode = NodeTable[slot];
+	NodeTable[slot] = n;
+
+	linkKeys(n);
+	++Count;
+}
+
+
+//! finds the node with a name
+ISceneNode* CSceneNodeIndex::findByName(const c8* name, bool& shared) const
+{
+	shared = false;
+	if (!Count)
+		return 0;
+
+	const u32 hash = hashName(name);
+	ISceneNode* found = 0;
+
+	for (s32 e = NameTable[hash & (NameTable.size()-1)]; e != -1; e = Entries[e].NextName)
+	{
+		const SEntry& entry = Entries[e];
+		if (entry.NameHash != hash || strcmp(entry.Node->getName(), name))
+			continue;
+
+		if (found)
+		{
+			shared = true;
+			break;
+		}
+		found = entry.Node;
+	}
+
+	return found;
+}
+
+
+//! finds the node with an id
+ISceneNode* CSceneNodeIndex::findById(s32 id, bool& shared) const
+{
+	shared = false;
+	if (!Count)
+		return 0;
+
+	ISceneNode* found = 0;
+
+	for (s32 e = IdTable[idSlot(id)]; e != -1; e = Entries[e].NextId)
+	{
+		if (Entries[e].ID != id)
+			continue;
+
+		if (found)
+		{
+			shared = true;
+			break;
+		}
+		found = Entries[e].Node;
+	}
+
+	return found;
+}
+
+
+//! returns the position of the entry of a node, or -1
+s32 CSceneNodeIndex::findEntry(const ISceneNode* node, s32* prevNode) const
+{
+	s32 prev = -1;
+	s32 e = NodeTable.size() ? NodeTable[nodeSlot(node)] : -1;
+
+	while (e != -1 && Entries[e].Node != node)
+	{
+		prev = e;
+		e = Entries[e].NextNode;
+	}
+
+	if (prevNode)
+		*prevNode = prev;
+	return e;
+}
+
+
+//! links an entry into the lists of the name and id tables
+void CSceneNodeIndex::linkKeys(s32 e)
+{
+	SEntry& entry = Entries[e];
+
+	const u32 nameSlot = entry.NameHash & (NameTable.size()-1);
+	entry.PrevName = -1;
+	entry.NextName = NameTable[nameSlot];
+	if (entry.NextName != -1)
+		Entries[entry.NextName].PrevName = e;
+	NameTable[nameSlot] = e;
+
+	const u32 id = idSlot(entry.ID);
+	entry.PrevId = -1;
+	entry.NextId = IdTable[id];
+	if (entry.NextId != -1)
+		Entries[entry.NextId].PrevId = e;
+	IdTable[id] = e;
+}
+
+
+//! unlinks an entry from the lists of the name and id tables
+void CSceneNodeIndex::unlinkKeys(s32 e)
+{
+	const SEntry& entry = Entries[e];
+
+	if (entry.PrevName != -1)
+		Entries[entry.PrevName].NextName = entry.NextName;
+	else
+		NameTable[entry.NameHash & (NameTable.size()-1)] = entry.NextName;
+	if (entry.NextName != -1)
+		Entries[entry.NextName].PrevName = entry.PrevName;
+
+	if (entry.PrevId != -1)
+		Entries[entry.PrevId].NextId = entry.NextId;
+	else
+		IdTable[idSlot(entry.ID)] = entry.NextId;
+	if (entry.NextId != -1)
+		Entries[entry.NextId].PrevId = entry.PrevId;
+}
+
+
+//! doubles the size of the tables when they are full
+void CSceneNodeIndex::grow()
+{
+	const u32 size = core::max_(NodeTable.size() * 2, 256u);
+
+	NodeTable.set_used(size);
+	NameTable.set_used(size);
+	IdTable.set_used(size);
+	for (u32 i=0; i<size; ++i)
+	{
+		NodeTable[i] = -1;
+		NameTable[i] = -1;
+		IdTable[i] = -1;
+	}
+
+	for (u32 e=0; e<Entries.size(); ++e)
+	{
+		SEntry& entry = Entries[e];
+		if (!entry.Node)
+			continue;
+
+		const u32 slot = nodeSlot(entry.Node);
+		entry.NextNode = NodeTable[slot];
+		NodeTable[slot] = e;
+		linkKeys(e);
+	}
+}
+
+
+u32 CSceneNodeIndex::nodeSlot(const ISceneNode* node) const
+{
+	u32 h = (u32)((size_t)node / sizeof(void*)) * 2654435761u;
+	return (h ^ (h >> 16)) & (NodeTable.size()-1);
+}
+
+
+u32 CSceneNodeIndex::idSlot(s32 id) const
+{
+	u32 h = (u32)id * 2654435761u;
+	return (h ^ (h >> 16)) & (IdTable.size()-1);
+}
+
+
+//! FNV-1a
+u32 CSceneNodeIndex::hashName(const c8* name)
+{
+	u32 h = 2166136261u;
+	for (; *name; ++name)
+		h = (h ^ (u8)*name) * 16777619u;
+	return h;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
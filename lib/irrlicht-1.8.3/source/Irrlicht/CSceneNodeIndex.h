@@ -0,0 +1,97 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_SCENE_NODE_INDEX_H_INCLUDED__
+#define __C_SCENE_NODE_INDEX_H_INCLUDED__
+
+#include "irrArray.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ISceneNode;
+
+	//! Hash tables finding scene nodes by name and by id.
+	/** Used by the scene manager, see ISceneManager::setSceneNodeIndexEnabled().
+	Names and ids are read from the nodes when they are looked up, the index
+	only remembers in which lists a node is. Adding, updating and removing a
+	node takes constant time, also when many nodes share a name or id. */
+	class CSceneNodeIndex
+	{
+	public:
+
+		//! constructor
+		CSceneNodeIndex();
+
+		//! removes all nodes
+		void clear();
+
+		//! adds a node, moves it to the lists of its new name and id, or removes it
+		/** \param node The node which was added or changed.
+		\param inScene False if the node has to be removed. */
+		void update(ISceneNode* node, bool inScene);
+
+		//! finds the node with a name
+		/** \param name The name to search for.
+		\param shared Set to true if more than one node has this name.
+		\return The node, or 0 if there is none. */
+		ISceneNode* findByName(const c8* name, bool& shared) const;
+
+		//! finds the node with an id
+		/** \param id The id to search for.
+		\param shared Set to true if more than one node has this id.
+		\return The node, or 0 if there is none. */
+		ISceneNode* findById(s32 id, bool& shared) const;
+
+		//! returns the number of nodes in the index
+		u32 size() const { return Count; }
+
+	private:
+
+		//! A node in the index. Entries are linked into one list of
+		//! the node table and one list each of the name and id tables.
+		struct SEntry
+		{
+			ISceneNode* Node;
+			u32 NameHash;
+			s32 ID;
+			s32 NextNode;
+			s32 PrevName;
+			s32 NextName;
+			s32 PrevId;
+			s32 NextId;
+		};
+
+		//! returns the position of the entry of a node, or -1
+		s32 findEntry(const ISceneNode* node, s32* prevNode=0) const;
+
+		//! links an entry into the lists of the name and id tables
+		void linkKeys(s32 e);
+
+		//! unlinks an entry from the lists of the name and id tables
+		void unlinkKeys(s32 e);
+
+		//! doubles the size of the tables when they are full
+		void grow();
+
+		u32 nodeSlot(const ISceneNode* node) const;
+		u32 idSlot(s32 id) const;
+		static u32 hashName(const c8* name);
+
+		core::array<SEntry> Entries;
+		core::array<s32> NodeTable;
+		core::array<s32> NameTable;
+		core::array<s32> IdTable;
+
+		//! first unused entry, linked by NextNode
+		s32 FreeEntry;
+		u32 Count;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -206,6 +206,7 @@ bool CSoftwareDriver::setActiveTexture(u32 stage, video::ITexture* texture)
 //! sets a material
 void CSoftwareDriver::setMaterial(const SMaterial& material)
 {
+	++MaterialChanges;
 	Material = material;
 	OverrideMaterial.apply(Material);
 
@@ -13,6 +13,15 @@
 #include "S3DVertex.h"
 #include "S4DVertex.h"
 #include "CBlit.h"
+#include "IReadFile.h"
+#include "CImageLoaderDDS.h"
+
+#ifdef SOFTWARE_DRIVER_2_SSE
+	#include <xmmintrin.h>
+	#if defined ( _MSC_VER )
+		#include <intrin.h>
+	#endif
+#endif
 
 
 #define MAT_TEXTURE(tex) ( (video::CSoftwareTexture2*) Material.org.getTexture ( tex ) )
@@ -336,7 +345,9 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 : CNullDriver(io, params.WindowSize), BackBuffer(0), Presenter(presenter),
 	WindowId(0), SceneSourceRect(0),
 	RenderTargetTexture(0), RenderTargetSurface(0), CurrentShader(0),
-	 DepthBuffer(0), StencilBuffer ( 0 ),
+	CurrentShaderType(ETR_TEXTURE_GOURAUD), CurrentShaderDepth(0), ClearTileColumns(0), ClearPending(0), ClearColor(0),
+	TilesActive(false), TileHeight(0), TileCount(0),
+	 DepthBuffer(0), StencilBuffer ( 0 ), UseSSE ( false ),
 	 CurrentOut ( 12 * 2, 128 ), Temp ( 12 * 2, 128 )
 {
 	#ifdef _DEBUG
@@ -365,40 +376,19 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 	DriverAttributes->setAttribute("MaxTextureLODBias", 16.f);
 	DriverAttributes->setAttribute("Version", 47);
 
-	// create triangle renderers
-
-	irr::memset32 ( BurningShader, 0, sizeof ( BurningShader ) );
-	//BurningShader[ETR_FLAT] = createTRFlat2(DepthBuffer);
-	//BurningShader[ETR_FLAT_WIRE] = createTRFlatWire2(DepthBuffer);
-	BurningShader[ETR_GOURAUD] = createTriangleRendererGouraud2(this);
-	BurningShader[ETR_GOURAUD_ALPHA] = createTriangleRendererGouraudAlpha2(this );
-	BurningShader[ETR_GOURAUD_ALPHA_NOZ] = createTRGouraudAlphaNoZ2(this );
-	//BurningShader[ETR_GOURAUD_WIRE] = createTriangleRendererGouraudWire2(DepthBuffer);
-	//BurningShader[ETR_TEXTURE_FLAT] = createTriangleRendererTextureFlat2(DepthBuffer);
-	//BurningShader[ETR_TEXTURE_FLAT_WIRE] = createTriangleRendererTextureFlatWire2(DepthBuffer);
-	BurningShader[ETR_TEXTURE_GOURAUD] = createTriangleRendererTextureGouraud2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M1] = createTriangleRendererTextureLightMap2_M1(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M2] = createTriangleRendererTextureLightMap2_M2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M4] = createTriangleRendererGTextureLightMap2_M4(this);
-	BurningShader[ETR_TEXTURE_LIGHTMAP_M4] = createTriangleRendererTextureLightMap2_M4(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_ADD] = createTriangleRendererTextureLightMap2_Add(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_DETAIL_MAP] = createTriangleRendererTextureDetailMap2(this);
-
-	BurningShader[ETR_TEXTURE_GOURAUD_WIRE] = createTriangleRendererTextureGouraudWire2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_NOZ] = createTRTextureGouraudNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD] = createTRTextureGouraudAdd2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD_NO_Z] = createTRTextureGouraudAddNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_VERTEX_ALPHA] = createTriangleRendererTextureVertexAlpha2 ( this );
-
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA] = createTRTextureGouraudAlpha(this );
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA_NOZ] = createTRTextureGouraudAlphaNoZ( this );
-
-	BurningShader[ETR_NORMAL_MAP_SOLID] = createTRNormalMap ( this );
-	BurningShader[ETR_STENCIL_SHADOW] = createTRStencilShadow ( this );
-	BurningShader[ETR_TEXTURE_BLEND] = createTRTextureBlend( this );
-
-	BurningShader[ETR_REFERENCE] = createTriangleRendererReference ( this );
+#if defined ( SOFTWARE_DRIVER_2_SSE )
+	#if defined ( _M_IX86 ) && !defined ( __SSE__ ) && ( !defined ( _M_IX86_FP ) || _M_IX86_FP < 1 )
+		// edx bit 25 of cpuid 1
+		int cpuInfo[4];
+		__cpuid ( cpuInfo, 1 );
+		UseSSE = ( cpuInfo[3] & ( 1 << 25 ) ) != 0;
+	#else
+		UseSSE = true;
+	#endif
+#endif
 
+	// create triangle renderers
+	createShaders(BurningShader);
 
 	// add the same renderer for all solid types
 	CSoftware2MaterialRenderer_SOLID* smr = new CSoftware2MaterialRenderer_SOLID( this);
@@ -443,6 +433,8 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 
 	// select the right renderer
 	setCurrentShader();
+
+	setRasterThreadCount(params.RasterThreads);
 }
 
 
@@ -461,6 +453,8 @@ CBurningVideoDriver::~CBurningVideoDriver()
 			BurningShader[i]->drop();
 	}
 
+	setRasterThreadCount(1);
+
 	// delete Additional buffer
 	if (StencilBuffer)
 		StencilBuffer->drop();
@@ -476,6 +470,44 @@ CBurningVideoDriver::~CBurningVideoDriver()
 }
 
 
+//! creates the triangle renderers for each EBurningFFShader
+void CBurningVideoDriver::createShaders(IBurningShader** shader)
+{
+	irr::memset32 ( shader, 0, ETR2_COUNT * sizeof ( IBurningShader* ) );
+	//shader[ETR_FLAT] = createTRFlat2(DepthBuffer);
+	//shader[ETR_FLAT_WIRE] = createTRFlatWire2(DepthBuffer);
+	shader[ETR_GOURAUD] = createTriangleRendererGouraud2(this);
+	shader[ETR_GOURAUD_ALPHA] = createTriangleRendererGouraudAlpha2(this );
+	shader[ETR_GOURAUD_ALPHA_NOZ] = createTRGouraudAlphaNoZ2(this );
+	//shader[ETR_GOURAUD_WIRE] = createTriangleRendererGouraudWire2(DepthBuffer);
+	//shader[ETR_TEXTURE_FLAT] = createTriangleRendererTextureFlat2(DepthBuffer);
+	//shader[ETR_TEXTURE_FLAT_WIRE] = createTriangleRendererTextureFlatWire2(DepthBuffer);
+	shader[ETR_TEXTURE_GOURAUD] = createTRTexturePermutation(this, ETR_TEXTURE_GOURAUD);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M1] = createTriangleRendererTextureLightMap2_M1(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M2] = createTriangleRendererTextureLightMap2_M2(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M4] = createTriangleRendererGTextureLightMap2_M4(this);
+	shader[ETR_TEXTURE_LIGHTMAP_M4] = createTriangleRendererTextureLightMap2_M4(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_ADD] = createTriangleRendererTextureLightMap2_Add(this);
+	shader[ETR_TEXTURE_GOURAUD_DETAIL_MAP] = createTRTexturePermutation(this, ETR_TEXTURE_GOURAUD_DETAIL_MAP);
+
+	shader[ETR_TEXTURE_GOURAUD_WIRE] = createTriangleRendererTextureGouraudWire2(this);
+	shader[ETR_TEXTURE_GOURAUD_NOZ] = createTRTexturePermutation(this, ETR_TEXTURE_GOURAUD_NOZ);
+	shader[ETR_TEXTURE_GOURAUD_ADD] = createTRTexturePermutation(this, ETR_TEXTURE_GOURAUD_ADD);
+	shader[ETR_TEXTURE_GOURAUD_ADD_NO_Z] = createTRTexturePermutation(this, ETR_TEXTURE_GOURAUD_ADD_NO_Z);
+	shader[ETR_TEXTURE_GOURAUD_VERTEX_ALPHA] = createTriangleRendererTextureVertexAlpha2 ( this );
+
+	shader[ETR_TEXTURE_GOURAUD_ALPHA] = createTRTextureGouraudAlpha(this );
+	shader[ETR_TEXTURE_GOURAUD_ALPHA_NOZ] = createTRTextureGouraudAlphaNoZ( this );
+
+	shader[ETR_NORMAL_MAP_SOLID] = createTRNormalMap ( this );
+	shader[ETR_STENCIL_SHADOW] = createTRStencilShadow ( this );
+	shader[ETR_OCCLUSION_QUERY] = createTROcclusionQuery ( this );
+	shader[ETR_TEXTURE_BLEND] = createTRTextureBlend( this );
+
+	shader[ETR_REFERENCE] = createTriangleRendererReference ( this );
+}
+
+
 /*!
 	selects the right triangle renderer based on the render states.
 */
@@ -580,28 +612,261 @@ void CBurningVideoDriver::setCurrentShader()
 		shader = ETR_TEXTURE_GOURAUD_WIRE;
 	}
 
+	// the material of occlusion queries, count the pixels passing the depth test
+	if ( Material.org.ColorMask == ECP_NONE && !Material.org.ZWriteEnable )
+	{
+		shader = ETR_OCCLUSION_QUERY;
+	}
+
 	//shader = ETR_REFERENCE;
 
 	// switchToTriangleRenderer
 	CurrentShader = BurningShader[shader];
+	CurrentShaderType = shader;
 	if ( CurrentShader )
+		setShaderState ( CurrentShader, shader );
+}
+
+
+//! sets the render states of a triangle renderer selected by setCurrentShader()
+void CBurningVideoDriver::setShaderState(IBurningShader* shader, EBurningFFShader type)
+{
+	shader->setZCompareFunc ( Material.org.ZBuffer );
+	shader->setRenderTarget(RenderTargetSurface, ViewPort);
+	shader->setMaterial ( Material );
+
+	switch ( type )
 	{
-		CurrentShader->setZCompareFunc ( Material.org.ZBuffer );
-		CurrentShader->setRenderTarget(RenderTargetSurface, ViewPort);
-		CurrentShader->setMaterial ( Material );
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+		case ETR_TEXTURE_BLEND:
+			shader->setParam ( 0, Material.org.MaterialTypeParam );
+			break;
+		default:
+		break;
+	}
+}
+
+
+//! Sets the number of threads which rasterize triangles.
+void CBurningVideoDriver::setRasterThreadCount(u32 count)
+{
+	for ( u32 i = 0; i != TileShader.size(); ++i )
+	{
+		if ( TileShader[i] )
+			TileShader[i]->drop();
+	}
+	TileShader.clear();
+
+	RasterThreads.setThreadCount(count);
+
+	// each thread needs its own renderers, they keep the scanline state in members
+	count = RasterThreads.getThreadCount();
+	if ( count > 1 )
+	{
+		TileShader.set_used(count * ETR2_COUNT);
+		for ( u32 i = 0; i != count; ++i )
+			createShaders(TileShader.pointer() + i * ETR2_COUNT);
+	}
+}
+
+
+//! returns the eDepthUsage of the triangle renderer of a shader
+static u32 getDepthUsage(EBurningFFShader shader)
+{
+	switch ( shader )
+	{
+		case ETR_GOURAUD:
+		case ETR_GOURAUD_ALPHA:
+		case ETR_TEXTURE_GOURAUD:
+		case ETR_TEXTURE_GOURAUD_ADD:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M1:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M2:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M4:
+		case ETR_TEXTURE_LIGHTMAP_M4:
+		case ETR_TEXTURE_GOURAUD_DETAIL_MAP:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_ADD:
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+		case ETR_NORMAL_MAP_SOLID:
+		case ETR_TEXTURE_BLEND:
+			return DEPTH_TEST | DEPTH_WRITE;
+
+		case ETR_TEXTURE_GOURAUD_ADD_NO_Z:
+		case ETR_TEXTURE_GOURAUD_VERTEX_ALPHA:
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+		case ETR_OCCLUSION_QUERY:
+			return DEPTH_TEST;
+
+		// the wire renderer draws lines, the reference renderer has
+		// other depth tests
+		case ETR_TEXTURE_GOURAUD_WIRE:
+		case ETR_REFERENCE:
+			return DEPTH_WRITE;
+
+		default:
+			return 0;
+	}
+}
+
+
+//! draws a triangle with the current shader, or bins it into the tiles
+void CBurningVideoDriver::rasterizeTriangle(const s4DVertex* a, const s4DVertex* b, const s4DVertex* c)
+{
+	if ( !TilesActive )
+	{
+		drawTriangle ( CurrentShader, a, b, c, 0, RenderTargetSize.Height - 1 );
+		return;
+	}
+
+	// rows the fill convention of the renderers can touch
+	const f32 top = core::min_ ( a->Pos.y, b->Pos.y, c->Pos.y );
+	const f32 bottom = core::max_ ( a->Pos.y, b->Pos.y, c->Pos.y );
+	const s32 maxRow = (s32) ( TileCount * TileHeight ) - 1;
+	const s32 firstRow = core::s32_clamp ( core::ceil32 ( top ), 0, maxRow );
+	const s32 lastRow = core::s32_clamp ( core::ceil32 ( bottom ) - 1, 0, maxRow );
+	if ( lastRow < firstRow )
+		return;
+
+	// share the textures with the previous triangle if they are the same
+	const sInternalTexture* it = CurrentShader->getTextureParams ();
+	u32 textures = TileTextures.size();
+	if ( textures )
+	{
+		const sInternalTexture* last = TileTextures.const_pointer() + textures - BURNING_MATERIAL_MAX_TEXTURES;
+		u32 m = 0;
+		while ( m != BURNING_MATERIAL_MAX_TEXTURES &&
+			last[m].Texture == it[m].Texture && last[m].data == it[m].data )
+			++m;
+		if ( m == BURNING_MATERIAL_MAX_TEXTURES )
+			textures -= BURNING_MATERIAL_MAX_TEXTURES;
+	}
+	if ( textures == TileTextures.size() )
+	{
+		for ( u32 m = 0; m != BURNING_MATERIAL_MAX_TEXTURES; ++m )
+			TileTextures.push_back ( it[m] );
+	}
+
+	TileVertices.push_back ( *a );
+	TileVertices.push_back ( *b );
+	TileVertices.push_back ( *c );
+	TileTriangleTextures.push_back ( textures );
+	TileTriangleRange.push_back ( firstRow / TileHeight );
+	TileTriangleRange.push_back ( lastRow / TileHeight );
+}
+
+
+//! draws the binned triangles on all threads
+void CBurningVideoDriver::drawTiles()
+{
+	TilesActive = false;
+
+	const u32 count = TileTriangleTextures.size();
+	if ( count )
+	{
+		// sort the triangles into the tiles, keeping their order
+		TileFirst.set_used ( TileCount + 1 );
+		u32 i;
+		for ( i = 0; i != TileFirst.size(); ++i )
+			TileFirst[i] = 0;
 
-		switch ( shader )
+		for ( i = 0; i != count; ++i )
 		{
-			case ETR_TEXTURE_GOURAUD_ALPHA:
-			case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
-			case ETR_TEXTURE_BLEND:
-				CurrentShader->setParam ( 0, Material.org.MaterialTypeParam );
-				break;
-			default:
-			break;
+			for ( u32 t = TileTriangleRange[2*i]; t <= TileTriangleRange[2*i+1]; ++t )
+				TileFirst[t] += 1;
+		}
+
+		u32 sum = 0;
+		for ( i = 0; i != TileFirst.size(); ++i )
+		{
+			const u32 n = TileFirst[i];
+			TileFirst[i] = sum;
+			sum += n;
+		}
+
+		TileTriangles.set_used ( sum );
+		for ( i = 0; i != count; ++i )
+		{
+			for ( u32 t = TileTriangleRange[2*i]; t <= TileTriangleRange[2*i+1]; ++t )
+				TileTriangles [ TileFirst[t]++ ] = i;
 		}
+
+		// TileFirst[t] now is the end of tile t
+		for ( i = TileCount; i != 0; --i )
+			TileFirst[i] = TileFirst[i-1];
+		TileFirst[0] = 0;
+
+		const u32 threads = RasterThreads.getThreadCount();
+		for ( i = 0; i != threads; ++i )
+			setShaderState ( TileShader [ i * ETR2_COUNT + CurrentShaderType ], CurrentShaderType );
+
+		CTileJob job ( this );
+		RasterThreads.run ( job, TileCount );
+
+		for ( i = 0; i != threads; ++i )
+			TileShader [ i * ETR2_COUNT + CurrentShaderType ]->clearTextureParams ();
 	}
 
+	TileVertices.set_used ( 0 );
+	TileTextures.set_used ( 0 );
+	TileTriangleTextures.set_used ( 0 );
+	TileTriangleRange.set_used ( 0 );
+}
+
+
+//! draws the binned triangles of a tile
+void CBurningVideoDriver::drawTile(u32 tile, u32 thread)
+{
+	IBurningShader* shader = TileShader [ thread * ETR2_COUNT + CurrentShaderType ];
+	shader->setTile ( tile * TileHeight, ( tile + 1 ) * TileHeight - 1 );
+
+	u32 textures = 0xFFFFFFFF;
+	for ( u32 i = TileFirst[tile]; i != TileFirst[tile+1]; ++i )
+	{
+		const u32 triangle = TileTriangles[i];
+		if ( TileTriangleTextures[triangle] != textures )
+		{
+			textures = TileTriangleTextures[triangle];
+			shader->setTextureParams ( TileTextures.const_pointer() + textures );
+		}
+
+		const s4DVertex* v = TileVertices.const_pointer() + triangle * 3;
+		drawTriangle ( shader, v, v + 1, v + 2, tile * TileHeight, ( tile + 1 ) * TileHeight - 1 );
+	}
+}
+
+
+//! draws the rows top to bottom of a triangle, unless the coarse depth buffer hides them
+void CBurningVideoDriver::drawTriangle(IBurningShader* shader, const s4DVertex* a, const s4DVertex* b, const s4DVertex* c, s32 top, s32 bottom)
+{
+	if ( !CurrentShaderDepth && !ClearPending )
+	{
+		shader->drawTriangle ( a, b, c );
+		return;
+	}
+
+	// pixels the renderers can touch, the tiles of the coarse depth
+	// buffer and of the clear do not reach into the rows of other threads
+	CDepthBuffer* depth = (CDepthBuffer*) DepthBuffer;
+	const s32 maxX = (s32) RenderTargetSize.Width - 1;
+	const s32 maxY = core::min_ ( bottom, (s32) RenderTargetSize.Height - 1 );
+	const s32 x0 = core::s32_max ( core::floor32 ( core::min_ ( a->Pos.x, b->Pos.x, c->Pos.x ) ), 0 );
+	const s32 x1 = core::s32_min ( core::ceil32 ( core::max_ ( a->Pos.x, b->Pos.x, c->Pos.x ) ), maxX );
+	const s32 y0 = core::s32_max ( core::floor32 ( core::min_ ( a->Pos.y, b->Pos.y, c->Pos.y ) ), top );
+	const s32 y1 = core::s32_min ( core::ceil32 ( core::max_ ( a->Pos.y, b->Pos.y, c->Pos.y ) ), maxY );
+	if ( x1 < x0 || y1 < y0 )
+		return;
+
+	if ( ( CurrentShaderDepth & DEPTH_TEST ) &&
+		depth->isHidden ( x0, y0, x1, y1, core::max_ ( a->Pos.w, b->Pos.w, c->Pos.w ) ) )
+		return;
+
+	if ( ClearPending )
+		clearTiles ( x0, y0, x1, y1, ClearPending );
+
+	shader->drawTriangle ( a, b, c );
+
+	if ( CurrentShaderDepth & DEPTH_WRITE )
+		depth->markTiles ( x0, y0, x1, y1 );
 }
 
 
@@ -627,6 +892,7 @@ bool CBurningVideoDriver::queryFeature(E_VIDEO_DRIVER_FEATURE feature) const
 	case EVDF_MULTITEXTURE:
 	case EVDF_HARDWARE_TL:
 	case EVDF_TEXTURE_NSQUARE:
+	case EVDF_OCCLUSION_QUERY:
 		return true;
 
 	default:
@@ -691,11 +957,20 @@ bool CBurningVideoDriver::beginScene(bool backBuffer, bool zBuffer,
 	WindowId = videoData.D3D9.HWnd;
 	SceneSourceRect = sourceRect;
 
+	u32 clear = 0;
+
 	if (backBuffer && BackBuffer)
-		BackBuffer->fill(color);
+	{
+		if (BackBuffer == RenderTargetSurface)
+			clear |= CLEAR_COLOR;
+		else
+			BackBuffer->fill(color);
+	}
 
-	if (zBuffer && DepthBuffer)
-		DepthBuffer->clear();
+	if (zBuffer)
+		clear |= CLEAR_DEPTH;
+
+	markClear(clear, color);
 
 	memset ( TransformationFlag, 0, sizeof ( TransformationFlag ) );
 	return true;
@@ -707,6 +982,7 @@ bool CBurningVideoDriver::endScene()
 {
 	CNullDriver::endScene();
 
+	flushClear(CLEAR_COLOR);
 	return Presenter->present(BackBuffer, WindowId, SceneSourceRect);
 }
 
@@ -737,13 +1013,7 @@ bool CBurningVideoDriver::setRenderTarget(video::ITexture* texture, bool clearBa
 	}
 
 	if (RenderTargetSurface && (clearBackBuffer || clearZBuffer))
-	{
-		if (clearZBuffer)
-			DepthBuffer->clear();
-
-		if (clearBackBuffer)
-			RenderTargetSurface->fill( color );
-	}
+		markClear((clearBackBuffer ? CLEAR_COLOR : 0) | (clearZBuffer ? CLEAR_DEPTH : 0), color);
 
 	return true;
 }
@@ -752,6 +1022,9 @@ bool CBurningVideoDriver::setRenderTarget(video::ITexture* texture, bool clearBa
 //! sets a render target
 void CBurningVideoDriver::setRenderTarget(video::CImage* image)
 {
+	// the marked tiles belong to the old render target
+	flushClear(CLEAR_COLOR | CLEAR_DEPTH);
+
 	if (RenderTargetSurface)
 		RenderTargetSurface->drop();
 
@@ -772,6 +1045,104 @@ void CBurningVideoDriver::setRenderTarget(video::CImage* image)
 
 	if (StencilBuffer)
 		StencilBuffer->setSize(RenderTargetSize);
+
+	const u32 tileSize = 1 << CDepthBuffer::TILE_SIZE_LOG2;
+	ClearTileColumns = (RenderTargetSize.Width + tileSize - 1) >> CDepthBuffer::TILE_SIZE_LOG2;
+	ClearTiles.set_used(ClearTileColumns * ((RenderTargetSize.Height + tileSize - 1) >> CDepthBuffer::TILE_SIZE_LOG2));
+	if (ClearTiles.size())
+		memset(ClearTiles.pointer(), 0, ClearTiles.size());
+}
+
+
+//! clears buffers of the render target, or marks all their tiles to be cleared later
+void CBurningVideoDriver::markClear(u32 buffers, SColor color)
+{
+	if (!DepthBuffer)
+		buffers &= ~CLEAR_DEPTH;
+
+	if (!RenderTargetSurface || !buffers)
+		return;
+
+#ifdef SOFTWARE_DRIVER_2_FAST_CLEAR
+	if (buffers & CLEAR_COLOR)
+	{
+		switch (RenderTargetSurface->getColorFormat())
+		{
+			case ECF_A8R8G8B8:
+				ClearColor = color.color;
+				break;
+			case ECF_A1R5G5B5:
+				ClearColor = color.toA1R5G5B5();
+				break;
+			default:
+				RenderTargetSurface->fill(color);
+				buffers &= ~CLEAR_COLOR;
+				break;
+		}
+	}
+
+	// the coarse depth buffer has to know the depths right away
+	if (buffers & CLEAR_DEPTH)
+		((CDepthBuffer*) DepthBuffer)->clearFarthest();
+
+	for (u32 i=0; i!=ClearTiles.size(); ++i)
+		ClearTiles[i] |= buffers;
+
+	ClearPending |= buffers;
+#else
+	if (buffers & CLEAR_COLOR)
+		RenderTargetSurface->fill(color);
+
+	if (buffers & CLEAR_DEPTH)
+		DepthBuffer->clear();
+#endif
+}
+
+
+//! clears the marked tiles of some buffers in an area
+void CBurningVideoDriver::clearTiles(s32 x0, s32 y0, s32 x1, s32 y1, u32 buffers)
+{
+	const u32 pitch = RenderTargetSurface->getPitch();
+	const u32 pixelSize = RenderTargetSurface->getBytesPerPixel();
+	u8* const color = (u8*) RenderTargetSurface->lock();
+
+	const s32 tileX0 = x0 >> CDepthBuffer::TILE_SIZE_LOG2;
+	const s32 tileX1 = x1 >> CDepthBuffer::TILE_SIZE_LOG2;
+	const s32 tileY1 = y1 >> CDepthBuffer::TILE_SIZE_LOG2;
+
+	for ( s32 tileY = y0 >> CDepthBuffer::TILE_SIZE_LOG2; tileY <= tileY1; ++tileY )
+	{
+		u8* flag = ClearTiles.pointer() + tileY * ClearTileColumns;
+		for ( s32 tileX = tileX0; tileX <= tileX1; ++tileX )
+		{
+			const u32 clear = flag[tileX] & buffers;
+			if ( !clear )
+				continue;
+
+			flag[tileX] &= ~clear;
+
+			if ( clear & CLEAR_DEPTH )
+				((CDepthBuffer*) DepthBuffer)->clearTile ( tileX, tileY );
+
+			if ( clear & CLEAR_COLOR )
+			{
+				const u32 px = tileX << CDepthBuffer::TILE_SIZE_LOG2;
+				const u32 py = tileY << CDepthBuffer::TILE_SIZE_LOG2;
+				const u32 width = core::min_ ( px + ( 1 << CDepthBuffer::TILE_SIZE_LOG2 ), RenderTargetSize.Width ) - px;
+				const u32 height = core::min_ ( py + ( 1 << CDepthBuffer::TILE_SIZE_LOG2 ), RenderTargetSize.Height ) - py;
+
+				u8* row = color + py * pitch + px * pixelSize;
+				for ( u32 y = 0; y != height; ++y )
+				{
+					if ( pixelSize == 4 )
+						memset32 ( row, ClearColor, width * 4 );
+					else
+						memset16 ( row, (u16) ClearColor, width * 2 );
+					row += pitch;
+				}
+			}
+		}
+	}
 }
 
 
@@ -1195,6 +1566,128 @@ void CBurningVideoDriver::VertexCache_fill(const u32 sourceIndex, const u32 dest
 	const S3DVertex *base = ((S3DVertex*) source );
 	Transformation [ ETS_CURRENT].transformVect ( &dest->Pos.x, base->Pos );
 
+	VertexCache_fillAttributes ( source, dest, clipToFrustumTest ( dest ) );
+}
+
+
+#ifdef SOFTWARE_DRIVER_2_SSE
+
+/*!
+	transform four positions with SSE, in the same order of operations
+	as core::matrix4::transformVect, and return the clip test flags
+*/
+static inline void transformPositions4 ( const __m128 *m, const core::vector3df * const *pos,
+									s4DVertex * const *out, u32 *clip )
+{
+	const __m128 x = _mm_set_ps ( pos[3]->X, pos[2]->X, pos[1]->X, pos[0]->X );
+	const __m128 y = _mm_set_ps ( pos[3]->Y, pos[2]->Y, pos[1]->Y, pos[0]->Y );
+	const __m128 z = _mm_set_ps ( pos[3]->Z, pos[2]->Z, pos[1]->Z, pos[0]->Z );
+
+	__m128 p[4];
+	for ( u32 i = 0; i != 4; ++i )
+	{
+		p[i] = _mm_add_ps ( _mm_add_ps ( _mm_add_ps (
+					_mm_mul_ps ( x, m[i] ), _mm_mul_ps ( y, m[4+i] ) ),
+					_mm_mul_ps ( z, m[8+i] ) ), m[12+i] );
+	}
+
+	// same tests as clipToFrustumTest, one bit of each vertex per mask
+	const __m128 sign = _mm_set1_ps ( -0.f );
+	u32 mask[6];
+#ifdef IRRLICHT_FAST_MATH
+	const __m128 w = _mm_xor_ps ( p[3], sign );
+	mask[0] = _mm_movemask_ps ( _mm_add_ps ( p[2], w ) );
+	mask[1] = _mm_movemask_ps ( _mm_add_ps ( _mm_xor_ps ( p[2], sign ), w ) );
+	mask[2] = _mm_movemask_ps ( _mm_add_ps ( p[0], w ) );
+	mask[3] = _mm_movemask_ps ( _mm_add_ps ( _mm_xor_ps ( p[0], sign ), w ) );
+	mask[4] = _mm_movemask_ps ( _mm_add_ps ( p[1], w ) );
+	mask[5] = _mm_movemask_ps ( _mm_add_ps ( _mm_xor_ps ( p[1], sign ), w ) );
+#else
+	mask[0] = _mm_movemask_ps ( _mm_cmple_ps ( p[2], p[3] ) );
+	mask[1] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( p[2], sign ), p[3] ) );
+	mask[2] = _mm_movemask_ps ( _mm_cmple_ps ( p[0], p[3] ) );
+	mask[3] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( p[0], sign ), p[3] ) );
+	mask[4] = _mm_movemask_ps ( _mm_cmple_ps ( p[1], p[3] ) );
+	mask[5] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( p[1], sign ), p[3] ) );
+#endif
+
+	_MM_TRANSPOSE4_PS ( p[0], p[1], p[2], p[3] );
+
+	for ( u32 i = 0; i != 4; ++i )
+	{
+		_mm_storeu_ps ( &out[i]->Pos.x, p[i] );
+
+		u32 flag = 0;
+		for ( u32 g = 0; g != 6; ++g )
+			flag |= ( ( mask[g] >> i ) & 1 ) << g;
+		clip[i] = flag;
+	}
+}
+
+#endif
+
+
+/*!
+	fill several cache lines, the positions are transformed and clip
+	tested four at a time if the cpu allows
+*/
+void CBurningVideoDriver::VertexCache_fillBlock(const u32 *sourceIndex, const u32 *destIndex, const u32 count)
+{
+	const u32 pitch = vSize[VertexCache.vType].Pitch;
+	u32 clip[VERTEXCACHE_ELEMENT];
+	u32 i = 0;
+
+#ifdef SOFTWARE_DRIVER_2_SSE
+	if ( UseSSE && count >= 4 )
+	{
+		__m128 m[16];
+		const f32 *M = Transformation [ ETS_CURRENT ].pointer();
+		for ( u32 g = 0; g != 16; ++g )
+			m[g] = _mm_set1_ps ( M[g] );
+
+		const core::vector3df *pos[4];
+		s4DVertex *out[4];
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			for ( u32 g = 0; g != 4; ++g )
+			{
+				pos[g] = (const core::vector3df*) ( (const u8*) VertexCache.vertices + sourceIndex[i+g] * pitch );
+				out[g] = (s4DVertex *) ( (u8*) VertexCache.mem.data + ( destIndex[i+g] << ( SIZEOF_SVERTEX_LOG2 + 1 ) ) );
+			}
+			transformPositions4 ( m, pos, out, clip + i );
+		}
+	}
+#endif
+
+	for ( ; i != count; ++i )
+	{
+		const core::vector3df *pos = (const core::vector3df*) ( (const u8*) VertexCache.vertices + sourceIndex[i] * pitch );
+		s4DVertex *dest = (s4DVertex *) ( (u8*) VertexCache.mem.data + ( destIndex[i] << ( SIZEOF_SVERTEX_LOG2 + 1 ) ) );
+		Transformation [ ETS_CURRENT].transformVect ( &dest->Pos.x, *pos );
+		clip[i] = clipToFrustumTest ( dest );
+	}
+
+	for ( i = 0; i != count; ++i )
+	{
+		VertexCache.info[ destIndex[i] ].index = sourceIndex[i];
+		VertexCache.info[ destIndex[i] ].hit = 0;
+
+		VertexCache_fillAttributes (
+			(const u8*) VertexCache.vertices + sourceIndex[i] * pitch,
+			(s4DVertex *) ( (u8*) VertexCache.mem.data + ( destIndex[i] << ( SIZEOF_SVERTEX_LOG2 + 1 ) ) ),
+			clip[i] );
+	}
+}
+
+
+/*!
+	light and texture a vertex of a cache line whose position is transformed,
+	and project it if it is inside the frustum
+*/
+void CBurningVideoDriver::VertexCache_fillAttributes(const u8 *source, s4DVertex *dest, const u32 clip)
+{
+	const S3DVertex *base = ((S3DVertex*) source );
+
 	//mhm ;-) maybe no goto
 	if ( VertexCache.vType == 4 ) goto clipandproject;
 
@@ -1460,7 +1953,7 @@ clipandproject:
 	dest[0].flag = dest[1].flag = vSize[VertexCache.vType].Format;
 
 	// test vertex
-	dest[0].flag |= clipToFrustumTest ( dest);
+	dest[0].flag |= clip;
 
 	// to DC Space, project homogenous vertex
 	if ( (dest[0].flag & VERTEX4D_CLIPMASK ) == VERTEX4D_INSIDE )
@@ -1567,7 +2060,10 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 			}
 		}
 
-		// fill new
+		// fill new, all at once
+		u32 fillSource[VERTEXCACHE_ELEMENT];
+		u32 fillDest[VERTEXCACHE_ELEMENT];
+		u32 fillCount = 0;
 		for ( i = 0; i!= fillIndex; ++i )
 		{
 			if ( info[i].hit != VERTEXCACHE_MISS )
@@ -1577,13 +2073,24 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 			{
 				if ( 0 == VertexCache.info[dIndex].hit )
 				{
-					VertexCache_fill ( info[i].index, dIndex );
+					fillSource[fillCount] = info[i].index;
+					fillDest[fillCount] = dIndex;
+					fillCount += 1;
 					VertexCache.info[dIndex].hit += 1;
 					info[i].hit = dIndex;
 					break;
 				}
 			}
 		}
+
+		if ( fillCount )
+		{
+			VertexCache_fillBlock ( fillSource, fillDest, fillCount );
+			for ( i = 0; i!= fillCount; ++i )
+			{
+				VertexCache.info[ fillDest[i] ].hit += 1;
+			}
+		}
 	}
 
 	const u32 i0 = core::if_c_a_else_0 ( VertexCache.pType != scene::EPT_TRIANGLE_FAN, VertexCache.indicesRun );
@@ -1743,6 +2250,33 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 
 	CNullDriver::drawVertexPrimitiveList(vertices, vertexCount, indexList, primitiveCount, vType, pType, iType);
 
+	// Lines are drawn one by one with the color of their first vertex,
+	// every vertex type starts with the members of S3DVertex.
+	if (pType==scene::EPT_LINES)
+	{
+		const u32 pitch = getVertexPitchFromType(vType);
+		for (u32 l = 0; l < primitiveCount; ++l)
+		{
+			u32 i0 = 2*l;
+			u32 i1 = 2*l + 1;
+			if (indexList && iType==EIT_16BIT)
+			{
+				i0 = ((const u16*)indexList)[i0];
+				i1 = ((const u16*)indexList)[i1];
+			}
+			else if (indexList && iType==EIT_32BIT)
+			{
+				i0 = ((const u32*)indexList)[i0];
+				i1 = ((const u32*)indexList)[i1];
+			}
+
+			const S3DVertex* v0 = (const S3DVertex*)((const u8*)vertices + i0*pitch);
+			const S3DVertex* v1 = (const S3DVertex*)((const u8*)vertices + i1*pitch);
+			draw3DLine(v0->Pos, v1->Pos, v0->Color);
+		}
+		return;
+	}
+
 	// These calls would lead to crashes due to wrong index usage.
 	// The vertex cache needs to be rewritten for these primitives.
 	if (pType==scene::EPT_POINTS || pType==scene::EPT_LINE_STRIP ||
@@ -1753,6 +2287,25 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 	if ( 0 == CurrentShader )
 		return;
 
+	CurrentShaderDepth = DepthBuffer && CurrentShader == BurningShader[CurrentShaderType] ?
+		getDepthUsage ( CurrentShaderType ) : 0;
+
+	// bin the triangles into tiles for the threads, the wire and stencil
+	// renderers draw outside of the rows of a tile, occlusion queries
+	// count the pixels in a single renderer
+	if ( RasterThreads.getThreadCount() > 1 && CurrentShader == BurningShader[CurrentShaderType] &&
+		CurrentShaderType != ETR_TEXTURE_GOURAUD_WIRE && CurrentShaderType != ETR_OCCLUSION_QUERY &&
+		RenderTargetSize.Height )
+	{
+		const u32 tiles = 4 * RasterThreads.getThreadCount();
+		TileHeight = core::max_ ( 16u, ( RenderTargetSize.Height + tiles - 1 ) / tiles );
+		// in whole tiles of the coarse depth buffer
+		const u32 depthTile = 1 << CDepthBuffer::TILE_SIZE_LOG2;
+		TileHeight = ( TileHeight + depthTile - 1 ) & ~( depthTile - 1 );
+		TileCount = ( RenderTargetSize.Height + TileHeight - 1 ) / TileHeight;
+		TilesActive = true;
+	}
+
 	VertexCache_reset ( vertices, vertexCount, indexList, primitiveCount, vType, pType, iType );
 
 	const s4DVertex * face[3];
@@ -1800,7 +2353,7 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 			}
 
 			// rasterize
-			CurrentShader->drawTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
+			rasterizeTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
 			continue;
 		}
 
@@ -1879,13 +2432,16 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 		for ( g = 0; g <= vOut - 6; g += 2 )
 		{
 			// rasterize
-			CurrentShader->drawTriangle ( CurrentOut.data + 0 + 1,
+			rasterizeTriangle ( CurrentOut.data + 0 + 1,
 							CurrentOut.data + g + 3,
 							CurrentOut.data + g + 5);
 		}
 
 	}
 
+	if ( TilesActive )
+		drawTiles ();
+
 	// dump statistics
 /*
 	char buf [64];
@@ -1983,6 +2539,14 @@ u32 CBurningVideoDriver::getMaximalDynamicLightAmount() const
 
 //! sets a material
 void CBurningVideoDriver::setMaterial(const SMaterial& material)
+{
+	++MaterialChanges;
+	setMaterialState(material);
+}
+
+
+//! sets the material without counting it as a material change of the scene
+void CBurningVideoDriver::setMaterialState(const SMaterial& material)
 {
 	Material.org = material;
 
@@ -2193,6 +2757,8 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 					 const core::rect<s32>* clipRect, SColor color,
 					 bool useAlphaChannelOfTexture)
 {
+	flushClear(CLEAR_COLOR);
+
 	if (texture)
 	{
 		if (texture->getDriverType() != EDT_BURNINGSVIDEO)
@@ -2216,12 +2782,14 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 			clipRect = &clip;
 		}
 #endif
+		// same blits as CImage::copyToWithAlpha and copyTo, large ones banded over the raster threads
 		if (useAlphaChannelOfTexture)
-			((CSoftwareTexture2*)texture)->getImage()->copyToWithAlpha(
-			RenderTargetSurface, destPos, sourceRect, color, clipRect);
+			Blit(color.color == 0xFFFFFFFF ? BLITTER_TEXTURE_ALPHA_BLEND : BLITTER_TEXTURE_ALPHA_COLOR_BLEND,
+				RenderTargetSurface, clipRect, &destPos, ((CSoftwareTexture2*)texture)->getImage(),
+				&sourceRect, color.color, &RasterThreads);
 		else
-			((CSoftwareTexture2*)texture)->getImage()->copyTo(
-				RenderTargetSurface, destPos, sourceRect, clipRect);
+			Blit(BLITTER_TEXTURE, RenderTargetSurface, clipRect, &destPos,
+				((CSoftwareTexture2*)texture)->getImage(), &sourceRect, 0, &RasterThreads);
 	}
 }
 
@@ -2231,6 +2799,8 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 		const core::rect<s32>& sourceRect, const core::rect<s32>* clipRect,
 		const video::SColor* const colors, bool useAlphaChannelOfTexture)
 {
+	flushClear(CLEAR_COLOR);
+
 	if (texture)
 	{
 		if (texture->getDriverType() != EDT_BURNINGSVIDEO)
@@ -2241,10 +2811,10 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 
 	if (useAlphaChannelOfTexture)
 		StretchBlit(BLITTER_TEXTURE_ALPHA_BLEND, RenderTargetSurface, &destRect, &sourceRect,
-			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0));
+			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0), &RasterThreads);
 	else
 		StretchBlit(BLITTER_TEXTURE, RenderTargetSurface, &destRect, &sourceRect,
-			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0));
+			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0), &RasterThreads);
 	}
 }
 
@@ -2253,6 +2823,7 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<s32>& start,
 					const core::position2d<s32>& end,
 					SColor color)
 {
+	flushClear(CLEAR_COLOR);
 	drawLine(BackBuffer, start, end, color );
 }
 
@@ -2260,6 +2831,7 @@ void CBurningVideoDriver::draw2DLine(const core::position2d<s32>& start,
 //! Draws a pixel
 void CBurningVideoDriver::drawPixel(u32 x, u32 y, const SColor & color)
 {
+	flushClear(CLEAR_COLOR);
 	BackBuffer->setPixel(x, y, color, true);
 }
 
@@ -2268,6 +2840,8 @@ void CBurningVideoDriver::drawPixel(u32 x, u32 y, const SColor & color)
 void CBurningVideoDriver::draw2DRectangle(SColor color, const core::rect<s32>& pos,
 									 const core::rect<s32>* clip)
 {
+	flushClear(CLEAR_COLOR);
+
 	if (clip)
 	{
 		core::rect<s32> p(pos);
@@ -2277,14 +2851,14 @@ void CBurningVideoDriver::draw2DRectangle(SColor color, const core::rect<s32>& p
 		if(!p.isValid())
 			return;
 
-		drawRectangle(BackBuffer, p, color);
+		drawRectangle(BackBuffer, p, color, &RasterThreads);
 	}
 	else
 	{
 		if(!pos.isValid())
 			return;
 
-		drawRectangle(BackBuffer, pos, color);
+		drawRectangle(BackBuffer, pos, color, &RasterThreads);
 	}
 }
 
@@ -2340,6 +2914,7 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<s32>& position,
 	const core::rect<s32>* clip)
 {
 #ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	flushClear(CLEAR_COLOR);
 
 	core::rect<s32> pos = position;
 
@@ -2451,6 +3026,8 @@ void CBurningVideoDriver::draw2DRectangle(const core::rect<s32>& position,
 void CBurningVideoDriver::draw3DLine(const core::vector3df& start,
 	const core::vector3df& end, SColor color)
 {
+	flushClear(CLEAR_COLOR | CLEAR_DEPTH);
+
 	Transformation [ ETS_CURRENT].transformVect ( &CurrentOut.data[0].Pos.x, start );
 	Transformation [ ETS_CURRENT].transformVect ( &CurrentOut.data[2].Pos.x, end );
 
@@ -2510,6 +3087,92 @@ const wchar_t* CBurningVideoDriver::getName() const
 #endif
 }
 
+//! Run occlusion query. Draws mesh stored in query.
+/** The pixels are counted while drawing, so the result is
+available right after this call. */
+void CBurningVideoDriver::runOcclusionQuery(scene::ISceneNode* node, bool visible)
+{
+	if ( !node )
+		return;
+	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	if ( index == -1 )
+		return;
+
+	IBurningShader *shader = BurningShader [ ETR_OCCLUSION_QUERY ];
+	shader->fetchPassedSamples ();
+	CNullDriver::runOcclusionQuery ( node, false );
+	OcclusionQueries[index].Result = shader->fetchPassedSamples ();
+
+	if ( visible )
+		CNullDriver::runOcclusionQuery ( node, true );
+}
+
+
+//! Update occlusion query. Nothing to do, the result is ready after running the query.
+void CBurningVideoDriver::updateOcclusionQuery(scene::ISceneNode* node, bool block)
+{
+}
+
+
+//! Return query result.
+u32 CBurningVideoDriver::getOcclusionQueryResult(scene::ISceneNode* node) const
+{
+	const s32 index = OcclusionQueries.linear_search(SOccQuery(node));
+	if ( index != -1 )
+		return OcclusionQueries[index].Result;
+	else
+		return ~0;
+}
+
+
+//! Test boxes for visibility against the depth buffer.
+void CBurningVideoDriver::testOcclusionBoxes(const core::aabbox3df* boxes, u32 count, u32* samples)
+{
+	// two triangles for each side, see aabbox3d::getEdges()
+	static const u16 indices[36] =
+	{
+		0, 1, 3,	0, 3, 2,
+		4, 5, 7,	4, 7, 6,
+		0, 2, 6,	0, 6, 4,
+		1, 3, 7,	1, 7, 5,
+		0, 1, 5,	0, 5, 4,
+		2, 3, 7,	2, 7, 6
+	};
+
+	const SMaterial material = Material.org;
+	const core::matrix4 world = Transformation[ETS_WORLD];
+
+	// the camera may be inside of a box, so draw the back faces as well
+	SMaterial query;
+	query.Lighting = false;
+	query.AntiAliasing = 0;
+	query.ColorMask = ECP_NONE;
+	query.GouraudShading = false;
+	query.ZWriteEnable = false;
+	query.BackfaceCulling = false;
+	setMaterialState ( query );
+	setTransform ( ETS_WORLD, core::IdentityMatrix );
+
+	IBurningShader *shader = BurningShader [ ETR_OCCLUSION_QUERY ];
+	shader->fetchPassedSamples ();
+
+	core::vector3df edges[8];
+	S3DVertex vertices[8];
+	for ( u32 i = 0; i != count; ++i )
+	{
+		boxes[i].getEdges ( edges );
+		for ( u32 g = 0; g != 8; ++g )
+			vertices[g].Pos = edges[g];
+
+		drawVertexPrimitiveList ( vertices, 8, indices, 12, EVT_STANDARD, scene::EPT_TRIANGLES, EIT_16BIT );
+		samples[i] = shader->fetchPassedSamples ();
+	}
+
+	setTransform ( ETS_WORLD, world );
+	setMaterialState ( material );
+}
+
+
 //! Returns the graphics card vendor name.
 core::stringc CBurningVideoDriver::getVendorInfo()
 {
@@ -2554,8 +3217,7 @@ ITexture* CBurningVideoDriver::addRenderTargetTexture(const core::dimension2d<u3
 //! Clears the DepthBuffer.
 void CBurningVideoDriver::clearZBuffer()
 {
-	if (DepthBuffer)
-		DepthBuffer->clear();
+	markClear(CLEAR_DEPTH, SColor(0));
 }
 
 
@@ -2565,6 +3227,8 @@ IImage* CBurningVideoDriver::createScreenShot(video::ECOLOR_FORMAT format, video
 	if (target != video::ERT_FRAME_BUFFER)
 		return 0;
 
+	flushClear(CLEAR_COLOR);
+
 	if (BackBuffer)
 	{
 		IImage* tmp = createImage(BackBuffer->getColorFormat(), BackBuffer->getDimension());
@@ -2583,11 +3247,45 @@ ITexture* CBurningVideoDriver::createDeviceDependentTexture(IImage* surface, con
 	return new CSoftwareTexture2(
 		surface, name,
 		(getTextureCreationFlag(ETCF_CREATE_MIP_MAPS) ? CSoftwareTexture2::GEN_MIPMAP : 0 ) |
-		(getTextureCreationFlag(ETCF_ALLOW_NON_POWER_2) ? 0 : CSoftwareTexture2::NP2_SIZE ), mipmapData);
+		(getTextureCreationFlag(ETCF_ALLOW_NON_POWER_2) ? 0 : CSoftwareTexture2::NP2_SIZE ), mipmapData,
+		&RasterThreads);
 
 }
 
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+//! opens the file and loads it into the surface, keeps dxt1 and dxt5 compressed
+ITexture* CBurningVideoDriver::loadTextureFromFile(io::IReadFile* file, const io::path& hashName)
+{
+	core::dimension2d<u32> size;
+	u32 blockSize;
+	u32 mipMapCount;
+
+	file->seek(0);
+	u8* blocks = readDDSBlocks(file, size, blockSize, mipMapCount);
+
+	// the renderers address the texels with masks, other sizes are
+	// decoded and scaled like the textures of other files
+	if (blocks && (size.Width < 4 || size.Height < 4 ||
+		size != size.getOptimalSize(true, false, false, SOFTWARE_DRIVER_2_TEXTURE_MAXSIZE)))
+	{
+		delete [] blocks;
+		blocks = 0;
+	}
+
+	if (!blocks)
+		return CNullDriver::loadTextureFromFile(file, hashName);
+
+	ITexture* texture = new CSoftwareTexture2(blocks, blockSize, size, mipMapCount,
+		hashName.size() ? hashName : file->getFileName(),
+		getTextureCreationFlag(ETCF_CREATE_MIP_MAPS) ? CSoftwareTexture2::GEN_MIPMAP : 0,
+		&RasterThreads);
+	os::Printer::log("Loaded texture", file->getFileName());
+	return texture;
+}
+#endif
+
+
 //! Returns the maximum amount of primitives (mostly vertices) which
 //! the device is able to render with one drawIndexedTriangleList
 //! call.
@@ -2665,6 +3363,9 @@ void CBurningVideoDriver::drawStencilShadow(bool clearStencilBuffer, video::SCol
 {
 	if (!StencilBuffer)
 		return;
+
+	flushClear(CLEAR_COLOR);
+
 	// draw a shadow rectangle covering the entire screen using stencil buffer
 	const u32 h = RenderTargetSurface->getDimension().Height;
 	const u32 w = RenderTargetSurface->getDimension().Width;
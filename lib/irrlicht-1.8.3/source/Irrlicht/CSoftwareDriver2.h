@@ -12,6 +12,7 @@
 #include "os.h"
 #include "irrString.h"
 #include "SIrrCreationParameters.h"
+#include "CThreadPool.h"
 
 namespace irr
 {
@@ -157,15 +158,40 @@ namespace video
 			video::SColor leftDownEdge = video::SColor(0,0,0,0),
 			video::SColor rightDownEdge = video::SColor(0,0,0,0));
 
+		//! Run occlusion query. Draws mesh stored in query.
+		/** The pixels are counted while drawing, so the result is
+		available right after this call. */
+		virtual void runOcclusionQuery(scene::ISceneNode* node, bool visible=false);
+
+		//! Update occlusion query. Nothing to do, the result is ready after running the query.
+		virtual void updateOcclusionQuery(scene::ISceneNode* node, bool block=true);
+
+		//! Return query result.
+		virtual u32 getOcclusionQueryResult(scene::ISceneNode* node) const;
+
+		//! Test boxes for visibility against the depth buffer.
+		virtual void testOcclusionBoxes(const core::aabbox3df* boxes, u32 count, u32* samples);
+
 		//! Returns the graphics card vendor name.
 		virtual core::stringc getVendorInfo();
 
 		//! Returns the maximum texture size supported.
 		virtual core::dimension2du getMaxTextureSize() const;
 
-		virtual IDepthBuffer * getDepthBuffer () { return DepthBuffer; }
+		virtual IDepthBuffer * getDepthBuffer () { flushClear ( CLEAR_DEPTH ); return DepthBuffer; }
 		virtual IStencilBuffer * getStencilBuffer () { return StencilBuffer; }
 
+		//! Sets the number of threads which rasterize triangles.
+		/** With more than one thread, the triangles of each
+		drawVertexPrimitiveList() call are binned into tiles of rows of
+		the render target, and the threads draw the tiles in parallel,
+		each with its own triangle renderers. The image is the same as
+		with one thread. */
+		void setRasterThreadCount(u32 count);
+
+		//! Returns the number of threads which rasterize triangles.
+		u32 getRasterThreadCount() const { return RasterThreads.getThreadCount(); }
+
 	protected:
 
 
@@ -179,6 +205,11 @@ namespace video
 		//! THIS METHOD HAS TO BE OVERRIDDEN BY DERIVED DRIVERS WITH OWN TEXTURES
 		virtual video::ITexture* createDeviceDependentTexture(IImage* surface, const io::path& name, void* mipmapData=0);
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+		//! opens the file and loads it into the surface, keeps dxt1 and dxt5 compressed
+		virtual video::ITexture* loadTextureFromFile(io::IReadFile* file, const io::path& hashName = "");
+#endif
+
 		video::CImage* BackBuffer;
 		video::IImagePresenter* Presenter;
 
@@ -189,12 +220,99 @@ namespace video
 		video::IImage* RenderTargetSurface;
 		core::dimension2d<u32> RenderTargetSize;
 
+		//! sets the material without counting it as a material change of the scene
+		void setMaterialState(const SMaterial& material);
+
 		//! selects the right triangle renderer based on the render states.
 		void setCurrentShader();
 
+		//! sets the render states of a triangle renderer selected by setCurrentShader()
+		void setShaderState(IBurningShader* shader, EBurningFFShader type);
+
+		//! creates the triangle renderers for each EBurningFFShader
+		void createShaders(IBurningShader** shader);
+
 		IBurningShader* CurrentShader;
+		EBurningFFShader CurrentShaderType;
 		IBurningShader* BurningShader[ETR2_COUNT];
 
+		//! draws a triangle with the current shader, or bins it into the tiles
+		void rasterizeTriangle(const s4DVertex* a, const s4DVertex* b, const s4DVertex* c);
+
+		//! draws the rows top to bottom of a triangle, unless the coarse depth buffer hides them
+		void drawTriangle(IBurningShader* shader, const s4DVertex* a, const s4DVertex* b, const s4DVertex* c, s32 top, s32 bottom);
+
+		//! eDepthUsage of the current shader, 0 if it is not the one of CurrentShaderType
+		u32 CurrentShaderDepth;
+
+		//! buffers of the render target which are cleared tile by tile
+		enum eClearBuffer
+		{
+			CLEAR_COLOR = 0x01,
+			CLEAR_DEPTH = 0x02,
+		};
+
+		//! clears buffers of the render target, or marks all their tiles to be cleared later
+		void markClear(u32 buffers, SColor color);
+
+		//! clears the marked tiles of some buffers in an area
+		/** \param x0,y0,x1,y1 Inclusive area in the render target.
+		\param buffers eClearBuffer flags. */
+		void clearTiles(s32 x0, s32 y0, s32 x1, s32 y1, u32 buffers);
+
+		//! clears all marked tiles of some buffers, before they are used other than by drawTriangle()
+		void flushClear(u32 buffers)
+		{
+			if ( ClearPending & buffers )
+			{
+				clearTiles ( 0, 0, RenderTargetSize.Width - 1, RenderTargetSize.Height - 1, buffers );
+				ClearPending &= ~buffers;
+			}
+		}
+
+		//! eClearBuffer flags of each tile of the render target which still has to be cleared
+		core::array<u8> ClearTiles;
+		u32 ClearTileColumns;
+		//! eClearBuffer flags of the buffers which may have marked tiles
+		u32 ClearPending;
+		//! the clear color in the format of the render target
+		u32 ClearColor;
+
+		//! draws the binned triangles on all threads
+		void drawTiles();
+
+		//! draws the binned triangles of a tile
+		void drawTile(u32 tile, u32 thread);
+
+		//! draws the tiles on RasterThreads
+		class CTileJob : public CThreadPool::IJob
+		{
+		public:
+			CTileJob(CBurningVideoDriver* driver) : Driver(driver) {}
+			virtual void run(u32 index, u32 thread) { Driver->drawTile(index, thread); }
+		private:
+			CBurningVideoDriver* Driver;
+		};
+
+		CThreadPool RasterThreads;
+		//! ETR2_COUNT triangle renderers for each thread
+		core::array<IBurningShader*> TileShader;
+		//! triangles are binned instead of drawn
+		bool TilesActive;
+		u32 TileHeight;
+		u32 TileCount;
+		//! three vertices of each binned triangle
+		core::array<s4DVertex> TileVertices;
+		//! textures of the binned triangles, BURNING_MATERIAL_MAX_TEXTURES each
+		core::array<sInternalTexture> TileTextures;
+		//! first of TileTextures for each binned triangle
+		core::array<u32> TileTriangleTextures;
+		//! first and last tile of each binned triangle
+		core::array<u32> TileTriangleRange;
+		//! triangles of each tile, tile i uses TileFirst[i] to TileFirst[i+1]-1
+		core::array<u32> TileFirst;
+		core::array<u32> TileTriangles;
+
 		IDepthBuffer* DepthBuffer;
 		IStencilBuffer* StencilBuffer;
 
@@ -242,6 +360,11 @@ namespace video
 		void VertexCache_getbypass ( s4DVertex ** face );
 
 		void VertexCache_fill ( const u32 sourceIndex,const u32 destIndex );
+		void VertexCache_fillBlock ( const u32 *sourceIndex, const u32 *destIndex, const u32 count );
+		void VertexCache_fillAttributes ( const u8 *source, s4DVertex *dest, const u32 clip );
+
+		//! the cpu supports SOFTWARE_DRIVER_2_SSE
+		bool UseSSE;
 		s4DVertex * VertexCache_getVertex ( const u32 sourceIndex );
 
 
@@ -15,10 +15,14 @@ namespace irr
 namespace video
 {
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+u32 CSoftwareTexture2::BlockGeneration = 0;
+#endif
+
 //! constructor
 CSoftwareTexture2::CSoftwareTexture2(IImage* image, const io::path& name,
-		u32 flags, void* mipmapData)
-		: ITexture(name), MipMapLOD(0), Flags ( flags ), OriginalFormat(video::ECF_UNKNOWN)
+		u32 flags, void* mipmapData, CThreadPool* threads)
+		: ITexture(name), Threads(threads), MipMapLOD(0), Flags ( flags ), OriginalFormat(video::ECF_UNKNOWN)
 {
 	#ifdef _DEBUG
 	setDebugName("CSoftwareTexture2");
@@ -29,6 +33,14 @@ CSoftwareTexture2::CSoftwareTexture2(IImage* image, const io::path& name,
 	#endif
 
 	memset32 ( MipMap, 0, sizeof ( MipMap ) );
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	memset32 ( Tiles, 0, sizeof ( Tiles ) );
+#endif
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	BlockData = 0;
+	memset32 ( Blocks, 0, sizeof ( Blocks ) );
+	BlockSize = 0;
+#endif
 
 	if (image)
 	{
@@ -74,6 +86,57 @@ CSoftwareTexture2::CSoftwareTexture2(IImage* image, const io::path& name,
 }
 
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+//! constructor for dxt1 or dxt5 compressed blocks
+CSoftwareTexture2::CSoftwareTexture2(u8* blocks, u32 blockSize, const core::dimension2d<u32>& size,
+		u32 mipMapCount, const io::path& name, u32 flags, CThreadPool* threads)
+		: ITexture(name), BlockData(blocks), BlockSize(blockSize),
+		OrigImageDataSizeInPixels((f32) 0.3f * size.getArea()), OrigSize(size),
+		Threads(threads), MipMapLOD(0), Flags ( flags | HAS_ALPHA ), OriginalFormat(video::ECF_A8R8G8B8)
+{
+	#ifdef _DEBUG
+	setDebugName("CSoftwareTexture2");
+	#endif
+
+	#ifndef SOFTWARE_DRIVER_2_MIPMAPPING
+		Flags &= ~GEN_MIPMAP;
+	#endif
+
+	memset32 ( MipMap, 0, sizeof ( MipMap ) );
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	memset32 ( Tiles, 0, sizeof ( Tiles ) );
+#endif
+	memset32 ( Blocks, 0, sizeof ( Blocks ) );
+
+	// the levels of the file halve the size, the ones of the renderers
+	// shift it by SOFTWARE_DRIVER_2_MIPMAPPING_SCALE. levels smaller
+	// than a block are decoded
+	const u8* levelBlocks = blocks;
+	core::dimension2d<u32> levelSize ( size );
+	for ( u32 i = 0; i != mipMapCount; ++i )
+	{
+		if ( ( i % SOFTWARE_DRIVER_2_MIPMAPPING_SCALE ) == 0 )
+		{
+			const u32 level = i / SOFTWARE_DRIVER_2_MIPMAPPING_SCALE;
+			if ( level == SOFTWARE_DRIVER_2_MIPMAPPING_MAX ||
+				levelSize.Width < 4 || levelSize.Height < 4 ||
+				( level && !( Flags & GEN_MIPMAP ) ) )
+				break;
+
+			Blocks[level] = levelBlocks;
+			BlockLevelSize[level] = levelSize;
+		}
+
+		levelBlocks += ( ( levelSize.Width + 3 ) >> 2 ) * ( ( levelSize.Height + 3 ) >> 2 ) * blockSize;
+		levelSize.Width = core::max_ ( levelSize.Width >> 1, 1u );
+		levelSize.Height = core::max_ ( levelSize.Height >> 1, 1u );
+	}
+
+	createBlockLevels ();
+}
+#endif
+
+
 //! destructor
 CSoftwareTexture2::~CSoftwareTexture2()
 {
@@ -81,7 +144,13 @@ CSoftwareTexture2::~CSoftwareTexture2()
 	{
 		if ( MipMap[i] )
 			MipMap[i]->drop();
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+		delete [] Tiles[i];
+#endif
 	}
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	deleteBlocks ();
+#endif
 }
 
 
@@ -89,8 +158,27 @@ CSoftwareTexture2::~CSoftwareTexture2()
 //! modifying the texture
 void CSoftwareTexture2::regenerateMipMapLevels(void* mipmapData)
 {
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	// the levels of unchanged blocks are kept, a changed first level
+	// replaces all blocks
+	if ( BlockData )
+	{
+		if ( Blocks[0] )
+		{
+			createBlockLevels ();
+			return;
+		}
+		deleteBlocks ();
+	}
+#endif
+
 	if ( !hasMipMaps () )
+	{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+		updateTiles ( 0 );
+#endif
 		return;
+	}
 
 	s32 i;
 
@@ -141,13 +229,239 @@ void CSoftwareTexture2::regenerateMipMapLevels(void* mipmapData)
 		else
 		{
 			MipMap[i] = new CImage(BURNINGSHADER_COLOR_FORMAT, newSize);
+		}
+	}
+
+	// all levels at once, each is summed up from the one before
+	if ( !mipmapData )
+	{
+		IImage* levels[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+		for ( i = 1; i < SOFTWARE_DRIVER_2_MIPMAPPING_MAX; ++i )
+			levels[i-1] = MipMap[i];
+		MipMap[0]->copyToMipMapLevels ( levels, SOFTWARE_DRIVER_2_MIPMAPPING_MAX - 1, Threads );
+	}
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	for ( i = 0; i < SOFTWARE_DRIVER_2_MIPMAPPING_MAX; ++i )
+		updateTiles ( i );
+#endif
+}
+
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+//! returns the image of a mip map level
+CImage* CSoftwareTexture2::getLevel(u32 level) const
+{
+	if ( MipMap[level] )
+		return MipMap[level];
+
+	const core::dimension2d<u32>& dim = BlockLevelSize[level];
+	MipMap[level] = new CImage ( BURNINGSHADER_COLOR_FORMAT, dim );
+
+	const u32 pitch = MipMap[level]->getPitch ();
+	u8* dst = (u8*) MipMap[level]->lock ();
+	const u8* src = Blocks[level];
+	for ( u32 y = 0; y < dim.Height; y += 4 )
+	{
+		for ( u32 x = 0; x < dim.Width; x += 4 )
+		{
+			decodeBlock ( dst + ( x << VIDEO_SAMPLE_GRANULARITY ), pitch, src, BlockSize );
+			src += BlockSize;
+		}
+		dst += pitch << 2;
+	}
+	MipMap[level]->unlock ();
+
+	return MipMap[level];
+}
+
+
+//! creates the mip map levels the blocks do not cover
+void CSoftwareTexture2::createBlockLevels()
+{
+	u32 i;
+	for ( i = 1; i < SOFTWARE_DRIVER_2_MIPMAPPING_MAX && Blocks[i]; ++i )
+		;
+
+	if ( !hasMipMaps () || i == SOFTWARE_DRIVER_2_MIPMAPPING_MAX )
+		return;
+
+	// summed up from the last level with blocks, which is decoded only
+	// for this if the renderers do not need it decoded anyway
+	const bool keep = MipMap[i-1] != 0;
+	CImage* source = getLevel ( i - 1 );
+
+	IImage* levels[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+	core::dimension2d<u32> newSize = source->getDimension ();
+	for ( u32 k = i; k < SOFTWARE_DRIVER_2_MIPMAPPING_MAX; ++k )
+	{
+		newSize.Width = core::s32_max ( 1, newSize.Width >> SOFTWARE_DRIVER_2_MIPMAPPING_SCALE );
+		newSize.Height = core::s32_max ( 1, newSize.Height >> SOFTWARE_DRIVER_2_MIPMAPPING_SCALE );
+		if ( MipMap[k] )
+			MipMap[k]->drop ();
+		MipMap[k] = new CImage ( BURNINGSHADER_COLOR_FORMAT, newSize );
+		levels[k-i] = MipMap[k];
+	}
+	source->copyToMipMapLevels ( levels, SOFTWARE_DRIVER_2_MIPMAPPING_MAX - i, Threads );
 
-			//static u32 color[] = { 0, 0xFFFF0000, 0xFF00FF00,0xFF0000FF,0xFFFFFF00,0xFFFF00FF,0xFF00FFFF,0xFF0F0F0F };
-			MipMap[i]->fill ( 0 );
-			MipMap[0]->copyToScalingBoxFilter( MipMap[i], 0, false );
+	if ( !keep )
+	{
+		MipMap[i-1]->drop ();
+		MipMap[i-1] = 0;
+	}
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	for ( ; i < SOFTWARE_DRIVER_2_MIPMAPPING_MAX; ++i )
+		updateTiles ( i );
+#endif
+}
+
+
+//! deletes the blocks, levels which are not decoded yet are lost
+void CSoftwareTexture2::deleteBlocks()
+{
+	if ( !BlockData )
+		return;
+
+	memset32 ( Blocks, 0, sizeof ( Blocks ) );
+	delete [] BlockData;
+	BlockData = 0;
+	BlockSize = 0;
+
+	// the memory may hold other blocks later
+	++BlockGeneration;
+}
+
+
+//! decodes a dxt1 or dxt5 block into 4x4 texels of BURNINGSHADER_COLOR_FORMAT
+void CSoftwareTexture2::decodeBlock(void* texels, u32 pitch, const u8* block, u32 blockSize)
+{
+	// dxt5 has an alpha block in front of the color block
+	const u8* colorBlock = block + blockSize - 8;
+
+	// expand the two 565 colors to 888 and interpolate the others
+	u32 color[4][4];
+	const u32 c0 = colorBlock[0] | ( colorBlock[1] << 8 );
+	const u32 c1 = colorBlock[2] | ( colorBlock[3] << 8 );
+	for ( u32 i = 0; i != 2; ++i )
+	{
+		const u32 c = i ? c1 : c0;
+		color[i][0] = ( ( c >> 11 ) << 3 ) | ( c >> 13 );
+		color[i][1] = ( ( ( c >> 5 ) & 0x3F ) << 2 ) | ( ( c >> 9 ) & 0x03 );
+		color[i][2] = ( ( c & 0x1F ) << 3 ) | ( ( c >> 2 ) & 0x07 );
+		color[i][3] = 0xFF;
+	}
+	for ( u32 k = 0; k != 3; ++k )
+	{
+		if ( c0 > c1 )
+		{
+			color[2][k] = ( color[0][k] * 2 + color[1][k] ) / 3;
+			color[3][k] = ( color[0][k] + color[1][k] * 2 ) / 3;
+		}
+		else
+		{
+			color[2][k] = ( color[0][k] + color[1][k] ) / 2;
+			color[3][k] = k ? 0xFF : 0x00;
+		}
+	}
+	color[2][3] = 0xFF;
+	color[3][3] = c0 > c1 ? 0xFF : 0x00;
+
+	u32 palette[4];
+	for ( u32 i = 0; i != 4; ++i )
+		palette[i] = ( color[i][3] << 24 ) | ( color[i][0] << 16 ) | ( color[i][1] << 8 ) | color[i][2];
+
+	u32 alpha[8];
+	if ( blockSize == 16 )
+	{
+		alpha[0] = block[0];
+		alpha[1] = block[1];
+		if ( alpha[0] > alpha[1] )
+		{
+			for ( u32 i = 1; i != 7; ++i )
+				alpha[i+1] = ( ( 7 - i ) * alpha[0] + i * alpha[1] ) / 7;
+		}
+		else
+		{
+			for ( u32 i = 1; i != 5; ++i )
+				alpha[i+1] = ( ( 5 - i ) * alpha[0] + i * alpha[1] ) / 5;
+			alpha[6] = 0;
+			alpha[7] = 255;
+		}
+	}
+
+	u32 colorBits = colorBlock[4] | ( colorBlock[5] << 8 ) | ( colorBlock[6] << 16 ) | ( colorBlock[7] << 24 );
+	for ( u32 y = 0; y != 4; ++y )
+	{
+		// 3 bits of alpha for each texel, 24 bits for two rows
+		u32 alphaBits = 0;
+		if ( blockSize == 16 )
+		{
+			const u8* a = block + 2 + ( y >> 1 ) * 3;
+			alphaBits = ( a[0] | ( a[1] << 8 ) | ( a[2] << 16 ) ) >> ( ( y & 1 ) * 12 );
+		}
+
+		tVideoSample* dst = (tVideoSample*) ( (u8*) texels + y * pitch );
+		for ( u32 x = 0; x != 4; ++x )
+		{
+			u32 texel = palette [ colorBits & 3 ];
+			colorBits >>= 2;
+			if ( blockSize == 16 )
+			{
+				texel = ( texel & 0x00FFFFFF ) | ( alpha [ alphaBits & 7 ] << 24 );
+				alphaBits >>= 3;
+			}
+#ifdef SOFTWARE_DRIVER_2_32BIT
+			dst[x] = texel;
+#else
+			dst[x] = A8R8G8B8toA1R5G5B5 ( texel );
+#endif
+		}
+	}
+}
+#endif
+
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+//! copies the texels of a mip map level into its tiles
+void CSoftwareTexture2::updateTiles(u32 level)
+{
+	delete [] Tiles[level];
+	Tiles[level] = 0;
+
+	// render targets are written row by row, the renderers address
+	// tiles with the masks of power of two sizes
+	CImage* image = MipMap[level];
+	if ( !image || ( Flags & IS_RENDERTARGET ) )
+		return;
+
+	const core::dimension2d<u32>& dim = image->getDimension();
+	const u32 tileSize = 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2;
+	if ( dim.Width < tileSize || dim.Height < tileSize ||
+		( dim.Width & ( dim.Width - 1 ) ) || ( dim.Height & ( dim.Height - 1 ) ) )
+		return;
+
+	const u32 pitch = image->getPitch();
+	const u32 rowSize = tileSize << VIDEO_SAMPLE_GRANULARITY;
+	Tiles[level] = new u8 [ pitch * dim.Height ];
+
+	const u8* src = (const u8*) image->lock();
+	u8* dst = Tiles[level];
+	for ( u32 y = 0; y < dim.Height; y += tileSize )
+	{
+		for ( u32 x = 0; x < dim.Width; x += tileSize )
+		{
+			const u8* row = src + y * pitch + ( x << VIDEO_SAMPLE_GRANULARITY );
+			for ( u32 i = 0; i != tileSize; ++i )
+			{
+				memcpy ( dst, row, rowSize );
+				dst += rowSize;
+				row += pitch;
+			}
 		}
 	}
 }
+#endif
 
 
 } // end namespace video
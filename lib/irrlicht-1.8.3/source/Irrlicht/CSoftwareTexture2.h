@@ -30,7 +30,18 @@ public:
 		NP2_SIZE	= 4,
 		HAS_ALPHA	= 8
 	};
-	CSoftwareTexture2(IImage* surface, const io::path& name, u32 flags, void* mipmapData=0);
+	CSoftwareTexture2(IImage* surface, const io::path& name, u32 flags, void* mipmapData=0,
+		CThreadPool* threads=0);
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! constructor for dxt1 (blockSize 8) or dxt5 (blockSize 16) compressed blocks
+	/** The blocks of mipMapCount levels, each half the size of the one
+	before, are taken over and deleted with delete []. The size must be
+	a power of two of at least 4x4 texels. Levels the blocks do not cover
+	are decoded and stored like the levels of other textures. */
+	CSoftwareTexture2(u8* blocks, u32 blockSize, const core::dimension2d<u32>& size,
+		u32 mipMapCount, const io::path& name, u32 flags, CThreadPool* threads=0);
+#endif
 
 	//! destructor
 	virtual ~CSoftwareTexture2();
@@ -40,13 +51,24 @@ public:
 	{
 		if (Flags & GEN_MIPMAP)
 			MipMapLOD=mipmapLevel;
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+		// the decoded level replaces the blocks once it may be changed
+		CImage* image = getLevel(MipMapLOD);
+		if (mode != ETLM_READ_ONLY)
+			Blocks[MipMapLOD] = 0;
+		return image->lock();
+#else
 		return MipMap[MipMapLOD]->lock();
+#endif
 	}
 
 	//! unlock function
 	virtual void unlock()
 	{
 		MipMap[MipMapLOD]->unlock();
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+		updateTiles(MipMapLOD);
+#endif
 	}
 
 	//! Returns original size of the texture.
@@ -66,21 +88,63 @@ public:
 	//! Returns (=size) of the texture.
 	virtual const core::dimension2d<u32>& getSize() const
 	{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+		if (!MipMap[MipMapLOD])
+			return BlockLevelSize[MipMapLOD];
+#endif
 		return MipMap[MipMapLOD]->getDimension();
 	}
 
 	//! returns unoptimized surface
 	virtual CImage* getImage() const
 	{
-		return MipMap[0];
+		return getLevel(0);
 	}
 
 	//! returns texture surface
 	virtual CImage* getTexture() const
 	{
-		return MipMap[MipMapLOD];
+		return getLevel(MipMapLOD);
+	}
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	//! returns the texels of the current mip map level in tiles, 0 if it has no tiles
+	/** The tiles of SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 texels edge
+	length are stored row by row, their texels as well. */
+	const void* getTiles() const
+	{
+		return Tiles[MipMapLOD];
+	}
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! selects a mip map level like lock(), returns its blocks or 0 if it has none
+	/** The blocks of a level are stored row by row. */
+	const u8* lockBlocks(u32 mipmapLevel)
+	{
+		if (Flags & GEN_MIPMAP)
+			MipMapLOD=mipmapLevel;
+		return Blocks[MipMapLOD];
 	}
 
+	//! returns the size of a block in bytes, 8 for dxt1 and 16 for dxt5
+	u32 getBlockSize() const
+	{
+		return BlockSize;
+	}
+
+	//! decodes a dxt1 or dxt5 block into 4x4 texels of BURNINGSHADER_COLOR_FORMAT
+	static void decodeBlock(void* texels, u32 pitch, const u8* block, u32 blockSize);
+
+	//! changes each time the blocks of a texture are deleted
+	/** Caches of decoded blocks, which tell the blocks apart by their
+	address, have to be emptied when this changes. */
+	static u32 getBlockGeneration()
+	{
+		return BlockGeneration;
+	}
+#endif
+
 
 	//! returns driver type of texture (=the driver, who created the texture)
 	virtual E_DRIVER_TYPE getDriverType() const
@@ -97,7 +161,7 @@ public:
 	//! returns pitch of texture (in bytes)
 	virtual u32 getPitch() const
 	{
-		return MipMap[MipMapLOD]->getPitch();
+		return getLevel(MipMapLOD)->getPitch();
 	}
 
 	//! Regenerates the mip map levels of the texture. Useful after locking and
@@ -123,10 +187,51 @@ public:
 	}
 
 private:
+	//! returns the image of a mip map level
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	CImage* getLevel(u32 level) const;
+#else
+	CImage* getLevel(u32 level) const
+	{
+		return MipMap[level];
+	}
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! creates the mip map levels the blocks do not cover
+	void createBlockLevels();
+
+	//! deletes the blocks, levels which are not decoded yet are lost
+	void deleteBlocks();
+
+	//! all blocks of the texture, 0 if it is not compressed
+	u8* BlockData;
+
+	//! blocks of each mip map level, 0 for levels which are stored decoded
+	const u8* Blocks[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+	core::dimension2d<u32> BlockLevelSize[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+	u32 BlockSize;
+
+	static u32 BlockGeneration;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	//! copies the texels of a mip map level into its tiles
+	void updateTiles(u32 level);
+
+	//! copy of each mip map level in tiles, 0 for levels the renderers read
+	//! from the image, like render targets or levels too small for tiles
+	u8* Tiles[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+#endif
+
 	f32 OrigImageDataSizeInPixels;
 	core::dimension2d<u32> OrigSize;
 
-	CImage * MipMap[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+	//! levels which are only stored as blocks are decoded on first use
+	mutable CImage * MipMap[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+
+	//! threads of the driver which generate the mip map levels, may be 0
+	CThreadPool* Threads;
 
 	u32 MipMapLOD;
 	u32 Flags;
@@ -24,7 +24,10 @@ CSphereSceneNode::CSphereSceneNode(f32 radius, u32 polyCountX, u32 polyCountY, I
 	setDebugName("CSphereSceneNode");
 	#endif
 
-	Mesh = SceneManager->getGeometryCreator()->createSphereMesh(radius, polyCountX, polyCountY);
+	// the mesh is shared by all spheres of this size, so the material is kept here
+	Mesh = SceneManager->getGeometryCreator()->getSharedSphereMesh(radius, polyCountX, polyCountY);
+	if (Mesh)
+		Material = Mesh->getMeshBuffer(0)->getMaterial();
 }
 
 
@@ -46,7 +49,7 @@ void CSphereSceneNode::render()
 
 	if (Mesh && driver)
 	{
-		driver->setMaterial(Mesh->getMeshBuffer(0)->getMaterial());
+		driver->setMaterial(Material);
 		driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
 		if (Shadow)
 			Shadow->updateShadowVolumes();
@@ -123,7 +126,7 @@ video::SMaterial& CSphereSceneNode::getMaterial(u32 i)
 	if (i>0 || !Mesh)
 		return ISceneNode::getMaterial(i);
 	else
-		return Mesh->getMeshBuffer(i)->getMaterial();
+		return Material;
 }
 
 
@@ -166,7 +169,7 @@ void CSphereSceneNode::deserializeAttributes(io::IAttributes* in, io::SAttribute
 	{
 		if (Mesh)
 			Mesh->drop();
-		Mesh = SceneManager->getGeometryCreator()->createSphereMesh(Radius, PolyCountX, PolyCountY);
+		Mesh = SceneManager->getGeometryCreator()->getSharedSphereMesh(Radius, PolyCountX, PolyCountY);
 	}
 
 	ISceneNode::deserializeAttributes(in, options);
@@ -184,7 +187,7 @@ ISceneNode* CSphereSceneNode::clone(ISceneNode* newParent, ISceneManager* newMan
 		newManager, ID, RelativeTranslation);
 
 	nb->cloneMembers(this, newManager);
-	nb->getMaterial(0) = Mesh->getMeshBuffer(0)->getMaterial();
+	nb->getMaterial(0) = Material;
 	nb->Shadow = Shadow;
 	if ( nb->Shadow )
 		nb->Shadow->grab();
@@ -59,6 +59,7 @@ namespace scene
 		virtual void setMesh(IMesh* mesh) {}
 
 		//! Returns the current mesh
+		/** It is shared with all spheres of the same size and must not be modified. */
 		virtual IMesh* getMesh() { return Mesh; }
 
 		//! Sets if the scene node should not copy the materials of the mesh but use them in a read only style.
@@ -83,6 +84,7 @@ namespace scene
 
 		IMesh* Mesh;
 		IShadowVolumeSceneNode* Shadow;
+		video::SMaterial Material;
 		core::aabbox3d<f32> Box;
 		f32 Radius;
 		u32 PolyCountX;
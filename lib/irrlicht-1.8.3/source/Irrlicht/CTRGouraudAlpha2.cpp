@@ -150,6 +150,12 @@ void CTRGouraudAlpha2::scanline_bilinear ()
 	if ( dx < 0 )
 		return;
 
+#ifdef CMP_W
+	// skip spans the coarse depth buffer hides completely
+	if ( DepthBuffer->isHidden ( xStart, line.y, xEnd, line.y, core::max_ ( line.w[0], line.w[1] ) ) )
+		return;
+#endif
+
 	// slopes
 	const f32 invDeltaX = core::reciprocal_approxim ( line.x[1] - line.x[0] );
 
@@ -433,8 +439,11 @@ void CTRGouraudAlpha2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,cons
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ( );
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ( );
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -593,8 +602,11 @@ void CTRGouraudAlpha2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,cons
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ( );
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ( );
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -431,8 +431,11 @@ void CTRGouraudAlphaNoZ2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,c
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -591,8 +594,11 @@ void CTRGouraudAlphaNoZ2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,c
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -26,16 +26,16 @@
 
 // define render case
 #define SUBTEXEL
-#define INVERSE_W
+//#define INVERSE_W
 
 #define USE_ZBUFFER
 #define IPOL_W
 #define CMP_W
-#define WRITE_W
+//#define WRITE_W
 
-#define IPOL_C0
-#define IPOL_T0
-#define IPOL_T1
+//#define IPOL_C0
+//#define IPOL_T0
+//#define IPOL_T1
 
 // apply global override
 #ifndef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
@@ -50,7 +50,6 @@
 	#undef IPOL_C0
 #endif
 
-
 #if !defined ( SOFTWARE_DRIVER_2_USE_WBUFFER ) && defined ( USE_ZBUFFER )
 	#ifndef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
 		#undef IPOL_W
@@ -76,41 +75,52 @@ namespace irr
 namespace video
 {
 
-class CTRTextureDetailMap2 : public IBurningShader
+class CTROcclusionQuery : public IBurningShader
 {
 public:
 
 	//! constructor
-	CTRTextureDetailMap2(CBurningVideoDriver* driver);
+	CTROcclusionQuery(CBurningVideoDriver* driver);
 
-	//! draws an indexed triangle list
+	//! counts the visible pixels of a triangle
 	virtual void drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c );
 
+	//! returns the number of visible pixels since the last call
+	virtual u32 fetchPassedSamples ();
+
 
 private:
-	void scanline_bilinear ();
+	void scanline ();
 	sScanConvertData scan;
 	sScanLineData line;
 
+	u32 PassedSamples;
 };
 
 //! constructor
-CTRTextureDetailMap2::CTRTextureDetailMap2(CBurningVideoDriver* driver)
-: IBurningShader(driver)
+CTROcclusionQuery::CTROcclusionQuery(CBurningVideoDriver* driver)
+: IBurningShader(driver), PassedSamples(0)
 {
 	#ifdef _DEBUG
-	setDebugName("CTRTextureDetailMap2");
+	setDebugName("CTROcclusionQuery");
 	#endif
 }
 
 
 
+//! returns the number of visible pixels since the last call
+u32 CTROcclusionQuery::fetchPassedSamples ()
+{
+	const u32 samples = PassedSamples;
+	PassedSamples = 0;
+	return samples;
+}
+
+
 /*!
 */
-void CTRTextureDetailMap2::scanline_bilinear ()
+void CTROcclusionQuery::scanline ()
 {
-	tVideoSample *dst;
-
 #ifdef USE_ZBUFFER
 	fp24 *z;
 #endif
@@ -119,7 +129,6 @@ void CTRTextureDetailMap2::scanline_bilinear ()
 	s32 xEnd;
 	s32 dx;
 
-
 #ifdef SUBTEXEL
 	f32 subPixel;
 #endif
@@ -146,6 +155,12 @@ void CTRTextureDetailMap2::scanline_bilinear ()
 	if ( dx < 0 )
 		return;
 
+#ifdef CMP_W
+	// skip spans the coarse depth buffer hides completely
+	if ( DepthBuffer->isHidden ( xStart, line.y, xEnd, line.y, core::max_ ( line.w[0], line.w[1] ) ) )
+		return;
+#endif
+
 	// slopes
 	const f32 invDeltaX = core::reciprocal_approxim ( line.x[1] - line.x[0] );
 
@@ -184,24 +199,11 @@ void CTRTextureDetailMap2::scanline_bilinear ()
 #endif
 #endif
 
-	dst = (tVideoSample*)RenderTarget->lock() + ( line.y * RenderTarget->getDimension().Width ) + xStart;
-
 #ifdef USE_ZBUFFER
 	z = (fp24*) DepthBuffer->lock() + ( line.y * RenderTarget->getDimension().Width ) + xStart;
 #endif
 
-
-#ifdef INVERSE_W
-	f32 inversew;
-#endif
-
-	tFixPoint tx0, tx1;
-	tFixPoint ty0, ty1;
-
-	tFixPoint r0, g0, b0;
-	tFixPoint r1, g1, b1;
-	tFixPoint r2, g2, b2;
-
+	u32 samples = 0;
 
 	for ( s32 i = 0; i <= dx; ++i )
 	{
@@ -211,70 +213,25 @@ void CTRTextureDetailMap2::scanline_bilinear ()
 #ifdef CMP_W
 		if ( line.w[0] >= z[i] )
 #endif
-
-		{
-#ifdef INVERSE_W
-			inversew = fix_inverse32 ( line.w[0] );
-
-			tx0 = tofix ( line.t[0][0].x,inversew);
-			ty0 = tofix ( line.t[0][0].y,inversew);
-			tx1 = tofix ( line.t[1][0].x,inversew);
-			ty1 = tofix ( line.t[1][0].y,inversew);
-
-#else
-			tx0 = tofix ( line.t[0][0].x );
-			ty0 = tofix ( line.t[0][0].y );
-			tx1 = tofix ( line.t[1][0].x );
-			ty1 = tofix ( line.t[1][0].y );
-#endif
-			getSample_texture ( r0, g0, b0, &IT[0], tx0,ty0 );
-			getSample_texture ( r1, g1, b1, &IT[1], tx1,ty1 );
-
-			// bias half color
-			r1 += -FIX_POINT_HALF_COLOR;
-			g1 += -FIX_POINT_HALF_COLOR;
-			b1 += -FIX_POINT_HALF_COLOR;
-
-			r2 = clampfix_mincolor ( clampfix_maxcolor ( r0 + r1 ) );
-			g2 = clampfix_mincolor ( clampfix_maxcolor ( g0 + g1 ) );
-			b2 = clampfix_mincolor ( clampfix_maxcolor ( b0 + b1 ) );
-
-			dst[i] = fix_to_color ( r2, g2, b2 );
-
-#ifdef WRITE_Z
-			z[i] = line.z[0];
-#endif
-#ifdef WRITE_W
-			z[i] = line.w[0];
-#endif
-
-		}
+			samples += 1;
 
 #ifdef IPOL_Z
 		line.z[0] += slopeZ;
 #endif
 #ifdef IPOL_W
 		line.w[0] += slopeW;
-#endif
-#ifdef IPOL_C0
-		line.c[0][0] += slopeC;
-#endif
-#ifdef IPOL_T0
-		line.t[0][0] += slopeT[0];
-#endif
-#ifdef IPOL_T1
-		line.t[1][0] += slopeT[1];
 #endif
 	}
 
+	PassedSamples += samples;
 }
 
-void CTRTextureDetailMap2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c )
+void CTROcclusionQuery::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c )
 {
 	// sort on height, y
-	if ( F32_A_GREATER_B ( a->Pos.y , b->Pos.y ) ) swapVertexPointer(&a, &b);
-	if ( F32_A_GREATER_B ( b->Pos.y , c->Pos.y ) ) swapVertexPointer(&b, &c);
-	if ( F32_A_GREATER_B ( a->Pos.y , b->Pos.y ) ) swapVertexPointer(&a, &b);
+	if ( a->Pos.y > b->Pos.y ) swapVertexPointer(&a, &b);
+	if ( a->Pos.y > c->Pos.y ) swapVertexPointer(&a, &c);
+	if ( b->Pos.y > c->Pos.y ) swapVertexPointer(&b, &c);
 
 	const f32 ca = c->Pos.y - a->Pos.y;
 	const f32 ba = b->Pos.y - a->Pos.y;
@@ -335,6 +292,7 @@ void CTRTextureDetailMap2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,
 	f32 subPixel;
 #endif
 
+
 	// rasterize upper sub-triangle
 	if ( (f32) 0.0 != scan.invDeltaY[1]  )
 	{
@@ -436,8 +394,11 @@ void CTRTextureDetailMap2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -596,8 +557,11 @@ void CTRTextureDetailMap2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,
 			line.t[1][scan.right] = scan.t[1][1];
 #endif
 
-			// render a scanline
-			scanline_bilinear ();
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -630,8 +594,10 @@ void CTRTextureDetailMap2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,
 		}
 	}
 
+
 }
 
+
 } // end namespace video
 } // end namespace irr
 
@@ -642,11 +608,11 @@ namespace irr
 namespace video
 {
 
-//! creates a flat triangle renderer
-IBurningShader* createTriangleRendererTextureDetailMap2(CBurningVideoDriver* driver)
+//! creates a triangle renderer which counts the visible pixels of occlusion queries
+IBurningShader* createTROcclusionQuery(CBurningVideoDriver* driver)
 {
 	#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
-	return new CTRTextureDetailMap2(driver);
+	return new CTROcclusionQuery(driver);
 	#else
 	return 0;
 	#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
@@ -657,3 +623,4 @@ IBurningShader* createTriangleRendererTextureDetailMap2(CBurningVideoDriver* dri
 } // end namespace irr
 
 
+
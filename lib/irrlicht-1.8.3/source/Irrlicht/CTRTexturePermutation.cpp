@@ -0,0 +1,773 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#include "IBurningShader.h"
+
+#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
+
+// compile flag for this file
+#undef IPOL_Z
+#undef IPOL_W
+#undef SUBTEXEL
+#undef INVERSE_W
+
+// the features of the permutations are template parameters, only the
+// global overrides stay switches
+#ifdef SOFTWARE_DRIVER_2_SUBTEXEL
+	#define SUBTEXEL
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
+	#define INVERSE_W
+#endif
+
+#if defined ( SOFTWARE_DRIVER_2_USE_WBUFFER ) || defined ( SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT )
+	#define IPOL_W
+#endif
+
+#ifndef SOFTWARE_DRIVER_2_USE_WBUFFER
+	#define IPOL_Z
+#endif
+
+
+namespace irr
+{
+
+namespace video
+{
+
+//! how a permutation combines its color with the render target
+enum eTRBlend
+{
+	//! replace the render target
+	TRBLEND_REPLACE = 0,
+
+	//! add to the render target
+	TRBLEND_ADD,
+
+	//! add half of the color to the render target
+	TRBLEND_ADD_HALF
+};
+
+
+//! Textured triangle renderer, specialized at compile time.
+/** Each feature is a template parameter, so the scanline of a permutation
+contains only the work it needs, without branches per pixel.
+\param DepthUsage eDepthUsage flags, DEPTH_TEST skips hidden pixels,
+DEPTH_WRITE updates the depth buffer.
+\param Textures 1, or 2 to add the second texture as signed detail map.
+\param Bilinear Filter the textures, or take the nearest texel.
+\param VertexColor Modulate with the interpolated vertex color.
+\param Blend How the color is combined with the render target.
+\param Dither Take the nearest texel of the first texture at coordinates
+offset by an ordered dither, as the fast renderers do. Only for one
+texture without vertex color, replaced or added to the render target. */
+template < u32 DepthUsage, u32 Textures, bool Bilinear, bool VertexColor, eTRBlend Blend, bool Dither >
+class CTRTexturePermutation : public IBurningShader
+{
+public:
+
+	//! constructor
+	CTRTexturePermutation(CBurningVideoDriver* driver);
+
+	//! draws an indexed triangle list
+	virtual void drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c );
+
+
+private:
+	void scanline_bilinear ();
+
+	//! samples a texture into fix point colors
+	inline void getSample ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
+		const sInternalTexture* t, const tFixPoint tx, const tFixPoint ty ) const
+	{
+		if ( Bilinear )
+			getSample_texture ( r, g, b, t, tx, ty );
+		else
+			getTexel_fix ( r, g, b, t, tx, ty );
+	}
+
+	//! combines a color with a pixel of the render target
+	inline tVideoSample blend ( const tVideoSample dst,
+		const tFixPoint r0, const tFixPoint g0, const tFixPoint b0 ) const
+	{
+		tFixPoint r1, g1, b1;
+
+		switch ( Blend )
+		{
+			case TRBLEND_ADD:
+				color_to_fix ( r1, g1, b1, dst );
+				return fix_to_color ( clampfix_maxcolor ( r1 + r0 ),
+									clampfix_maxcolor ( g1 + g0 ),
+									clampfix_maxcolor ( b1 + b0 )
+								);
+
+			case TRBLEND_ADD_HALF:
+				color_to_fix ( r1, g1, b1, dst );
+				return fix_to_color ( clampfix_maxcolor ( r1 + ( r0 >> 1 ) ),
+									clampfix_maxcolor ( g1 + ( g0 >> 1 ) ),
+									clampfix_maxcolor ( b1 + ( b0 >> 1 ) )
+								);
+
+			default:
+				return fix_to_color ( r0, g0, b0 );
+		}
+	}
+
+	sScanConvertData scan;
+	sScanLineData line;
+
+};
+
+//! constructor
+template < u32 DepthUsage, u32 Textures, bool Bilinear, bool VertexColor, eTRBlend Blend, bool Dither >
+CTRTexturePermutation<DepthUsage, Textures, Bilinear, VertexColor, Blend, Dither>::CTRTexturePermutation(CBurningVideoDriver* driver)
+: IBurningShader(driver)
+{
+	#ifdef _DEBUG
+	setDebugName("CTRTexturePermutation");
+	#endif
+}
+
+
+
+/*!
+*/
+template < u32 DepthUsage, u32 Textures, bool Bilinear, bool VertexColor, eTRBlend Blend, bool Dither >
+void CTRTexturePermutation<DepthUsage, Textures, Bilinear, VertexColor, Blend, Dither>::scanline_bilinear ()
+{
+	tVideoSample *dst;
+	fp24 *z = 0;
+
+	s32 xStart;
+	s32 xEnd;
+	s32 dx;
+
+
+#ifdef SUBTEXEL
+	f32 subPixel;
+#endif
+
+#ifdef IPOL_Z
+	f32 slopeZ;
+#endif
+#ifdef IPOL_W
+	fp24 slopeW;
+#endif
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	sVec4 slopeC;
+#endif
+	sVec2 slopeT[BURNING_MATERIAL_MAX_TEXTURES];
+
+	// apply top-left fill-convention, left
+	xStart = core::ceil32( line.x[0] );
+	xEnd = core::ceil32( line.x[1] ) - 1;
+
+	dx = xEnd - xStart;
+
+	if ( dx < 0 )
+		return;
+
+#ifndef IPOL_Z
+	// skip spans the coarse depth buffer hides completely
+	if ( ( DepthUsage & DEPTH_TEST ) &&
+		DepthBuffer->isHidden ( xStart, line.y, xEnd, line.y, core::max_ ( line.w[0], line.w[1] ) ) )
+		return;
+#endif
+
+	// slopes
+	const f32 invDeltaX = core::reciprocal_approxim ( line.x[1] - line.x[0] );
+
+#ifdef IPOL_Z
+	slopeZ = (line.z[1] - line.z[0]) * invDeltaX;
+#endif
+#ifdef IPOL_W
+	slopeW = (line.w[1] - line.w[0]) * invDeltaX;
+#endif
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	if ( VertexColor )
+		slopeC = (line.c[0][1] - line.c[0][0]) * invDeltaX;
+#endif
+	slopeT[0] = (line.t[0][1] - line.t[0][0]) * invDeltaX;
+	if ( Textures > 1 )
+		slopeT[1] = (line.t[1][1] - line.t[1][0]) * invDeltaX;
+
+#ifdef SUBTEXEL
+	subPixel = ( (f32) xStart ) - line.x[0];
+#ifdef IPOL_Z
+	line.z[0] += slopeZ * subPixel;
+#endif
+#ifdef IPOL_W
+	line.w[0] += slopeW * subPixel;
+#endif
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	if ( VertexColor )
+		line.c[0][0] += slopeC * subPixel;
+#endif
+	line.t[0][0] += slopeT[0] * subPixel;
+	if ( Textures > 1 )
+		line.t[1][0] += slopeT[1] * subPixel;
+#endif
+
+	dst = (tVideoSample*)RenderTarget->lock() + ( line.y * RenderTarget->getDimension().Width ) + xStart;
+
+	if ( DepthUsage )
+		z = (fp24*) DepthBuffer->lock() + ( line.y * RenderTarget->getDimension().Width ) + xStart;
+
+
+#ifdef INVERSE_W
+	f32 inversew;
+#endif
+
+	tFixPoint tx0, tx1;
+	tFixPoint ty0, ty1;
+
+	tFixPoint r0, g0, b0;
+	tFixPoint r1, g1, b1;
+
+	const u32 dIndex = ( line.y & 3 ) << 2;
+
+	for ( s32 i = 0; i <= dx; ++i )
+	{
+#ifdef IPOL_Z
+		if ( !( DepthUsage & DEPTH_TEST ) || line.z[0] < z[i] )
+#else
+		if ( !( DepthUsage & DEPTH_TEST ) || line.w[0] >= z[i] )
+#endif
+		{
+			if ( DepthUsage & DEPTH_WRITE )
+			{
+#ifdef IPOL_Z
+				z[i] = line.z[0];
+#else
+				z[i] = line.w[0];
+#endif
+			}
+
+#ifdef INVERSE_W
+			inversew = fix_inverse32 ( line.w[0] );
+			tx0 = tofix ( line.t[0][0].x, inversew);
+			ty0 = tofix ( line.t[0][0].y, inversew);
+			if ( Textures > 1 )
+			{
+				tx1 = tofix ( line.t[1][0].x, inversew);
+				ty1 = tofix ( line.t[1][0].y, inversew);
+			}
+#else
+			tx0 = tofix ( line.t[0][0].x );
+			ty0 = tofix ( line.t[0][0].y );
+			if ( Textures > 1 )
+			{
+				tx1 = tofix ( line.t[1][0].x );
+				ty1 = tofix ( line.t[1][0].y );
+			}
+#endif
+
+			if ( Dither )
+			{
+				const tFixPointu d = dithermask [ dIndex | ( i & 3 ) ];
+				const tVideoSample texel = getTexel_plain ( &IT[0], d + tx0, d + ty0 );
+				dst[i] = Blend == TRBLEND_ADD ? PixelAdd32 ( dst[i], texel ) : texel;
+			}
+			else if ( Textures == 1 && !Bilinear && !VertexColor && Blend == TRBLEND_REPLACE )
+			{
+				// nothing to compute, copy the texel
+				dst[i] = getTexel_plain ( &IT[0], tx0, ty0 );
+			}
+			else
+			{
+				getSample ( r0, g0, b0, &IT[0], tx0, ty0 );
+
+				if ( Textures > 1 )
+				{
+					getSample ( r1, g1, b1, &IT[1], tx1, ty1 );
+
+					// bias half color
+					r1 += -FIX_POINT_HALF_COLOR;
+					g1 += -FIX_POINT_HALF_COLOR;
+					b1 += -FIX_POINT_HALF_COLOR;
+
+					r0 = clampfix_mincolor ( clampfix_maxcolor ( r0 + r1 ) );
+					g0 = clampfix_mincolor ( clampfix_maxcolor ( g0 + g1 ) );
+					b0 = clampfix_mincolor ( clampfix_maxcolor ( b0 + b1 ) );
+				}
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+				if ( VertexColor )
+				{
+#ifdef INVERSE_W
+					r1 = tofix ( line.c[0][0].y ,inversew );
+					g1 = tofix ( line.c[0][0].z ,inversew );
+					b1 = tofix ( line.c[0][0].w ,inversew );
+#else
+					getTexel_plain2 ( r1, g1, b1, line.c[0][0] );
+#endif
+					r0 = imulFix ( r0, r1 );
+					g0 = imulFix ( g0, g1 );
+					b0 = imulFix ( b0, b1 );
+				}
+#endif
+
+				dst[i] = blend ( dst[i], r0, g0, b0 );
+			}
+		}
+
+#ifdef IPOL_Z
+		line.z[0] += slopeZ;
+#endif
+#ifdef IPOL_W
+		line.w[0] += slopeW;
+#endif
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		if ( VertexColor )
+			line.c[0][0] += slopeC;
+#endif
+		line.t[0][0] += slopeT[0];
+		if ( Textures > 1 )
+			line.t[1][0] += slopeT[1];
+	}
+
+}
+
+template < u32 DepthUsage, u32 Textures, bool Bilinear, bool VertexColor, eTRBlend Blend, bool Dither >
+void CTRTexturePermutation<DepthUsage, Textures, Bilinear, VertexColor, Blend, Dither>::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c )
+{
+	// sort on height, y
+	if ( F32_A_GREATER_B ( a->Pos.y , b->Pos.y ) ) swapVertexPointer(&a, &b);
+	if ( F32_A_GREATER_B ( b->Pos.y , c->Pos.y ) ) swapVertexPointer(&b, &c);
+	if ( F32_A_GREATER_B ( a->Pos.y , b->Pos.y ) ) swapVertexPointer(&a, &b);
+
+	const f32 ca = c->Pos.y - a->Pos.y;
+	const f32 ba = b->Pos.y - a->Pos.y;
+	const f32 cb = c->Pos.y - b->Pos.y;
+	// calculate delta y of the edges
+	scan.invDeltaY[0] = core::reciprocal( ca );
+	scan.invDeltaY[1] = core::reciprocal( ba );
+	scan.invDeltaY[2] = core::reciprocal( cb );
+
+	if ( F32_LOWER_EQUAL_0 ( scan.invDeltaY[0] ) )
+		return;
+
+	// find if the major edge is left or right aligned
+	f32 temp[4];
+
+	temp[0] = a->Pos.x - c->Pos.x;
+	temp[1] = -ca;
+	temp[2] = b->Pos.x - a->Pos.x;
+	temp[3] = ba;
+
+	scan.left = ( temp[0] * temp[3] - temp[1] * temp[2] ) > 0.f ? 0 : 1;
+	scan.right = 1 - scan.left;
+
+	// calculate slopes for the major edge
+	scan.slopeX[0] = (c->Pos.x - a->Pos.x) * scan.invDeltaY[0];
+	scan.x[0] = a->Pos.x;
+
+#ifdef IPOL_Z
+	scan.slopeZ[0] = (c->Pos.z - a->Pos.z) * scan.invDeltaY[0];
+	scan.z[0] = a->Pos.z;
+#endif
+
+#ifdef IPOL_W
+	scan.slopeW[0] = (c->Pos.w - a->Pos.w) * scan.invDeltaY[0];
+	scan.w[0] = a->Pos.w;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	if ( VertexColor )
+	{
+		scan.slopeC[0][0] = (c->Color[0] - a->Color[0]) * scan.invDeltaY[0];
+		scan.c[0][0] = a->Color[0];
+	}
+#endif
+
+	scan.slopeT[0][0] = (c->Tex[0] - a->Tex[0]) * scan.invDeltaY[0];
+	scan.t[0][0] = a->Tex[0];
+
+	if ( Textures > 1 )
+	{
+		scan.slopeT[1][0] = (c->Tex[1] - a->Tex[1]) * scan.invDeltaY[0];
+		scan.t[1][0] = a->Tex[1];
+	}
+
+	// top left fill convention y run
+	s32 yStart;
+	s32 yEnd;
+
+#ifdef SUBTEXEL
+	f32 subPixel;
+#endif
+
+	// rasterize upper sub-triangle
+	if ( (f32) 0.0 != scan.invDeltaY[1]  )
+	{
+		// calculate slopes for top edge
+		scan.slopeX[1] = (b->Pos.x - a->Pos.x) * scan.invDeltaY[1];
+		scan.x[1] = a->Pos.x;
+
+#ifdef IPOL_Z
+		scan.slopeZ[1] = (b->Pos.z - a->Pos.z) * scan.invDeltaY[1];
+		scan.z[1] = a->Pos.z;
+#endif
+
+#ifdef IPOL_W
+		scan.slopeW[1] = (b->Pos.w - a->Pos.w) * scan.invDeltaY[1];
+		scan.w[1] = a->Pos.w;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		if ( VertexColor )
+		{
+			scan.slopeC[0][1] = (b->Color[0] - a->Color[0]) * scan.invDeltaY[1];
+			scan.c[0][1] = a->Color[0];
+		}
+#endif
+
+		scan.slopeT[0][1] = (b->Tex[0] - a->Tex[0]) * scan.invDeltaY[1];
+		scan.t[0][1] = a->Tex[0];
+
+		if ( Textures > 1 )
+		{
+			scan.slopeT[1][1] = (b->Tex[1] - a->Tex[1]) * scan.invDeltaY[1];
+			scan.t[1][1] = a->Tex[1];
+		}
+
+		// apply top-left fill convention, top part
+		yStart = core::ceil32( a->Pos.y );
+		yEnd = core::ceil32( b->Pos.y ) - 1;
+
+#ifdef SUBTEXEL
+		subPixel = ( (f32) yStart ) - a->Pos.y;
+
+		// correct to pixel center
+		scan.x[0] += scan.slopeX[0] * subPixel;
+		scan.x[1] += scan.slopeX[1] * subPixel;
+
+#ifdef IPOL_Z
+		scan.z[0] += scan.slopeZ[0] * subPixel;
+		scan.z[1] += scan.slopeZ[1] * subPixel;
+#endif
+
+#ifdef IPOL_W
+		scan.w[0] += scan.slopeW[0] * subPixel;
+		scan.w[1] += scan.slopeW[1] * subPixel;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		if ( VertexColor )
+		{
+			scan.c[0][0] += scan.slopeC[0][0] * subPixel;
+			scan.c[0][1] += scan.slopeC[0][1] * subPixel;
+		}
+#endif
+
+		scan.t[0][0] += scan.slopeT[0][0] * subPixel;
+		scan.t[0][1] += scan.slopeT[0][1] * subPixel;
+
+		if ( Textures > 1 )
+		{
+			scan.t[1][0] += scan.slopeT[1][0] * subPixel;
+			scan.t[1][1] += scan.slopeT[1][1] * subPixel;
+		}
+
+#endif
+
+		// rasterize the edge scanlines
+		for( line.y = yStart; line.y <= yEnd; ++line.y)
+		{
+			line.x[scan.left] = scan.x[0];
+			line.x[scan.right] = scan.x[1];
+
+#ifdef IPOL_Z
+			line.z[scan.left] = scan.z[0];
+			line.z[scan.right] = scan.z[1];
+#endif
+
+#ifdef IPOL_W
+			line.w[scan.left] = scan.w[0];
+			line.w[scan.right] = scan.w[1];
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+			if ( VertexColor )
+			{
+				line.c[0][scan.left] = scan.c[0][0];
+				line.c[0][scan.right] = scan.c[0][1];
+			}
+#endif
+
+			line.t[0][scan.left] = scan.t[0][0];
+			line.t[0][scan.right] = scan.t[0][1];
+
+			if ( Textures > 1 )
+			{
+				line.t[1][scan.left] = scan.t[1][0];
+				line.t[1][scan.right] = scan.t[1][1];
+			}
+
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ();
+
+			scan.x[0] += scan.slopeX[0];
+			scan.x[1] += scan.slopeX[1];
+
+#ifdef IPOL_Z
+			scan.z[0] += scan.slopeZ[0];
+			scan.z[1] += scan.slopeZ[1];
+#endif
+
+#ifdef IPOL_W
+			scan.w[0] += scan.slopeW[0];
+			scan.w[1] += scan.slopeW[1];
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+			if ( VertexColor )
+			{
+				scan.c[0][0] += scan.slopeC[0][0];
+				scan.c[0][1] += scan.slopeC[0][1];
+			}
+#endif
+
+			scan.t[0][0] += scan.slopeT[0][0];
+			scan.t[0][1] += scan.slopeT[0][1];
+
+			if ( Textures > 1 )
+			{
+				scan.t[1][0] += scan.slopeT[1][0];
+				scan.t[1][1] += scan.slopeT[1][1];
+			}
+
+		}
+	}
+
+	// rasterize lower sub-triangle
+	if ( (f32) 0.0 != scan.invDeltaY[2] )
+	{
+		// advance to middle point
+		if( (f32) 0.0 != scan.invDeltaY[1] )
+		{
+			temp[0] = b->Pos.y - a->Pos.y;	// dy
+
+			scan.x[0] = a->Pos.x + scan.slopeX[0] * temp[0];
+#ifdef IPOL_Z
+			scan.z[0] = a->Pos.z + scan.slopeZ[0] * temp[0];
+#endif
+#ifdef IPOL_W
+			scan.w[0] = a->Pos.w + scan.slopeW[0] * temp[0];
+#endif
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+			if ( VertexColor )
+			{
+				scan.c[0][0] = a->Color[0] + scan.slopeC[0][0] * temp[0];
+			}
+#endif
+			scan.t[0][0] = a->Tex[0] + scan.slopeT[0][0] * temp[0];
+			if ( Textures > 1 )
+			{
+				scan.t[1][0] = a->Tex[1] + scan.slopeT[1][0] * temp[0];
+			}
+
+		}
+
+		// calculate slopes for bottom edge
+		scan.slopeX[1] = (c->Pos.x - b->Pos.x) * scan.invDeltaY[2];
+		scan.x[1] = b->Pos.x;
+
+#ifdef IPOL_Z
+		scan.slopeZ[1] = (c->Pos.z - b->Pos.z) * scan.invDeltaY[2];
+		scan.z[1] = b->Pos.z;
+#endif
+
+#ifdef IPOL_W
+		scan.slopeW[1] = (c->Pos.w - b->Pos.w) * scan.invDeltaY[2];
+		scan.w[1] = b->Pos.w;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		if ( VertexColor )
+		{
+			scan.slopeC[0][1] = (c->Color[0] - b->Color[0]) * scan.invDeltaY[2];
+			scan.c[0][1] = b->Color[0];
+		}
+#endif
+
+		scan.slopeT[0][1] = (c->Tex[0] - b->Tex[0]) * scan.invDeltaY[2];
+		scan.t[0][1] = b->Tex[0];
+
+		if ( Textures > 1 )
+		{
+			scan.slopeT[1][1] = (c->Tex[1] - b->Tex[1]) * scan.invDeltaY[2];
+			scan.t[1][1] = b->Tex[1];
+		}
+
+		// apply top-left fill convention, top part
+		yStart = core::ceil32( b->Pos.y );
+		yEnd = core::ceil32( c->Pos.y ) - 1;
+
+#ifdef SUBTEXEL
+
+		subPixel = ( (f32) yStart ) - b->Pos.y;
+
+		// correct to pixel center
+		scan.x[0] += scan.slopeX[0] * subPixel;
+		scan.x[1] += scan.slopeX[1] * subPixel;
+
+#ifdef IPOL_Z
+		scan.z[0] += scan.slopeZ[0] * subPixel;
+		scan.z[1] += scan.slopeZ[1] * subPixel;
+#endif
+
+#ifdef IPOL_W
+		scan.w[0] += scan.slopeW[0] * subPixel;
+		scan.w[1] += scan.slopeW[1] * subPixel;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		if ( VertexColor )
+		{
+			scan.c[0][0] += scan.slopeC[0][0] * subPixel;
+			scan.c[0][1] += scan.slopeC[0][1] * subPixel;
+		}
+#endif
+
+		scan.t[0][0] += scan.slopeT[0][0] * subPixel;
+		scan.t[0][1] += scan.slopeT[0][1] * subPixel;
+
+		if ( Textures > 1 )
+		{
+			scan.t[1][0] += scan.slopeT[1][0] * subPixel;
+			scan.t[1][1] += scan.slopeT[1][1] * subPixel;
+		}
+
+#endif
+
+		// rasterize the edge scanlines
+		for( line.y = yStart; line.y <= yEnd; ++line.y)
+		{
+			line.x[scan.left] = scan.x[0];
+			line.x[scan.right] = scan.x[1];
+
+#ifdef IPOL_Z
+			line.z[scan.left] = scan.z[0];
+			line.z[scan.right] = scan.z[1];
+#endif
+
+#ifdef IPOL_W
+			line.w[scan.left] = scan.w[0];
+			line.w[scan.right] = scan.w[1];
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+			if ( VertexColor )
+			{
+				line.c[0][scan.left] = scan.c[0][0];
+				line.c[0][scan.right] = scan.c[0][1];
+			}
+#endif
+
+			line.t[0][scan.left] = scan.t[0][0];
+			line.t[0][scan.right] = scan.t[0][1];
+
+			if ( Textures > 1 )
+			{
+				line.t[1][scan.left] = scan.t[1][0];
+				line.t[1][scan.right] = scan.t[1][1];
+			}
+
+			// render a scanline, if it is in the tile
+			if ( line.y > TileBottom )
+				break;
+			if ( line.y >= TileTop )
+				scanline_bilinear ( );
+
+			scan.x[0] += scan.slopeX[0];
+			scan.x[1] += scan.slopeX[1];
+
+#ifdef IPOL_Z
+			scan.z[0] += scan.slopeZ[0];
+			scan.z[1] += scan.slopeZ[1];
+#endif
+
+#ifdef IPOL_W
+			scan.w[0] += scan.slopeW[0];
+			scan.w[1] += scan.slopeW[1];
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+			if ( VertexColor )
+			{
+				scan.c[0][0] += scan.slopeC[0][0];
+				scan.c[0][1] += scan.slopeC[0][1];
+			}
+#endif
+
+			scan.t[0][0] += scan.slopeT[0][0];
+			scan.t[0][1] += scan.slopeT[0][1];
+
+			if ( Textures > 1 )
+			{
+				scan.t[1][0] += scan.slopeT[1][0];
+				scan.t[1][1] += scan.slopeT[1][1];
+			}
+
+		}
+	}
+
+}
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
+
+namespace irr
+{
+namespace video
+{
+
+//! creates the triangle renderer of a shader which has a permutation
+/** Only the permutations listed here are instantiated, add a case for a
+new fast path.
+\return The renderer, or 0 if the shader has no permutation. */
+IBurningShader* createTRTexturePermutation(CBurningVideoDriver* driver, EBurningFFShader shader)
+{
+	#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
+	switch ( shader )
+	{
+		case ETR_TEXTURE_GOURAUD:
+#if defined ( BURNINGVIDEO_RENDERER_FAST ) && !defined ( SOFTWARE_DRIVER_2_USE_VERTEX_COLOR )
+			return new CTRTexturePermutation < DEPTH_TEST | DEPTH_WRITE, 1, false, false, TRBLEND_REPLACE, true > ( driver );
+#else
+			return new CTRTexturePermutation < DEPTH_TEST | DEPTH_WRITE, 1, true, true, TRBLEND_REPLACE, false > ( driver );
+#endif
+		case ETR_TEXTURE_GOURAUD_NOZ:
+			return new CTRTexturePermutation < 0, 1, false, false, TRBLEND_REPLACE, false > ( driver );
+		case ETR_TEXTURE_GOURAUD_ADD:
+#ifdef BURNINGVIDEO_RENDERER_FAST
+			return new CTRTexturePermutation < DEPTH_TEST | DEPTH_WRITE, 1, false, false, TRBLEND_ADD, true > ( driver );
+#else
+			return new CTRTexturePermutation < DEPTH_TEST | DEPTH_WRITE, 1, true, false, TRBLEND_ADD, false > ( driver );
+#endif
+		case ETR_TEXTURE_GOURAUD_ADD_NO_Z:
+			return new CTRTexturePermutation < DEPTH_TEST, 1, true, false, TRBLEND_ADD_HALF, false > ( driver );
+		case ETR_TEXTURE_GOURAUD_DETAIL_MAP:
+			return new CTRTexturePermutation < DEPTH_TEST | DEPTH_WRITE, 2, true, false, TRBLEND_REPLACE, false > ( driver );
+		default:
+			return 0;
+	}
+	#else
+	return 0;
+	#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
+}
+
+
+} // end namespace video
+} // end namespace irr
+
@@ -763,8 +763,8 @@ namespace scene
 			if (DebugDataVisible & scene::EDS_NORMALS)
 			{
 				// draw normals
-				const f32 debugNormalLength = SceneManager->getParameters()->getAttributeAsFloat(DEBUG_NORMAL_LENGTH);
-				const video::SColor debugNormalColor = SceneManager->getParameters()->getAttributeAsColor(DEBUG_NORMAL_COLOR);
+				const f32 debugNormalLength = SceneManager->getSceneParameters().DebugNormalLength;
+				const video::SColor debugNormalColor = SceneManager->getSceneParameters().DebugNormalColor;
 				driver->drawMeshBufferNormals(RenderBuffer, debugNormalLength, debugNormalColor);
 			}
 
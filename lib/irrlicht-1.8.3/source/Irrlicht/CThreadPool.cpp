@@ -0,0 +1,287 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CThreadPool.h"
+#include "IrrCompileConfig.h"
+#include "irrArray.h"
+#include "irrMath.h"
+
+#ifdef _IRR_WINDOWS_API_
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+namespace irr
+{
+
+#ifdef _IRR_WINDOWS_API_
+
+struct CThreadPool::SThreads
+{
+	CRITICAL_SECTION Mutex;
+	CRITICAL_SECTION UserMutex;
+	//! one count for each thread which has to take part in a job
+	HANDLE WorkSemaphore;
+	//! set when the last thread finished its part of a job
+	HANDLE DoneEvent;
+	core::array<HANDLE> Handles;
+	volatile LONG Active;
+	bool Quit;
+	CThreadPool* Pool;
+
+	//! argument of threadMain()
+	struct SThread
+	{
+		SThreads* Threads;
+		u32 Index;
+	} Thread[64];
+
+	static DWORD WINAPI threadMain(LPVOID data)
+	{
+		SThread* thread = (SThread*)data;
+		SThreads* threads = thread->Threads;
+		for (;;)
+		{
+			WaitForSingleObject(threads->WorkSemaphore, INFINITE);
+			if (threads->Quit)
+				return 0;
+
+			threads->Pool->work(thread->Index);
+			if (InterlockedDecrement(&threads->Active) == 0)
+				SetEvent(threads->DoneEvent);
+		}
+	}
+};
+
+#else
+
+struct CThreadPool::SThreads
+{
+	pthread_mutex_t Mutex;
+	pthread_mutex_t UserMutex;
+	pthread_cond_t WorkCondition;
+	pthread_cond_t DoneCondition;
+	core::array<pthread_t> Handles;
+	//! threads which still have to take part in the current job
+	u32 Waiting;
+	//! threads which did not finish their part of the current job
+	u32 Active;
+	bool Quit;
+	CThreadPool* Pool;
+
+	//! argument of threadMain()
+	struct SThread
+	{
+		SThreads* Threads;
+		u32 Index;
+	} Thread[64];
+
+	static void* threadMain(void* data)
+	{
+		SThread* thread = (SThread*)data;
+		SThreads* threads = thread->Threads;
+		for (;;)
+		{
+			pthread_mutex_lock(&threads->Mutex);
+			while (!threads->Waiting && !threads->Quit)
+				pthread_cond_wait(&threads->WorkCondition, &threads->Mutex);
+			if (threads->Quit)
+			{
+				pthread_mutex_unlock(&threads->Mutex);
+				return 0;
+			}
+			--threads->Waiting;
+			pthread_mutex_unlock(&threads->Mutex);
+
+			threads->Pool->work(thread->Index);
+
+			pthread_mutex_lock(&threads->Mutex);
+			if (--threads->Active == 0)
+				pthread_cond_signal(&threads->DoneCondition);
+			pthread_mutex_unlock(&threads->Mutex);
+		}
+	}
+};
+
+#endif
+
+
+//! constructor, creates a pool of one thread
+CThreadPool::CThreadPool()
+: Threads(new SThreads), Job(0), ItemCount(0), NextItem(0), ThreadCount(1)
+{
+	Threads->Pool = this;
+	Threads->Active = 0;
+	Threads->Quit = false;
+#ifdef _IRR_WINDOWS_API_
+	InitializeCriticalSection(&Threads->Mutex);
+	InitializeCriticalSection(&Threads->UserMutex);
+	Threads->WorkSemaphore = CreateSemaphore(0, 0, 0x7fffffff, 0);
+	Threads->DoneEvent = CreateEvent(0, FALSE, FALSE, 0);
+#else
+	pthread_mutex_init(&Threads->Mutex, 0);
+	pthread_mutex_init(&Threads->UserMutex, 0);
+	pthread_cond_init(&Threads->WorkCondition, 0);
+	pthread_cond_init(&Threads->DoneCondition, 0);
+	Threads->Waiting = 0;
+#endif
+}
+
+
+//! destructor, waits for the threads to end
+CThreadPool::~CThreadPool()
+{
+	setThreadCount(1);
+#ifdef _IRR_WINDOWS_API_
+	CloseHandle(Threads->DoneEvent);
+	CloseHandle(Threads->WorkSemaphore);
+	DeleteCriticalSection(&Threads->UserMutex);
+	DeleteCriticalSection(&Threads->Mutex);
+#else
+	pthread_cond_destroy(&Threads->DoneCondition);
+	pthread_cond_destroy(&Threads->WorkCondition);
+	pthread_mutex_destroy(&Threads->UserMutex);
+	pthread_mutex_destroy(&Threads->Mutex);
+#endif
+	delete Threads;
+}
+
+
+//! sets the number of threads which run jobs, including the calling one
+void CThreadPool::setThreadCount(u32 count)
+{
+	// WaitForMultipleObjects() waits for at most 64 threads
+	count = core::clamp(count, 1u, 64u);
+	if (count == ThreadCount)
+		return;
+
+	// end the old threads
+	const u32 old = Threads->Handles.size();
+	if (old)
+	{
+		Threads->Quit = true;
+#ifdef _IRR_WINDOWS_API_
+		ReleaseSemaphore(Threads->WorkSemaphore, old, 0);
+		WaitForMultipleObjects(old, Threads->Handles.pointer(), TRUE, INFINITE);
+		for (u32 i=0; i<old; ++i)
+			CloseHandle(Threads->Handles[i]);
+#else
+		pthread_mutex_lock(&Threads->Mutex);
+		pthread_cond_broadcast(&Threads->WorkCondition);
+		pthread_mutex_unlock(&Threads->Mutex);
+		for (u32 i=0; i<old; ++i)
+			pthread_join(Threads->Handles[i], 0);
+#endif
+		Threads->Handles.clear();
+		Threads->Quit = false;
+	}
+
+	ThreadCount = 1;
+	for (u32 i=1; i<count; ++i)
+	{
+		SThreads::SThread* thread = &Threads->Thread[i];
+		thread->Threads = Threads;
+		thread->Index = i;
+#ifdef _IRR_WINDOWS_API_
+		HANDLE handle = CreateThread(0, 0, SThreads::threadMain, thread, 0, 0);
+		if (!handle)
+			break;
+#else
+		pthread_t handle;
+		if (pthread_create(&handle, 0, SThreads::threadMain, thread) != 0)
+			break;
+#endif
+		Threads->Handles.push_back(handle);
+		++ThreadCount;
+	}
+}
+
+
+//! runs job.run(i, thread) for all i from 0 to count-1 and returns when all are done
+void CThreadPool::run(IJob& job, u32 count)
+{
+	Job = &job;
+	ItemCount = count;
+	NextItem = 0;
+
+	// not worth waking the other threads
+	const u32 helpers = core::min_(ThreadCount, count) - (count ? 1 : 0);
+	if (!helpers)
+	{
+		work(0);
+		Job = 0;
+		return;
+	}
+
+#ifdef _IRR_WINDOWS_API_
+	Threads->Active = helpers;
+	ReleaseSemaphore(Threads->WorkSemaphore, helpers, 0);
+	work(0);
+	WaitForSingleObject(Threads->DoneEvent, INFINITE);
+#else
+	pthread_mutex_lock(&Threads->Mutex);
+	Threads->Waiting = helpers;
+	Threads->Active = helpers;
+	pthread_cond_broadcast(&Threads->WorkCondition);
+	pthread_mutex_unlock(&Threads->Mutex);
+
+	work(0);
+
+	pthread_mutex_lock(&Threads->Mutex);
+	while (Threads->Active)
+		pthread_cond_wait(&Threads->DoneCondition, &Threads->Mutex);
+	pthread_mutex_unlock(&Threads->Mutex);
+#endif
+
+	Job = 0;
+}
+
+
+//! locks a mutex shared by all threads of the pool
+void CThreadPool::lock()
+{
+#ifdef _IRR_WINDOWS_API_
+	EnterCriticalSection(&Threads->UserMutex);
+#else
+	pthread_mutex_lock(&Threads->UserMutex);
+#endif
+}
+
+
+//! unlocks the mutex locked with lock()
+void CThreadPool::unlock()
+{
+#ifdef _IRR_WINDOWS_API_
+	LeaveCriticalSection(&Threads->UserMutex);
+#else
+	pthread_mutex_unlock(&Threads->UserMutex);
+#endif
+}
+
+
+//! runs items of the current job on a thread until there are no more
+void CThreadPool::work(u32 thread)
+{
+	for (;;)
+	{
+#ifdef _IRR_WINDOWS_API_
+		EnterCriticalSection(&Threads->Mutex);
+		const u32 item = NextItem < ItemCount ? NextItem++ : ItemCount;
+		LeaveCriticalSection(&Threads->Mutex);
+#else
+		pthread_mutex_lock(&Threads->Mutex);
+		const u32 item = NextItem < ItemCount ? NextItem++ : ItemCount;
+		pthread_mutex_unlock(&Threads->Mutex);
+#endif
+		if (item == ItemCount)
+			return;
+
+		Job->run(item, thread);
+	}
+}
+
+} // end namespace irr
+
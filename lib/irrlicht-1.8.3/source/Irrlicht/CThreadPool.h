@@ -0,0 +1,76 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_THREAD_POOL_H_INCLUDED__
+#define __C_THREAD_POOL_H_INCLUDED__
+
+#include "irrTypes.h"
+
+namespace irr
+{
+	//! Threads which run the items of a job in parallel.
+	/** The thread calling run() works on the job as well, so a pool of one
+	thread creates no threads and runs all items itself. Items are handed
+	out one at a time in order, which thread runs an item is not defined. */
+	class CThreadPool
+	{
+	public:
+
+		//! Work which can be split into independent items
+		class IJob
+		{
+		public:
+			virtual ~IJob() {}
+
+			//! runs one item, may be called from any thread of the pool
+			/** \param index Number of the item.
+			\param thread Number of the thread running the item, 0 for
+			the one calling CThreadPool::run(), and less than
+			CThreadPool::getThreadCount(). Items on the same thread
+			never run at the same time. */
+			virtual void run(u32 index, u32 thread) = 0;
+		};
+
+		//! constructor, creates a pool of one thread
+		CThreadPool();
+
+		//! destructor, waits for the threads to end
+		~CThreadPool();
+
+		//! sets the number of threads which run jobs, including the calling one
+		/** Must not be called while a job runs. */
+		void setThreadCount(u32 count);
+
+		//! returns the number of threads which run jobs, including the calling one
+		u32 getThreadCount() const { return ThreadCount; }
+
+		//! runs job.run(i, thread) for all i from 0 to count-1 and returns when all are done
+		/** Must not be called from a job. */
+		void run(IJob& job, u32 count);
+
+		//! locks a mutex shared by all threads of the pool
+		/** Jobs can use it for the rare accesses to shared data. */
+		void lock();
+
+		//! unlocks the mutex locked with lock()
+		void unlock();
+
+	private:
+
+		//! runs items of the current job on a thread until there are no more
+		void work(u32 thread);
+
+		struct SThreads;
+		SThreads* Threads;
+
+		IJob* Job;
+		u32 ItemCount;
+		u32 NextItem;
+		u32 ThreadCount;
+	};
+
+} // end namespace irr
+
+#endif
+
@@ -31,6 +31,7 @@ CVolumeLightSceneNode::CVolumeLightSceneNode(ISceneNode* parent, ISceneManager*
 	#endif
 
 	constructLight();
+	Material = Mesh->getMeshBuffer(0)->getMaterial();
 }
 
 
@@ -45,7 +46,8 @@ void CVolumeLightSceneNode::constructLight()
 {
 	if (Mesh)
 		Mesh->drop();
-	Mesh = SceneManager->getGeometryCreator()->createVolumeLightMesh(SubdivideU, SubdivideV, FootColor, TailColor, LPDistance, LightDimensions);
+	// lights with the same parameters share the mesh, the material stays with the node
+	Mesh = SceneManager->getGeometryCreator()->getSharedVolumeLightMesh(SubdivideU, SubdivideV, FootColor, TailColor, LPDistance, LightDimensions);
 }
 
 
@@ -58,7 +60,7 @@ void CVolumeLightSceneNode::render()
 	video::IVideoDriver* driver = SceneManager->getVideoDriver();
 	driver->setTransform(video::ETS_WORLD, AbsoluteTransformation);
 
-	driver->setMaterial(Mesh->getMeshBuffer(0)->getMaterial());
+	driver->setMaterial(Material);
 	driver->drawMeshBuffer(Mesh->getMeshBuffer(0));
 }
 
@@ -87,7 +89,7 @@ void CVolumeLightSceneNode::OnRegisterSceneNode()
 //! to directly modify the material of a scene node.
 video::SMaterial& CVolumeLightSceneNode::getMaterial(u32 i)
 {
-	return Mesh->getMeshBuffer(i)->getMaterial();
+	return Material;
 }
 
 
@@ -189,7 +191,7 @@ ISceneNode* CVolumeLightSceneNode::clone(ISceneNode* newParent, ISceneManager* n
 		newManager, ID, SubdivideU, SubdivideV, FootColor, TailColor, RelativeTranslation);
 
 	nb->cloneMembers(this, newManager);
-	nb->getMaterial(0) = Mesh->getMeshBuffer(0)->getMaterial();
+	nb->getMaterial(0) = Material;
 
 	if ( newParent )
 		nb->drop();
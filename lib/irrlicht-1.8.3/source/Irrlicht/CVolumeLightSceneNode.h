@@ -71,6 +71,7 @@ namespace scene
 		void constructLight();
 
 		IMesh* Mesh;
+		video::SMaterial Material;
 
 		f32  LPDistance;		// Distance to hypothetical lightsource point -- affects fov angle
 
@@ -31,11 +31,17 @@ namespace video
 		for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
 		{
 			IT[i].Texture = 0;
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+			IT[i].blockSizeLog2 = 0;
+			BlockCache[i] = 0;
+#endif
 		}
 
 		Driver = driver;
 		RenderTarget = 0;
 		ColorMask = COLOR_BRIGHT_WHITE;
+		TileTop = 0;
+		TileBottom = 0x7fffffff;
 		DepthBuffer = (CDepthBuffer*) driver->getDepthBuffer ();
 		if ( DepthBuffer )
 			DepthBuffer->grab();
@@ -63,6 +69,9 @@ namespace video
 		{
 			if ( IT[i].Texture )
 				IT[i].Texture->drop();
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+			delete BlockCache[i];
+#endif
 		}
 	}
 
@@ -101,8 +110,31 @@ namespace video
 			// select mignify and magnify ( lodLevel )
 			//SOFTWARE_DRIVER_2_MIPMAPPING_LOD_BIAS
 			it->lodLevel = lodLevel;
-			it->data = (tVideoSample*) it->Texture->lock(ETLM_READ_ONLY,
-				core::s32_clamp ( lodLevel + SOFTWARE_DRIVER_2_MIPMAPPING_LOD_BIAS, 0, SOFTWARE_DRIVER_2_MIPMAPPING_MAX - 1 ));
+			const u32 level = core::s32_clamp ( lodLevel + SOFTWARE_DRIVER_2_MIPMAPPING_LOD_BIAS, 0, SOFTWARE_DRIVER_2_MIPMAPPING_MAX - 1 );
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+			// compressed levels are sampled from their blocks, addressed
+			// like the texels of the decoded level
+			const u8* blocks = it->Texture->lockBlocks ( level );
+			if ( blocks )
+			{
+				const core::dimension2d<u32> &dim = it->Texture->getSize();
+				it->data = (void*) blocks;
+				it->pitchlog2 = s32_log2_s32 ( dim.Width ) + VIDEO_SAMPLE_GRANULARITY;
+				it->textureXMask = s32_to_fixPoint ( dim.Width - 1 ) & FIX_POINT_UNSIGNED_MASK;
+				it->textureYMask = s32_to_fixPoint ( dim.Height - 1 ) & FIX_POINT_UNSIGNED_MASK;
+				it->blockSizeLog2 = s32_log2_s32 ( it->Texture->getBlockSize() );
+				it->cache = getBlockCache ( stage );
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+				it->tileRowMask = ~0;
+				it->tileColumnMask = 0;
+#endif
+				return;
+			}
+			it->blockSizeLog2 = 0;
+#endif
+
+			it->data = (tVideoSample*) it->Texture->lock(ETLM_READ_ONLY, level);
 
 			// prepare for optimal fixpoint
 			it->pitchlog2 = s32_log2_s32 ( it->Texture->getPitch() );
@@ -110,11 +142,96 @@ namespace video
 			const core::dimension2d<u32> &dim = it->Texture->getSize();
 			it->textureXMask = s32_to_fixPoint ( dim.Width - 1 ) & FIX_POINT_UNSIGNED_MASK;
 			it->textureYMask = s32_to_fixPoint ( dim.Height - 1 ) & FIX_POINT_UNSIGNED_MASK;
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+			// read the copy in tiles if the level has one
+			if ( it->Texture->getTiles() )
+			{
+				it->data = (tVideoSample*) it->Texture->getTiles();
+				it->tileRowMask = ~( ( 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) - 1 );
+				it->tileColumnMask = it->tileRowMask;
+			}
+			else
+			{
+				it->tileRowMask = ~0;
+				it->tileColumnMask = 0;
+			}
+#endif
+		}
+	}
+
+
+	//! sets the textures of all stages to the ones of another shader
+	void IBurningShader::setTextureParams( const sInternalTexture* textures )
+	{
+		for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+		{
+			IT[i] = textures[i];
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+			// each thread decodes into the cache of its own shader
+			if ( IT[i].Texture && IT[i].blockSizeLog2 )
+				IT[i].cache = getBlockCache ( i );
+#endif
+		}
+	}
+
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! returns the cache of decoded blocks of a texture stage
+	sTexelBlockCache* IBurningShader::getBlockCache( u32 stage )
+	{
+		if ( !BlockCache[stage] )
+		{
+			BlockCache[stage] = new sTexelBlockCache;
+			BlockCache[stage]->clear ();
+		}
+		else if ( BlockCache[stage]->generation != CSoftwareTexture2::getBlockGeneration () )
+		{
+			BlockCache[stage]->clear ();
+		}
+		return BlockCache[stage];
+	}
+#endif
+
+
+	//! forgets the textures set by setTextureParams()
+	void IBurningShader::clearTextureParams()
+	{
+		for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+		{
+			IT[i].Texture = 0;
 		}
 	}
 
 
 } // end namespace video
+
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! returns a texel of a compressed level, decodes its block if it is not in the cache
+	tVideoSample getTexel_block ( const sInternalTexture * t, const u32 ofs )
+	{
+		const u32 x = ( ofs & ( ( 1 << t->pitchlog2 ) - 1 ) ) >> VIDEO_SAMPLE_GRANULARITY;
+		const u32 y = ofs >> t->pitchlog2;
+
+		// the rows of blocks two spans touch go to different halves of the cache
+		const u32 blockRowLog2 = t->pitchlog2 - VIDEO_SAMPLE_GRANULARITY - 2;
+		const u8* block = (const u8*) t->data + ( ( ( ( y >> 2 ) << blockRowLog2 ) + ( x >> 2 ) ) << t->blockSizeLog2 );
+		const u32 slot = ( ( x >> 2 ) + ( ( y >> 2 ) << ( SOFTWARE_DRIVER_2_TEXTURE_BLOCK_CACHE_LOG2 - 1 ) ) ) &
+			( sTexelBlockCache::SIZE - 1 );
+
+		sTexelBlockCache* cache = t->cache;
+		if ( cache->tag[slot] != block )
+		{
+			cache->tag[slot] = block;
+			video::CSoftwareTexture2::decodeBlock ( cache->texel[slot], 4 * sizeof ( tVideoSample ),
+				block, 1 << t->blockSizeLog2 );
+		}
+		return cache->texel[slot][ ( ( y & 3 ) << 2 ) | ( x & 3 ) ];
+	}
+#endif
+
+
 } // end namespace irr
 
 #endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
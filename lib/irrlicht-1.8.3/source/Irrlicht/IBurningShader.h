@@ -53,6 +53,13 @@ namespace video
 		VERTEXTRANSFORM	= 0x20,
 	};
 
+	//! how a triangle renderer uses the depth buffer
+	enum eDepthUsage
+	{
+		DEPTH_TEST	= 0x01,
+		DEPTH_WRITE	= 0x02,
+	};
+
 	struct SBurningShaderLightSpace
 	{
 		void reset ()
@@ -115,6 +122,7 @@ namespace video
 		ETR_STENCIL_SHADOW,
 
 		ETR_TEXTURE_BLEND,
+		ETR_OCCLUSION_QUERY,
 		ETR_REFERENCE,
 		ETR_INVALID,
 
@@ -144,6 +152,27 @@ namespace video
 
 		virtual void setMaterial ( const SBurningShaderMaterial &material ) {};
 
+		//! returns the number of pixels which passed the depth test since the last call
+		/** Only counted by the renderer of ETR_OCCLUSION_QUERY. */
+		virtual u32 fetchPassedSamples () { return 0; }
+
+		//! restricts drawTriangle() to the rows top to bottom of the render target
+		/** Rows above the tile are stepped over instead of skipped, so
+		the pixels of a tile get the same values as without tiles. */
+		void setTile ( s32 top, s32 bottom ) { TileTop = top; TileBottom = bottom; }
+
+		//! returns the textures of all stages as set by setTextureParam()
+		const sInternalTexture* getTextureParams () const { return IT; }
+
+		//! sets the textures of all stages to the ones of another shader
+		/** The textures are neither grabbed nor locked, so this can be
+		called from other threads than the one which set them up. They
+		must be kept alive until clearTextureParams() is called. */
+		void setTextureParams ( const sInternalTexture* textures );
+
+		//! forgets the textures set by setTextureParams()
+		void clearTextureParams ();
+
 	protected:
 
 		CBurningVideoDriver *Driver;
@@ -153,19 +182,29 @@ namespace video
 		CStencilBuffer * Stencil;
 		tVideoSample ColorMask;
 
+		//! first and last row drawTriangle() draws
+		s32 TileTop;
+		s32 TileBottom;
+
 		sInternalTexture IT[ BURNING_MATERIAL_MAX_TEXTURES ];
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+		//! returns the cache of decoded blocks of a texture stage
+		sTexelBlockCache* getBlockCache ( u32 stage );
+
+		//! created for the stages which sample compressed textures
+		sTexelBlockCache* BlockCache[ BURNING_MATERIAL_MAX_TEXTURES ];
+#endif
+
 		static const tFixPointu dithermask[ 4 * 4];
 	};
 
 
-	IBurningShader* createTriangleRendererTextureGouraud2(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererTextureLightMap2_M1(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererTextureLightMap2_M2(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererTextureLightMap2_M4(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererGTextureLightMap2_M4(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererTextureLightMap2_Add(CBurningVideoDriver* driver);
-	IBurningShader* createTriangleRendererTextureDetailMap2(CBurningVideoDriver* driver);
 	IBurningShader* createTriangleRendererTextureVertexAlpha2(CBurningVideoDriver* driver);
 
 
@@ -178,9 +217,8 @@ namespace video
 	IBurningShader* createTriangleRendererTextureFlatWire2(CBurningVideoDriver* driver);
 	IBurningShader* createTRFlat2(CBurningVideoDriver* driver);
 	IBurningShader* createTRFlatWire2(CBurningVideoDriver* driver);
-	IBurningShader* createTRTextureGouraudNoZ2(CBurningVideoDriver* driver);
-	IBurningShader* createTRTextureGouraudAdd2(CBurningVideoDriver* driver);
-	IBurningShader* createTRTextureGouraudAddNoZ2(CBurningVideoDriver* driver);
+
+	IBurningShader* createTRTexturePermutation(CBurningVideoDriver* driver, EBurningFFShader shader);
 
 	IBurningShader* createTRTextureGouraudAlpha(CBurningVideoDriver* driver);
 	IBurningShader* createTRTextureGouraudAlphaNoZ(CBurningVideoDriver* driver);
@@ -189,6 +227,7 @@ namespace video
 
 	IBurningShader* createTRNormalMap(CBurningVideoDriver* driver);
 	IBurningShader* createTRStencilShadow(CBurningVideoDriver* driver);
+	IBurningShader* createTROcclusionQuery(CBurningVideoDriver* driver);
 
 	IBurningShader* createTriangleRendererReference(CBurningVideoDriver* driver);
 
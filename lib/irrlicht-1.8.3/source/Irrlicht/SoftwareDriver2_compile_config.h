@@ -93,6 +93,43 @@
 
 #define SOFTWARE_DRIVER_2_MIPMAPPING_SCALE (8/SOFTWARE_DRIVER_2_MIPMAPPING_MAX)
 
+// transform four vertices at once with SSE. Visual C++ compiles the
+// intrinsics for all x86 targets, the driver checks the cpu at runtime.
+#if defined ( _MSC_VER ) && ( defined ( _M_IX86 ) || defined ( _M_X64 ) )
+	#define SOFTWARE_DRIVER_2_SSE
+#elif defined ( __SSE__ )
+	#define SOFTWARE_DRIVER_2_SSE
+#endif
+
+// blend the 2D blits four pixels at once with SSE2
+#if defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 ) || defined ( __SSE2__ )
+	#define SOFTWARE_DRIVER_2_SSE2
+#endif
+
+// keep the farthest depth of each 8x8 tile of the depth buffer, to skip
+// triangles and spans which are hidden completely. needs the w-buffer
+#if defined ( SOFTWARE_DRIVER_2_USE_WBUFFER )
+	#define SOFTWARE_DRIVER_2_HIERARCHICAL_Z
+#endif
+
+// clear the color and depth buffer tile by tile, right before the first
+// triangle is drawn over a tile
+#define SOFTWARE_DRIVER_2_FAST_CLEAR
+
+// the renderers read a copy of each texture in tiles of 4x4 texels, which
+// keeps the texels of a bilinear sample and of a diagonal walk together.
+// off, cpus with large caches lose more to the addressing than they gain
+//#define SOFTWARE_DRIVER_2_TEXTURE_TILES
+#define SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2	2
+
+// keep dxt1 and dxt5 compressed .dds textures compressed in memory. the
+// renderers decode the 4x4 blocks they sample into a cache of each shader
+// and texture stage, which holds 2^SOFTWARE_DRIVER_2_TEXTURE_BLOCK_CACHE_LOG2 blocks
+#if defined ( _IRR_COMPILE_WITH_DDS_LOADER_ )
+	#define SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+#endif
+#define SOFTWARE_DRIVER_2_TEXTURE_BLOCK_CACHE_LOG2	8
+
 #ifndef REALINLINE
 	#ifdef _MSC_VER
 		#define REALINLINE __forceinline
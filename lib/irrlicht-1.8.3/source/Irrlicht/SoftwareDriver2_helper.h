@@ -703,6 +703,29 @@ struct fp24
 
 // ------------------------ Internal Texture -----------------------------
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+//! recently decoded blocks of compressed textures
+/** Direct mapped by the block position, as a span walks along a row of
+blocks and the next span mostly hits the same blocks again. */
+struct sTexelBlockCache
+{
+	enum { SIZE = 1 << SOFTWARE_DRIVER_2_TEXTURE_BLOCK_CACHE_LOG2 };
+
+	void clear ()
+	{
+		memset32 ( tag, 0, sizeof ( tag ) );
+		generation = video::CSoftwareTexture2::getBlockGeneration ();
+	}
+
+	//! address of the decoded block, 0 if unused
+	const u8* tag[SIZE];
+	tVideoSample texel[SIZE][16];
+
+	//! block generation of the textures when the cache was cleared
+	u32 generation;
+};
+#endif
+
 struct sInternalTexture
 {
 	u32 textureXMask;
@@ -711,22 +734,78 @@ struct sInternalTexture
 	u32 pitchlog2;
 	void *data;
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	//! bits of the texel row and column which select the tile, all
+	//! row and no column bits if data is not stored in tiles
+	u32 tileRowMask;
+	u32 tileColumnMask;
+#endif
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	//! log2 of the block size in bytes if data are the blocks of a
+	//! compressed level, 0 otherwise
+	u32 blockSizeLog2;
+	sTexelBlockCache* cache;
+#endif
+
 	video::CSoftwareTexture2 *Texture;
 	s32 lodLevel;
 };
 
 
+//! returns the part of the texel offset in bytes which depends on the row
+REALINLINE u32 getTexelRow ( const sInternalTexture * t, const tFixPointu ty )
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	const u32 y = ( ty & t->textureYMask ) >> FIX_POINT_PRE;
+	return ( ( y & t->tileRowMask ) << t->pitchlog2 ) |
+		( ( y & ~t->tileRowMask ) << ( SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 + VIDEO_SAMPLE_GRANULARITY ) );
+#else
+	return ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
+#endif
+}
+
+//! returns the part of the texel offset in bytes which depends on the column
+REALINLINE u32 getTexelColumn ( const sInternalTexture * t, const tFixPointu tx )
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	const u32 x = ( tx & t->textureXMask ) >> FIX_POINT_PRE;
+	return ( ( ( x & t->tileColumnMask ) << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) |
+		( x & ~t->tileColumnMask ) ) << VIDEO_SAMPLE_GRANULARITY;
+#else
+	return ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+#endif
+}
+
+
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+//! returns a texel of a compressed level, decodes its block if it is not in the cache
+/** The offset addresses the texel as if the level was stored decoded. Not
+inlined, the renderers only carry the test for compressed levels. */
+tVideoSample getTexel_block ( const sInternalTexture * t, const u32 ofs );
+#endif
+
+//! returns the texel at the offset of getTexelRow and getTexelColumn
+REALINLINE tVideoSample getTexel_offset ( const sInternalTexture * t, const u32 ofs )
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_BLOCKS
+	if ( t->blockSizeLog2 )
+		return getTexel_block ( t, ofs );
+#endif
+	return *((tVideoSample*)( (u8*) t->data + ofs ));
+}
+
 
 // get video sample plain
 inline tVideoSample getTexel_plain ( const sInternalTexture * t, const tFixPointu tx, const tFixPointu ty )
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
-	return *((tVideoSample*)( (u8*) t->data + ofs ));
+	return getTexel_offset ( t, ofs );
 }
 
 // get video sample to fix
@@ -736,12 +815,11 @@ inline void getTexel_fix ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
 	tVideoSample t00;
-	t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	t00 = getTexel_offset ( t, ofs );
 
 	r	 =	(t00 & MASK_R) >> ( SHIFT_R - FIX_POINT_PRE);
 	g	 =	(t00 & MASK_G) << ( FIX_POINT_PRE - SHIFT_G );
@@ -756,12 +834,11 @@ REALINLINE void getTexel_fix ( tFixPoint &a,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
 	tVideoSample t00;
-	t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	t00 = getTexel_offset ( t, ofs );
 
 	a	 =	(t00 & MASK_A) >> ( SHIFT_A - FIX_POINT_PRE);
 }
@@ -786,11 +863,10 @@ inline void getSample_texture_dither (	tFixPoint &r, tFixPoint &g, tFixPoint &b,
 	const tFixPointu _nty = (ty + dithermask [ index ] ) & t->textureYMask;
 
 	u32 ofs;
-	ofs = ( ( _nty ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( _ntx ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, _nty ) | getTexelColumn ( t, _ntx );
 
 	// texel
-	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	const tVideoSample t00 = getTexel_offset ( t, ofs );
 
 	(tFixPointu &) r	 =	(t00 & MASK_R) >> ( SHIFT_R - FIX_POINT_PRE);
 	(tFixPointu &) g	 =	(t00 & MASK_G) << ( FIX_POINT_PRE - SHIFT_G );
@@ -811,11 +887,10 @@ inline void getSample_texture ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
-	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	const tVideoSample t00 = getTexel_offset ( t, ofs );
 
 	(tFixPointu &) r	 =	(t00 & MASK_R) >> ( SHIFT_R - FIX_POINT_PRE);
 	(tFixPointu &) g	 =	(t00 & MASK_G) << ( FIX_POINT_PRE - SHIFT_G );
@@ -828,11 +903,10 @@ inline void getSample_texture ( tFixPointu &a, tFixPointu &r, tFixPointu &g, tFi
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
-	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	const tVideoSample t00 = getTexel_offset ( t, ofs );
 
 	(tFixPointu &)a	 =	(t00 & MASK_A) >> ( SHIFT_A - FIX_POINT_PRE);
 	(tFixPointu &)r	 =	(t00 & MASK_R) >> ( SHIFT_R - FIX_POINT_PRE);
@@ -851,12 +925,11 @@ REALINLINE void getSample_linear ( tFixPointu &r, tFixPointu &g, tFixPointu &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
 	tVideoSample t00;
-	t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	t00 = getTexel_offset ( t, ofs );
 
 	r	 =	(t00 & MASK_R) >> SHIFT_R;
 	g	 =	(t00 & MASK_G) >> SHIFT_G;
@@ -883,21 +956,21 @@ REALINLINE void getSample_texture ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 	u32 o0, o1,o2,o3;
 	tVideoSample t00;
 
-	o0 = ( ( (ty) & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	o1 = ( ( (ty+FIX_POINT_ONE) & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	o2 =   ( (tx) & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
-	o3 =   ( (tx+FIX_POINT_ONE) & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	o0 = getTexelRow ( t, ty );
+	o1 = getTexelRow ( t, ty + FIX_POINT_ONE );
+	o2 = getTexelColumn ( t, tx );
+	o3 = getTexelColumn ( t, tx + FIX_POINT_ONE );
 
-	t00 = *((tVideoSample*)( (u8*) t->data + (o0 | o2 ) ));
+	t00 = getTexel_offset ( t, o0 | o2 );
 	r00	 =	(t00 & MASK_R) >> SHIFT_R; g00  =	(t00 & MASK_G) >> SHIFT_G; b00	 =	(t00 & MASK_B);
 
-	t00 = *((tVideoSample*)( (u8*) t->data + (o0 | o3 ) ));
+	t00 = getTexel_offset ( t, o0 | o3 );
 	r10	 =	(t00 & MASK_R) >> SHIFT_R; g10  =	(t00 & MASK_G) >> SHIFT_G; b10	 =	(t00 & MASK_B);
 
-	t00 = *((tVideoSample*)( (u8*) t->data + (o1 | o2 ) ));
+	t00 = getTexel_offset ( t, o1 | o2 );
 	r01	 =	(t00 & MASK_R) >> SHIFT_R; g01  =	(t00 & MASK_G) >> SHIFT_G; b01	 =	(t00 & MASK_B);
 
-	t00 = *((tVideoSample*)( (u8*) t->data + (o1 | o3 ) ));
+	t00 = getTexel_offset ( t, o1 | o3 );
 	r11	 =	(t00 & MASK_R) >> SHIFT_R; g11  =	(t00 & MASK_G) >> SHIFT_G; b11	 =	(t00 & MASK_B);
 
 #endif
@@ -938,12 +1011,11 @@ REALINLINE void getSample_linear ( tFixPointu &a, tFixPointu &r, tFixPointu &g,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = getTexelRow ( t, ty ) | getTexelColumn ( t, tx );
 
 	// texel
 	tVideoSample t00;
-	t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
+	t00 = getTexel_offset ( t, ofs );
 
 	a	 =	(t00 & MASK_A) >> SHIFT_A;
 	r	 =	(t00 & MASK_R) >> SHIFT_R;
@@ -126,6 +126,19 @@ namespace os
 		return GetTickCount();
 	}
 
+	u32 Timer::getRealTimeMicroseconds()
+	{
+		LARGE_INTEGER nTime;
+		if (HighPerformanceTimerSupport && QueryPerformanceCounter(&nTime))
+		{
+			// split the seconds off, the counter times 1000000 would overflow
+			const LONGLONG freq = HighPerformanceFreq.QuadPart;
+			return u32((nTime.QuadPart / freq) * 1000000 + (nTime.QuadPart % freq) * 1000000 / freq);
+		}
+
+		return GetTickCount() * 1000;
+	}
+
 } // end namespace os
 
 
@@ -161,6 +174,13 @@ namespace os
 		gettimeofday(&tv, 0);
 		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	}
+
+	u32 Timer::getRealTimeMicroseconds()
+	{
+		timeval tv;
+		gettimeofday(&tv, 0);
+		return (u32)(tv.tv_sec * 1000000) + tv.tv_usec;
+	}
 } // end namespace os
 
 #endif // end linux / windows
@@ -112,6 +112,11 @@ namespace os
 		//! returns the current real time in milliseconds
 		static u32 getRealTime();
 
+		//! returns the current real time in microseconds, for measuring short times
+		/** The value wraps around after about 71 minutes, so only use
+		differences of two values. */
+		static u32 getRealTimeMicroseconds();
+
 	private:
 
 		static void initVirtualTimer();
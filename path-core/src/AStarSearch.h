@@ -0,0 +1,198 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+
+#include "Graph.h"
+#include "Heuristic.h"
+#include "SearchPolicies.h"
+
+/**
+ * A path finding algorithm based on the A star algorithm.
+ * resources used:
+ * http://www.policyalmanac.org/games/aStarTutorial.htm
+ * (the explanation of the algorithm, not the C++ code)
+ * https://www.youtube.com/watch?v=C0qCR18gXdU
+ * (watched to gain a high level understanding of how the algorithm works)
+ *
+ * The search is resumable: the open and closed lists are kept between
+ * calls to step(), so the render loop can advance it a little every
+ * frame instead of stalling until the whole path is known. getPath()
+ * returns the best path found so far while the search is running.
+ *
+ * The heuristic, edge cost, open list, closed set and tracer are template
+ * policies (see SearchPolicies.h), so they can be swapped without editing
+ * the algorithm and without paying for virtual calls in the inner loop.
+ * AStarSearch is the instantiation that matches the original planner.
+ */
+template <class Heuristic, class EdgeCost, class OpenList, class ClosedSet, class Tracer>
+class BasicAStarSearch {
+public:
+	BasicAStarSearch(const std::vector<Node*>& nodes, const NodePositions& positions, Node* start, Node* end)
+		: start(start), end(end), current(start), finished(false), found(false) {
+		// 0. Reset all algorithm info on nodes
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			nodes[i]->visited = false;
+			nodes[i]->f = 0.0f;
+			nodes[i]->g = 0.0f;
+			nodes[i]->h = 0.0f;
+			nodes[i]->parent = nullptr;
+		}
+
+		heuristic.prepare(positions, end);
+		openList.reset(nodes.size());
+		closedList.reset(nodes.size());
+
+		// add CURRENT to open list
+		openList.push(current);
+	}
+
+	/**
+	 * Expands at most maxExpansions nodes.
+	 * Returns true once the search has finished.
+	 */
+	bool step(irr::u32 maxExpansions) {
+		for (irr::u32 i = 0; i < maxExpansions && !finished; ++i) {
+			expand();
+		}
+		return finished;
+	}
+
+	/**
+	 * Expands nodes until the search finishes or the timer passes the
+	 * deadline (in real time milliseconds, see ITimer::getRealTime).
+	 * At least one node is expanded per call.
+	 * Returns true once the search has finished.
+	 */
+	bool step(irr::ITimer* timer, irr::u32 deadline) {
+		do {
+			expand();
+		} while (!finished && timer->getRealTime() < deadline);
+		return finished;
+	}
+
+	bool isFinished() const { return finished; }
+
+	bool isPathFound() const { return found; }
+
+	/**
+	 * Returns the path from the end node back to the start node once the
+	 * search has finished (empty if there is no path). While the search is
+	 * running it returns the path to the most recently expanded node.
+	 */
+	std::vector<Node*> getPath() const {
+		std::vector<Node*> path;
+		if (finished && !found) return path;
+
+		Node* node = current;
+		while (node != start) {
+			path.push_back(node);
+			node = node->parent;
+		}
+		path.push_back(node); // push the final (end) node into the path
+		return path;
+	}
+
+	Tracer& getTracer() { return tracer; }
+
+private:
+	/**
+	 * Runs one iteration of the algorithm: takes the best node off the
+	 * open list and relaxes its edges.
+	 */
+	void expand() {
+		if (openList.empty()) {
+			tracer.noPath();
+			finished = true;
+			return;
+		}
+
+		// take the best node off the open list and add it to the closed list
+		current = openList.pop();
+		tracer.expanded(current);
+		closedList.insert(current);
+
+		// check if we have found our destination
+		if (current == end) {
+			// target found!
+			finished = true;
+			found = true;
+			return;
+		}
+
+		// iterate over connected nodes
+		for (irr::u32 i = 0; i < current->edges.size(); ++i) {
+			Node* connected = current->edges[i].to;
+
+			// ignore flag: set ignore to true if the node is impassible
+			// or the node is in the closed list
+			bool ignore = (!connected->passable || closedList.contains(connected));
+
+			if (!ignore) {
+				irr::f32 newG = current->g + edgeCost(current->edges[i]);
+
+				// add connected node to open list
+				if (!openList.contains(connected)) {
+					// set all connected nodes parent to be THIS node
+					connected->parent = current;
+					// calculate G
+					connected->g = newG;
+					// calculate H
+					connected->h = heuristic(connected);
+					// calculate F
+					connected->f = connected->g + connected->h;
+					// not in list so add it
+					openList.push(connected);
+				} else {
+					// is already in list, so need to possibly update it
+					bool betterPathExists = newG < connected->g;
+					if (betterPathExists) {
+						connected->parent = current;
+						connected->g = newG;
+						connected->f = connected->g + connected->h;
+						openList.update(connected);
+					}
+				}
+			}
+		}
+	}
+
+	Node* start;
+	Node* end;
+	Node* current;
+	Heuristic heuristic;
+	EdgeCost edgeCost;
+	OpenList openList;
+	ClosedSet closedList;
+	Tracer tracer;
+	bool finished;
+	bool found;
+};
+
+/**
+ * The planner used by main(): it behaves exactly like the original
+ * implementation.
+ */
+typedef BasicAStarSearch<EuclideanHeuristic, EdgeWeightCost, SortedOpenList<ByH>, ListClosedSet, ConsoleTracer> AStarSearch;
+
+/**
+ * The same search with a binary heap open list and per-node closed flags,
+ * which scales to large graphs. It prints nothing.
+ */
+typedef BasicAStarSearch<EuclideanHeuristic, EdgeWeightCost, BinaryHeapOpenList<ByH>, FlagClosedSet, NullTracer> FastAStarSearch;
+
+/**
+ * Runs the whole search at once and returns the path from end to start
+ * (empty if no path could be found).
+ */
+template <class Search>
+std::vector<Node*> RunSearch(const std::vector<Node*>& nodes, Node* start, Node* end) {
+	NodePositions positions(nodes);
+	Search search(nodes, positions, start, end);
+	while (!search.step(1024)) {}
+	return search.getPath();
+}
+
+inline std::vector<Node*> AStarPathAlgorithm(const std::vector<Node*>& nodes, Node* start, Node* end) {
+	return RunSearch<AStarSearch>(nodes, start, end);
+}
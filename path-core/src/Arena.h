@@ -0,0 +1,122 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * A bump allocator.
+ *
+ * Memory is handed out from large blocks by moving a pointer forward,
+ * and is only given back all at once by release() (or the destructor).
+ * Building a graph with one small allocation per node, name and edge
+ * list fragments the heap; with an arena it is a handful of blocks.
+ *
+ * Destructors are never run for objects in the arena, so only trivially
+ * destructible types may be created in it.
+ */
+class Arena {
+public:
+	Arena(size_t blockSize = 64 * 1024) : blockSize(blockSize), current(nullptr), remaining(0), used(0) {}
+	~Arena() { release(); }
+
+	/**
+	 * Returns size bytes aligned to align (which must be a power of two).
+	 */
+	void* allocate(size_t size, size_t align) {
+		size_t padding = (align - ((size_t)current & (align - 1))) & (align - 1);
+		if (padding + size > remaining) {
+			// requests bigger than a block get a block of their own
+			newBlock(size + align > blockSize ? size + align : blockSize);
+			padding = (align - ((size_t)current & (align - 1))) & (align - 1);
+		}
+		char* memory = current + padding;
+		current += padding + size;
+		remaining -= padding + size;
+		used += size;
+		return memory;
+	}
+
+	/**
+	 * Returns uninitialised storage for count objects of type T.
+	 */
+	template <class T>
+	T* allocateArray(size_t count) {
+		static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+		return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	/**
+	 * Constructs an object of type T in the arena.
+	 */
+	template <class T, class... Args>
+	T* create(Args&&... args) {
+		static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+		return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Copies a null terminated string into the arena.
+	 */
+	const char* copyString(const char* text) {
+		size_t length = strlen(text) + 1;
+		char* copy = static_cast<char*>(allocate(length, 1));
+		memcpy(copy, text, length);
+		return copy;
+	}
+
+	/**
+	 * Frees every block at once. Everything allocated from the arena
+	 * becomes invalid.
+	 */
+	void release() {
+		for (irr::u32 i = 0; i < blocks.size(); ++i) {
+			delete[] blocks[i];
+		}
+		blocks.clear();
+		current = nullptr;
+		remaining = 0;
+		used = 0;
+	}
+
+	/**
+	 * Exchanges the contents of two arenas.
+	 */
+	void swap(Arena& other) {
+		std::swap(blockSize, other.blockSize);
+		std::swap(current, other.current);
+		std::swap(remaining, other.remaining);
+		std::swap(used, other.used);
+		blocks.swap(other.blocks);
+	}
+
+	/**
+	 * Number of blocks, i.e. heap allocations, the arena has made.
+	 */
+	irr::u32 getBlockCount() const { return blocks.size(); }
+
+	/**
+	 * Number of bytes handed out, not counting alignment padding.
+	 */
+	size_t getBytesUsed() const { return used; }
+
+private:
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+	void newBlock(size_t size) {
+		current = new char[size];
+		remaining = size;
+		blocks.push_back(current);
+	}
+
+	size_t blockSize;
+	char* current;
+	size_t remaining;
+	size_t used;
+	std::vector<char*> blocks;
+};
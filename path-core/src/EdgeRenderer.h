@@ -0,0 +1,139 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+
+#include "Graph.h"
+
+/**
+ * Draws the edges of a graph as lines.
+ *
+ * Every undirected edge is drawn once, even when both of its nodes list
+ * it. Each line has its own two vertices, so the end of a line at a node
+ * takes that node's colour (see setNodeColor).
+ *
+ * The lines are split into chunks of at most CHUNK_VERTICES vertices, so
+ * 16 bit indices work for any number of edges, on every driver. The
+ * chunks are static hardware buffers where the driver supports them, and
+ * a colour change only marks the chunks holding that node's lines dirty.
+ */
+class EdgeRenderer {
+public:
+	static const irr::u32 CHUNK_VERTICES = 65536;
+
+	/**
+	 * Builds the lines of all edges. The end of a line at a node starts
+	 * with the colour of the node (Node::color).
+	 */
+	EdgeRenderer(const std::vector<Node*>& nodes) : vertexStart(nodes.size() + 1, 0) {
+		// count the line ends at each node
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			for (irr::u32 j = 0; j < nodes[i]->edges.size(); ++j) {
+				const Node* to = nodes[i]->edges[j].to;
+				if (isDrawn(nodes[i], to)) {
+					++vertexStart[nodes[i]->index + 1];
+					++vertexStart[to->index + 1];
+				}
+			}
+		}
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			vertexStart[i + 1] += vertexStart[i];
+		}
+
+		// emit the lines, remembering which vertices end at each node
+		vertices.resize(vertexStart.back());
+		std::vector<irr::u32> next(vertexStart.begin(), vertexStart.end() - 1);
+		irr::u32 vertexCount = 0;
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			for (irr::u32 j = 0; j < nodes[i]->edges.size(); ++j) {
+				const Node* from = nodes[i];
+				const Node* to = from->edges[j].to;
+				if (!isDrawn(from, to)) continue;
+
+				irr::scene::SMeshBuffer* chunk = getChunk(vertexCount);
+				chunk->Vertices.push_back(irr::video::S3DVertex(from->position, irr::core::vector3df(), from->color, irr::core::vector2df()));
+				chunk->Vertices.push_back(irr::video::S3DVertex(to->position, irr::core::vector3df(), to->color, irr::core::vector2df()));
+				chunk->Indices.push_back((irr::u16)(chunk->Vertices.size() - 2));
+				chunk->Indices.push_back((irr::u16)(chunk->Vertices.size() - 1));
+
+				vertices[next[from->index]++] = vertexCount++;
+				vertices[next[to->index]++] = vertexCount++;
+			}
+		}
+
+		for (irr::u32 i = 0; i < chunks.size(); ++i) {
+			chunks[i]->recalculateBoundingBox();
+		}
+	}
+
+	~EdgeRenderer() {
+		for (irr::u32 i = 0; i < chunks.size(); ++i) {
+			chunks[i]->drop();
+		}
+	}
+
+	/**
+	 * Colours the ends of all lines at the node. Only the chunks whose
+	 * colours actually change have to be uploaded again.
+	 */
+	void setNodeColor(const Node* node, irr::video::SColor color) {
+		for (irr::u32 i = vertexStart[node->index]; i < vertexStart[node->index + 1]; ++i) {
+			irr::scene::SMeshBuffer* chunk = chunks[vertices[i] / CHUNK_VERTICES];
+			irr::video::S3DVertex& vertex = chunk->Vertices[vertices[i] % CHUNK_VERTICES];
+			if (vertex.Color != color) {
+				vertex.Color = color;
+				chunk->setDirty(irr::scene::EBT_VERTEX);
+			}
+		}
+	}
+
+	/**
+	 * Draws the lines with the given material. The node positions are
+	 * world coordinates.
+	 */
+	void draw(irr::video::IVideoDriver* driver, const irr::video::SMaterial& material) const {
+		driver->setMaterial(material);
+		driver->setTransform(irr::video::ETS_WORLD, irr::core::matrix4());
+		for (irr::u32 i = 0; i < chunks.size(); ++i) {
+			driver->drawMeshBuffer(chunks[i]);
+		}
+	}
+
+	irr::u32 getLineCount() const { return vertices.size() / 2; }
+
+private:
+	EdgeRenderer(const EdgeRenderer&);
+	EdgeRenderer& operator=(const EdgeRenderer&);
+
+	/**
+	 * An edge is drawn from the node with the lower index, unless the
+	 * other node has no edge back.
+	 */
+	static bool isDrawn(const Node* from, const Node* to) {
+		if (from->index < to->index) return true;
+		for (irr::u32 i = 0; i < to->edges.size(); ++i) {
+			if (to->edges[i].to == from) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Returns the chunk the vertex goes into, creating it if needed.
+	 */
+	irr::scene::SMeshBuffer* getChunk(irr::u32 vertex) {
+		if (vertex / CHUNK_VERTICES == chunks.size()) {
+			irr::scene::SMeshBuffer* chunk = new irr::scene::SMeshBuffer();
+			chunk->setPrimitiveType(irr::scene::EPT_LINES);
+			chunk->setHardwareMappingHint(irr::scene::EHM_STATIC);
+			chunks.push_back(chunk);
+		}
+		return chunks.back();
+	}
+
+	std::vector<irr::scene::SMeshBuffer*> chunks;
+
+	// the vertices ending at node i are vertices[vertexStart[i]] to
+	// vertices[vertexStart[i + 1] - 1], numbered across all chunks
+	std::vector<irr::u32> vertexStart;
+	std::vector<irr::u32> vertices;
+};
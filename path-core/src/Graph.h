@@ -0,0 +1,109 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+#include <string>
+
+#include "Arena.h"
+
+struct Node;
+
+/**
+ * Represents an edge between two nodes.
+ * The weight is the distance between the two nodes.
+ */
+struct Edge {
+	irr::f32 weight;
+	Node* from;
+	Node* to;
+	Edge() : from(nullptr), to(nullptr), weight(0.0f) {}
+	Edge(irr::f32 weight, Node* from, Node* to) : from(from), to(to), weight(weight) {}
+};
+
+/**
+ * The edges leaving a node. The edges themselves live in the graph's
+ * arena (see Graph::setEdges).
+ */
+struct EdgeArray {
+	Edge* data;
+	irr::u32 count;
+	EdgeArray() : data(nullptr), count(0) {}
+	irr::u32 size() const { return count; }
+	Edge& operator[](irr::u32 i) { return data[i]; }
+	const Edge& operator[](irr::u32 i) const { return data[i]; }
+};
+
+/**
+ * Represents a single Node on the Buckminsterfullerene structure.
+ * The id is the index the node was generated with, and stays the same
+ * when the nodes are reordered in memory (see GraphOrdering.h).
+ * The index is the node's current position in the nodes vector, and can
+ * be used to look up per-node side arrays such as NodePositions.
+ */
+struct Node {
+	const char* name;
+	irr::u32 id;
+	irr::u32 index;
+	irr::core::vector3df position;
+	irr::video::SColor color;
+	EdgeArray edges;
+	Node* parent;
+	bool visited;
+	bool passable;
+	irr::f32 f;
+	irr::f32 g;
+	irr::f32 h;
+	void reset() { f = g = h = 0; }
+	Node(const char* name, irr::core::vector3df pos, irr::video::SColor color, bool passable) : f(0), g(0), h(0), id(0), index(0), position(pos), color(color), visited(false), name(name), parent(nullptr), passable(passable) {};
+	friend bool operator<(const Node& l, const Node& r) {
+		return l.h < r.h;
+	}
+	friend bool operator>(const Node& l, const Node& r) {
+		return l.h > r.h;
+	}
+};
+
+/**
+ * Owns the nodes of a graph.
+ *
+ * Nodes and their edges are allocated from one arena, and the node names
+ * from another (so the names survive ReorderNodes, which rebuilds the
+ * node arena). Everything is freed in bulk when the graph is destroyed.
+ */
+class Graph {
+public:
+	std::vector<Node*> nodes;
+
+	Graph() : nodeArena(256 * 1024), nameArena(16 * 1024) {}
+
+	/**
+	 * Adds a node without edges. Its id and index are its position in nodes.
+	 */
+	Node* addNode(const std::string& name, irr::core::vector3df pos, irr::video::SColor color, bool passable) {
+		Node* node = nodeArena.create<Node>(nameArena.copyString(name.c_str()), pos, color, passable);
+		node->id = nodes.size();
+		node->index = nodes.size();
+		nodes.push_back(node);
+		return node;
+	}
+
+	/**
+	 * Replaces the edges of a node with a copy of the given edges.
+	 */
+	void setEdges(Node* node, const Edge* edges, irr::u32 count) {
+		node->edges.data = nodeArena.allocateArray<Edge>(count);
+		node->edges.count = count;
+		for (irr::u32 i = 0; i < count; ++i) {
+			new (&node->edges.data[i]) Edge(edges[i]);
+		}
+	}
+
+	Arena& getNodeArena() { return nodeArena; }
+
+private:
+	Graph(const Graph&);
+	Graph& operator=(const Graph&);
+
+	Arena nodeArena;
+	Arena nameArena;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "Graph.h"
+
+/**
+ * Node reordering for memory locality.
+ *
+ * GenerateNodes pushes nodes in whatever order they are listed, so nodes
+ * that are neighbours in the graph can be far apart in memory and every
+ * edge relaxation in the planner touches a new cache line. The functions
+ * below compute a better order and renumber the graph to match it.
+ *
+ * An order is a vector where order[newIndex] = oldIndex. Node::id is
+ * never changed, so it can always be used to map back to the original
+ * numbering (for console output, user input and scene node labels).
+ */
+
+/**
+ * Number of bits per axis used when quantizing positions for the
+ * Hilbert curve. 3 axes * 10 bits fits in a u32 key.
+ */
+const irr::u32 HILBERT_BITS = 10;
+
+/**
+ * Maps a quantized 3d point to its distance along the Hilbert curve.
+ * Based on John Skilling, "Programming the Hilbert curve" (2004):
+ * the axes are converted in place to the transposed Hilbert index,
+ * whose bits are then interleaved into a single key.
+ */
+inline irr::u32 HilbertKey(irr::u32 x, irr::u32 y, irr::u32 z) {
+	irr::u32 X[3] = { x, y, z };
+	const irr::u32 M = 1u << (HILBERT_BITS - 1);
+
+	// inverse undo
+	for (irr::u32 Q = M; Q > 1; Q >>= 1) {
+		irr::u32 P = Q - 1;
+		for (irr::u32 i = 0; i < 3; ++i) {
+			if (X[i] & Q) {
+				X[0] ^= P;
+			} else {
+				irr::u32 t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// gray encode
+	for (irr::u32 i = 1; i < 3; ++i) X[i] ^= X[i - 1];
+	irr::u32 t = 0;
+	for (irr::u32 Q = M; Q > 1; Q >>= 1) {
+		if (X[2] & Q) t ^= Q - 1;
+	}
+	for (irr::u32 i = 0; i < 3; ++i) X[i] ^= t;
+
+	// interleave the transposed bits, most significant first
+	irr::u32 key = 0;
+	for (irr::s32 bit = HILBERT_BITS - 1; bit >= 0; --bit) {
+		for (irr::u32 i = 0; i < 3; ++i) {
+			key = (key << 1) | ((X[i] >> bit) & 1);
+		}
+	}
+	return key;
+}
+
+/**
+ * Orders the nodes along a 3d Hilbert curve through their positions, so
+ * nodes that are close in space end up close in memory.
+ */
+inline std::vector<irr::u32> HilbertOrder(const std::vector<Node*>& nodes) {
+	std::vector<irr::u32> order(nodes.size());
+	if (nodes.empty()) return order;
+
+	// bounding box of all positions
+	irr::core::aabbox3df box(nodes[0]->position);
+	for (irr::u32 i = 1; i < nodes.size(); ++i) {
+		box.addInternalPoint(nodes[i]->position);
+	}
+
+	// quantize every position into the [0, 2^bits) grid
+	const irr::f32 cells = (irr::f32)((1u << HILBERT_BITS) - 1);
+	const irr::core::vector3df extent = box.getExtent();
+	const irr::core::vector3df scale(
+		extent.X > 0.0f ? cells / extent.X : 0.0f,
+		extent.Y > 0.0f ? cells / extent.Y : 0.0f,
+		extent.Z > 0.0f ? cells / extent.Z : 0.0f);
+
+	std::vector<irr::u32> keys(nodes.size());
+	for (irr::u32 i = 0; i < nodes.size(); ++i) {
+		irr::core::vector3df p = (nodes[i]->position - box.MinEdge) * scale;
+		keys[i] = HilbertKey((irr::u32)p.X, (irr::u32)p.Y, (irr::u32)p.Z);
+		order[i] = i;
+	}
+
+	// stable, so nodes in the same cell keep their generated order
+	std::stable_sort(order.begin(), order.end(), [&keys](irr::u32 l, irr::u32 r) {
+		return keys[l] < keys[r];
+	});
+	return order;
+}
+
+/**
+ * Orders the nodes with the reverse Cuthill-McKee algorithm, which keeps
+ * the ids of adjacent nodes close together (it minimises the bandwidth
+ * of the adjacency matrix). Edges are treated as undirected, and each
+ * connected component is started from its lowest degree node.
+ */
+inline std::vector<irr::u32> ReverseCuthillMcKeeOrder(const std::vector<Node*>& nodes) {
+	const irr::u32 count = nodes.size();
+
+	std::unordered_map<const Node*, irr::u32> index;
+	for (irr::u32 i = 0; i < count; ++i) {
+		index[nodes[i]] = i;
+	}
+
+	// build the undirected adjacency list
+	std::vector<std::vector<irr::u32> > adjacency(count);
+	for (irr::u32 i = 0; i < count; ++i) {
+		for (irr::u32 j = 0; j < nodes[i]->edges.size(); ++j) {
+			irr::u32 to = index[nodes[i]->edges[j].to];
+			adjacency[i].push_back(to);
+			adjacency[to].push_back(i);
+		}
+	}
+	for (irr::u32 i = 0; i < count; ++i) {
+		std::sort(adjacency[i].begin(), adjacency[i].end());
+		adjacency[i].erase(std::unique(adjacency[i].begin(), adjacency[i].end()), adjacency[i].end());
+	}
+
+	auto byDegree = [&adjacency](irr::u32 l, irr::u32 r) {
+		return adjacency[l].size() < adjacency[r].size();
+	};
+
+	// candidate start nodes, lowest degree first
+	std::vector<irr::u32> starts(count);
+	for (irr::u32 i = 0; i < count; ++i) starts[i] = i;
+	std::stable_sort(starts.begin(), starts.end(), byDegree);
+
+	std::vector<bool> visited(count, false);
+	std::vector<irr::u32> order;
+	order.reserve(count);
+
+	for (irr::u32 s = 0; s < count; ++s) {
+		if (visited[starts[s]]) continue;
+
+		// breadth first search, using the order itself as the queue
+		irr::u32 head = order.size();
+		order.push_back(starts[s]);
+		visited[starts[s]] = true;
+
+		while (head < order.size()) {
+			irr::u32 current = order[head++];
+			irr::u32 first = order.size();
+			for (irr::u32 j = 0; j < adjacency[current].size(); ++j) {
+				irr::u32 next = adjacency[current][j];
+				if (!visited[next]) {
+					visited[next] = true;
+					order.push_back(next);
+				}
+			}
+			// visit the new neighbours in increasing degree
+			std::stable_sort(order.begin() + first, order.end(), byDegree);
+		}
+	}
+
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+/**
+ * Inverts an order, so that inverse[oldIndex] = newIndex.
+ */
+inline std::vector<irr::u32> InverseOrder(const std::vector<irr::u32>& order) {
+	std::vector<irr::u32> inverse(order.size());
+	for (irr::u32 i = 0; i < order.size(); ++i) {
+		inverse[order[i]] = i;
+	}
+	return inverse;
+}
+
+/**
+ * Applies an order to a per-node side array, so that it lines up with
+ * the reordered nodes.
+ */
+template <class T>
+std::vector<T> PermuteArray(const std::vector<T>& values, const std::vector<irr::u32>& order) {
+	std::vector<T> permuted;
+	permuted.reserve(order.size());
+	for (irr::u32 i = 0; i < order.size(); ++i) {
+		permuted.push_back(values[order[i]]);
+	}
+	return permuted;
+}
+
+/**
+ * Renumbers the nodes of the graph to match the given order.
+ *
+ * The nodes and their edges are copied into a new arena in their new
+ * order (so they are laid out in memory in that order), all edge and
+ * parent pointers are redirected to the copies, and the old arena is
+ * released in one go.
+ * Node::index is updated, so side arrays built from the old nodes vector
+ * must be permuted (or rebuilt) as well.
+ */
+inline void ReorderNodes(Graph& graph, const std::vector<irr::u32>& order) {
+	const std::vector<Node*>& nodes = graph.nodes;
+	std::unordered_map<const Node*, irr::u32> index;
+	for (irr::u32 i = 0; i < nodes.size(); ++i) {
+		index[nodes[i]] = i;
+	}
+	const std::vector<irr::u32> inverse = InverseOrder(order);
+
+	Arena arena;
+	std::vector<Node*> reordered;
+	reordered.reserve(order.size());
+	for (irr::u32 i = 0; i < order.size(); ++i) {
+		reordered.push_back(arena.create<Node>(*nodes[order[i]]));
+	}
+
+	for (irr::u32 i = 0; i < reordered.size(); ++i) {
+		Node* node = reordered[i];
+		node->index = i;
+		Edge* edges = arena.allocateArray<Edge>(node->edges.size());
+		for (irr::u32 j = 0; j < node->edges.size(); ++j) {
+			new (&edges[j]) Edge(node->edges[j].weight, node, reordered[inverse[index[node->edges[j].to]]]);
+		}
+		node->edges.data = edges;
+		if (node->parent) {
+			node->parent = reordered[inverse[index[node->parent]]];
+		}
+	}
+
+	// the old nodes are freed when arena goes out of scope
+	graph.getNodeArena().swap(arena);
+	graph.nodes.swap(reordered);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+
+#include "Graph.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PATH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PATH_TARGET_SSE
+#define PATH_TARGET_AVX
+#else
+#include <cpuid.h>
+#define PATH_TARGET_SSE __attribute__((target("sse")))
+#define PATH_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+/**
+ * Node positions in structure-of-arrays form, in the same order as the
+ * nodes vector (so Node::index can be used to look a node up).
+ * Keeping x, y and z in separate arrays lets the heuristic be computed
+ * for several nodes at once with SSE/AVX.
+ */
+struct NodePositions {
+	std::vector<irr::f32> x;
+	std::vector<irr::f32> y;
+	std::vector<irr::f32> z;
+	NodePositions() {}
+	NodePositions(const std::vector<Node*>& nodes) : x(nodes.size()), y(nodes.size()), z(nodes.size()) {
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			x[i] = nodes[i]->position.X;
+			y[i] = nodes[i]->position.Y;
+			z[i] = nodes[i]->position.Z;
+		}
+	}
+	irr::u32 size() const { return x.size(); }
+};
+
+/**
+ * A heuristic kernel writes the straight line distance from every
+ * position in [begin, end) to the target into out.
+ * All kernels give the same results as vector3df::getDistanceFrom.
+ */
+typedef void (*HeuristicKernel)(const NodePositions& positions, const irr::core::vector3df& target, irr::f32* out, irr::u32 begin, irr::u32 end);
+
+/**
+ * Scalar kernel, used on CPUs without SSE and for the remainder of the
+ * vectorized kernels.
+ */
+inline void HeuristicScalar(const NodePositions& positions, const irr::core::vector3df& target, irr::f32* out, irr::u32 begin, irr::u32 end) {
+	for (irr::u32 i = begin; i < end; ++i) {
+		irr::f32 dx = positions.x[i] - target.X;
+		irr::f32 dy = positions.y[i] - target.Y;
+		irr::f32 dz = positions.z[i] - target.Z;
+		out[i] = sqrtf(dx * dx + dy * dy + dz * dz);
+	}
+}
+
+#ifdef PATH_X86
+/**
+ * SSE kernel, 4 nodes at a time.
+ */
+PATH_TARGET_SSE inline void HeuristicSSE(const NodePositions& positions, const irr::core::vector3df& target, irr::f32* out, irr::u32 begin, irr::u32 end) {
+	const __m128 tx = _mm_set1_ps(target.X);
+	const __m128 ty = _mm_set1_ps(target.Y);
+	const __m128 tz = _mm_set1_ps(target.Z);
+	irr::u32 i = begin;
+	for (; i + 4 <= end; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(&positions.x[i]), tx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(&positions.y[i]), ty);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(&positions.z[i]), tz);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		_mm_storeu_ps(&out[i], _mm_sqrt_ps(sq));
+	}
+	HeuristicScalar(positions, target, out, i, end);
+}
+
+/**
+ * AVX kernel, 8 nodes at a time.
+ */
+PATH_TARGET_AVX inline void HeuristicAVX(const NodePositions& positions, const irr::core::vector3df& target, irr::f32* out, irr::u32 begin, irr::u32 end) {
+	const __m256 tx = _mm256_set1_ps(target.X);
+	const __m256 ty = _mm256_set1_ps(target.Y);
+	const __m256 tz = _mm256_set1_ps(target.Z);
+	irr::u32 i = begin;
+	for (; i + 8 <= end; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&positions.x[i]), tx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&positions.y[i]), ty);
+		__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&positions.z[i]), tz);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+		_mm256_storeu_ps(&out[i], _mm256_sqrt_ps(sq));
+	}
+	HeuristicScalar(positions, target, out, i, end);
+}
+
+/**
+ * Asks the CPU which instruction sets it supports.
+ * AVX also needs the OS to save the ymm registers (checked with xgetbv).
+ */
+inline void DetectCPU(bool& sse, bool& avx) {
+	unsigned int ecx, edx;
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	ecx = info[2];
+	edx = info[3];
+#else
+	unsigned int eax, ebx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		sse = avx = false;
+		return;
+	}
+#endif
+	sse = (edx & (1 << 25)) != 0;
+	avx = false;
+	const bool osxsave = (ecx & (1 << 27)) != 0;
+	if (osxsave && (ecx & (1 << 28))) {
+#if defined(_MSC_VER)
+		unsigned long long xcr0 = _xgetbv(0);
+#else
+		unsigned int xlo, xhi;
+		__asm__("xgetbv" : "=a"(xlo), "=d"(xhi) : "c"(0));
+		unsigned long long xcr0 = ((unsigned long long)xhi << 32) | xlo;
+#endif
+		avx = (xcr0 & 6) == 6;
+	}
+}
+#endif
+
+/**
+ * Picks the fastest kernel the CPU supports. The choice is made once and
+ * then cached.
+ */
+inline HeuristicKernel GetHeuristicKernel() {
+	static HeuristicKernel kernel = 0;
+	if (!kernel) {
+		kernel = HeuristicScalar;
+#ifdef PATH_X86
+		bool sse, avx;
+		DetectCPU(sse, avx);
+		if (avx) kernel = HeuristicAVX;
+		else if (sse) kernel = HeuristicSSE;
+#endif
+	}
+	return kernel;
+}
+
+/**
+ * Computes the heuristic (straight line distance to the target) of every
+ * node in one batched pass.
+ */
+inline void ComputeHeuristics(const NodePositions& positions, const irr::core::vector3df& target, std::vector<irr::f32>& out) {
+	out.resize(positions.size());
+	if (positions.size() > 0) {
+		GetHeuristicKernel()(positions, target, &out[0], 0, positions.size());
+	}
+}
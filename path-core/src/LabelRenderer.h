@@ -0,0 +1,118 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <vector>
+#include <string>
+
+#include "Graph.h"
+
+/**
+ * Draws the id of every graph node as a text label at the node.
+ *
+ * The glyphs of all labels are collected and drawn with a single sprite
+ * batch of the font, instead of one text scene node per graph node which
+ * is registered, projected and drawn on its own. The glyphs of a label
+ * are laid out once, so a frame only projects the node positions.
+ *
+ * Fonts which are not bitmap fonts have no sprite bank, and are drawn one
+ * label at a time.
+ */
+class LabelRenderer {
+public:
+	/**
+	 * Lays out the labels of the nodes. The label of a node is centred on
+	 * the node's position plus offset.
+	 */
+	LabelRenderer(const std::vector<Node*>& nodes, irr::gui::IGUIFont* font, const irr::core::vector3df& offset)
+		: font(font), bitmapFont(0), glyphStart(1, 0) {
+		font->grab();
+		if (font->getType() == irr::gui::EGFT_BITMAP) {
+			bitmapFont = static_cast<irr::gui::IGUIFontBitmap*>(font);
+		}
+
+		for (irr::u32 i = 0; i < nodes.size(); ++i) {
+			positions.push_back(nodes[i]->position + offset);
+			texts.push_back(std::to_wstring(nodes[i]->id));
+
+			if (bitmapFont) {
+				// glyph offsets from the centre of the label, as the font
+				// would place them when drawing the label centred
+				const std::wstring& text = texts.back();
+				const irr::core::dimension2d<irr::u32> size = font->getDimension(text.c_str());
+				irr::core::position2di pen(-(irr::s32)(size.Width >> 1), -(irr::s32)(size.Height >> 1));
+				for (irr::u32 j = 0; j < text.size(); ++j) {
+					const wchar_t glyph[2] = { text[j], 0 };
+					glyphSprites.push_back(bitmapFont->getSpriteNoFromChar(glyph));
+					glyphOffsets.push_back(pen);
+					pen.X += font->getDimension(glyph).Width;
+				}
+			}
+			glyphStart.push_back(glyphSprites.size());
+		}
+	}
+
+	~LabelRenderer() {
+		font->drop();
+	}
+
+	/**
+	 * Draws the labels of all nodes in front of the camera.
+	 */
+	void draw(irr::video::IVideoDriver* driver, const irr::scene::ICameraSceneNode* camera, irr::video::SColor color) {
+		const irr::core::dimension2d<irr::u32> screen = driver->getCurrentRenderTargetSize();
+		const irr::s32 halfWidth = screen.Width / 2;
+		const irr::s32 halfHeight = screen.Height / 2;
+
+		irr::core::matrix4 viewProj = camera->getProjectionMatrix();
+		viewProj *= camera->getViewMatrix();
+
+		sprites.set_used(0);
+		spritePositions.set_used(0);
+
+		for (irr::u32 i = 0; i < positions.size(); ++i) {
+			irr::f32 p[4] = { positions[i].X, positions[i].Y, positions[i].Z, 1.0f };
+			viewProj.multiplyWith1x4Matrix(p);
+			// behind the camera
+			if (p[3] < 0) continue;
+
+			const irr::f32 zDiv = p[3] == 0.0f ? 1.0f : irr::core::reciprocal(p[3]);
+			const irr::core::position2di centre(
+				halfWidth + irr::core::round32(halfWidth * (p[0] * zDiv)),
+				halfHeight - irr::core::round32(halfHeight * (p[1] * zDiv)));
+
+			if (!bitmapFont) {
+				font->draw(texts[i].c_str(), irr::core::rect<irr::s32>(centre, irr::core::dimension2d<irr::s32>(1, 1)), color, true, true);
+				continue;
+			}
+
+			for (irr::u32 j = glyphStart[i]; j < glyphStart[i + 1]; ++j) {
+				sprites.push_back(glyphSprites[j]);
+				spritePositions.push_back(centre + glyphOffsets[j]);
+			}
+		}
+
+		if (bitmapFont && !sprites.empty()) {
+			bitmapFont->getSpriteBank()->draw2DSpriteBatch(sprites, spritePositions, 0, color);
+		}
+	}
+
+private:
+	LabelRenderer(const LabelRenderer&);
+	LabelRenderer& operator=(const LabelRenderer&);
+
+	irr::gui::IGUIFont* font;
+	irr::gui::IGUIFontBitmap* bitmapFont;
+
+	std::vector<irr::core::vector3df> positions;
+	std::vector<std::wstring> texts;
+
+	// the glyphs of the label of node i are glyphSprites[glyphStart[i]] to
+	// glyphSprites[glyphStart[i + 1] - 1]
+	std::vector<irr::u32> glyphStart;
+	std::vector<irr::u32> glyphSprites;
+	std::vector<irr::core::position2di> glyphOffsets;
+
+	// the batch of the current frame, kept to reuse its memory
+	irr::core::array<irr::u32> sprites;
+	irr::core::array<irr::core::position2di> spritePositions;
+};
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <irrlicht.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "Graph.h"
+#include "Heuristic.h"
+
+/**
+ * Policies for BasicAStarSearch (see AStarSearch.h).
+ *
+ * Each policy is a plain class whose members the search calls directly,
+ * so every combination is inlined into the search loop; there are no
+ * virtual calls. The first policy of each kind is the one that behaves
+ * like the original planner.
+ */
+
+/**
+ * Removes the node from the list
+ */
+inline void listRemove(std::vector<Node*> &nodes, Node* value) {
+	nodes.erase(std::remove(nodes.begin(), nodes.end(), value), nodes.end());
+}
+
+/**
+ * Adds the node to the list
+ */
+inline void listAdd(std::vector<Node*> &nodes, Node* value) {
+	nodes.push_back(value);
+}
+
+/**
+ * Finds the index of the item in the list. If it is not found, return -1
+ */
+inline int listFind(std::vector<Node*> &nodes, Node* value) {
+	std::vector<Node*>::iterator it = std::find(nodes.begin(), nodes.end(), value);
+	// return -1 if not found
+	if (it == nodes.end()) return -1;
+	// return the index of the element
+	return (it - nodes.begin());
+}
+
+/**
+ * HEURISTICS
+ * prepare() is called once when the search starts, then the heuristic is
+ * called for every node added to the open list.
+ */
+
+/**
+ * Straight line distance to the end node, computed for every node in one
+ * vectorized pass (see Heuristic.h) and looked up by Node::index.
+ */
+class EuclideanHeuristic {
+public:
+	void prepare(const NodePositions& positions, const Node* end) {
+		ComputeHeuristics(positions, end->position, heuristics);
+	}
+	irr::f32 operator()(const Node* node) const { return heuristics[node->index]; }
+private:
+	std::vector<irr::f32> heuristics;
+};
+
+/**
+ * No heuristic at all.
+ */
+class ZeroHeuristic {
+public:
+	void prepare(const NodePositions& positions, const Node* end) {}
+	irr::f32 operator()(const Node* node) const { return 0.0f; }
+};
+
+/**
+ * EDGE COSTS
+ * The cost of moving along an edge, added to G.
+ */
+
+/**
+ * The length of the edge.
+ */
+struct EdgeWeightCost {
+	irr::f32 operator()(const Edge& edge) const { return edge.weight; }
+};
+
+/**
+ * Every edge costs the same, so G counts the edges on the path.
+ */
+struct UnitEdgeCost {
+	irr::f32 operator()(const Edge& edge) const { return 1.0f; }
+};
+
+/**
+ * OPEN LISTS
+ * The open lists take the key they are ordered by (lowest first) as a
+ * template parameter. ByH is the ordering of the original planner, ByF
+ * is the textbook A* ordering (with ZeroHeuristic it is Dijkstra).
+ * update() is called after a node already in the list gets a better G.
+ */
+
+struct ByH {
+	irr::f32 operator()(const Node* node) const { return node->h; }
+};
+
+struct ByF {
+	irr::f32 operator()(const Node* node) const { return node->f; }
+};
+
+/**
+ * A vector that is sorted before every pop. Membership is a linear search.
+ */
+template <class Key>
+class SortedOpenList {
+public:
+	void reset(irr::u32 nodeCount) { list.clear(); }
+	bool empty() const { return list.empty(); }
+	void push(Node* node) { listAdd(list, node); }
+	bool contains(Node* node) { return listFind(list, node) != -1; }
+	void update(Node* node) { sort(); } // resort list
+	Node* pop() {
+		sort();
+		Node* node = list[0];
+		listRemove(list, node);
+		return node;
+	}
+private:
+	void sort() {
+		Key key;
+		std::sort(list.begin(), list.end(), [&key](const Node* l, const Node* r) {
+			return key(l) < key(r);
+		});
+	}
+
+	std::vector<Node*> list;
+};
+
+/**
+ * A binary heap with a membership flag per node (by Node::index).
+ * update() pushes the node again with its new key; the old entry is
+ * skipped when it reaches the top because the node is no longer open.
+ */
+template <class Key>
+class BinaryHeapOpenList {
+public:
+	void reset(irr::u32 nodeCount) {
+		heap.clear();
+		open.assign(nodeCount, false);
+	}
+	bool empty() {
+		discardStale();
+		return heap.empty();
+	}
+	void push(Node* node) {
+		open[node->index] = true;
+		heap.push_back(Entry(key(node), node));
+		std::push_heap(heap.begin(), heap.end());
+	}
+	bool contains(Node* node) { return open[node->index]; }
+	void update(Node* node) {
+		heap.push_back(Entry(key(node), node));
+		std::push_heap(heap.begin(), heap.end());
+	}
+	Node* pop() {
+		discardStale();
+		Node* node = heap.front().node;
+		std::pop_heap(heap.begin(), heap.end());
+		heap.pop_back();
+		open[node->index] = false;
+		return node;
+	}
+private:
+	struct Entry {
+		irr::f32 key;
+		Node* node;
+		Entry(irr::f32 key, Node* node) : key(key), node(node) {}
+		// reversed, so the std heap functions keep the lowest key on top
+		bool operator<(const Entry& other) const { return key > other.key; }
+	};
+
+	void discardStale() {
+		while (!heap.empty() && !open[heap.front().node->index]) {
+			std::pop_heap(heap.begin(), heap.end());
+			heap.pop_back();
+		}
+	}
+
+	Key key;
+	std::vector<Entry> heap;
+	std::vector<bool> open;
+};
+
+/**
+ * CLOSED SETS
+ */
+
+/**
+ * A vector of closed nodes. Membership is a linear search.
+ */
+class ListClosedSet {
+public:
+	void reset(irr::u32 nodeCount) { list.clear(); }
+	void insert(Node* node) { listAdd(list, node); }
+	bool contains(Node* node) { return listFind(list, node) != -1; }
+private:
+	std::vector<Node*> list;
+};
+
+/**
+ * One flag per node (by Node::index).
+ */
+class FlagClosedSet {
+public:
+	void reset(irr::u32 nodeCount) { closed.assign(nodeCount, false); }
+	void insert(Node* node) { closed[node->index] = true; }
+	bool contains(Node* node) const { return closed[node->index]; }
+private:
+	std::vector<bool> closed;
+};
+
+/**
+ * TRACERS
+ * Told about every expanded node and about a failed search.
+ */
+
+/**
+ * Prints the search to the console, like the original planner.
+ */
+struct ConsoleTracer {
+	void expanded(const Node* node) { std::cout << node->name << std::endl; }
+	void noPath() {
+		std::cout << "OPENLIST EMPTY" << std::endl;
+		// NO PATH FOUND
+		std::cout << "Really, no path found." << std::endl;
+	}
+};
+
+/**
+ * Prints nothing.
+ */
+struct NullTracer {
+	void expanded(const Node* node) {}
+	void noPath() {}
+};
@@ -4,6 +4,12 @@
 #include <string>
 #include <algorithm>
 
+#include "Graph.h"
+#include "GraphOrdering.h"
+#include "AStarSearch.h"
+#include "EdgeRenderer.h"
+#include "LabelRenderer.h"
+
 using namespace irr;
 using namespace core;
 using namespace scene;
@@ -145,6 +151,7 @@ class NodeShaderCallBack : public video::IShaderConstantSetCallBack
 public:
 	NodeShaderCallBack(): IShaderConstantSetCallBack() {
 		color = SColorf();
+		nodeColor = SColorf(1.0f, 1.0f, 1.0f, 1.0f);
 	}
 	virtual void OnSetConstants(video::IMaterialRendererServices* services, s32 userData)
 	{
@@ -170,9 +177,10 @@ public:
 		core::vector3df pos = device->getSceneManager()->getActiveCamera()->getAbsolutePosition();
 		services->setVertexShaderConstant("mLightPos", reinterpret_cast<f32*>(&pos), 3);
 
-		// set light color
+		// set light color, tinted with the colour of the node being drawn
 
-		services->setVertexShaderConstant("mLightColor", reinterpret_cast<f32*>(&color), 4);
+		SColorf lightColor(color.r * nodeColor.r, color.g * nodeColor.g, color.b * nodeColor.b, color.a * nodeColor.a);
+		services->setVertexShaderConstant("mLightColor", reinterpret_cast<f32*>(&lightColor), 4);
 
 		// set transposed world matrix
 
@@ -185,162 +193,131 @@ public:
 		s32 TextureLayerID = 0;
 		services->setPixelShaderConstant("myTexture", &TextureLayerID, 1);
 	}
+	// the instanced node passes the colour of each node as the diffuse colour
+	virtual void OnSetMaterial(const video::SMaterial& material)
+	{
+		nodeColor = SColorf(material.DiffuseColor);
+	}
 	void setColour(SColorf color) {
 		this->color = color;
 	}
 
 private:
 	SColorf color;
+	SColorf nodeColor;
 };
 
-struct Node;
-
 /**
- * Represents an edge between two nodes.
- * The weight is the distance between the two nodes.
+ * Fills the graph with nodes represending the Buckminsterfullerene structure in 3d space
  */
-struct Edge {
-	f32 weight;
-	Node* from;
-	Node* to;
-	Edge() : from(nullptr), to(nullptr), weight(0.0f) {}
-	Edge(f32 weight, Node* from, Node* to) : from(from), to(to), weight(weight) {}
-};
-
-/**
- * Represents a single Node on the Buckminsterfullerene structure.
- */
-struct Node {
-	std::string name;
-	vector3df position;
-	SColor color;
-	vector<Edge> edges;
-	Node* parent;
-	bool visited;
-	bool passable;
-	f32 f;
-	f32 g;
-	f32 h;
-	void reset() { f = g = h = 0; }
-	Node(std::string name, vector3df pos, SColor color, bool passable) : f(0), g(0), h(0), position(pos), color(color), visited(false), name(name), parent(nullptr), passable(passable) {};
-	friend bool operator<(const Node& l, const Node& r) {
-		return l.h < r.h;
-	}
-	friend bool operator>(const Node& l, const Node& r) {
-		return l.h > r.h;
-	}
-};
-
-/**
- * Creates a vector of nodes represending the Buckminsterfullerene structure in 3d space
- */
-vector<Node*> GenerateNodes() {
+void GenerateNodes(Graph& graph) {
 	float o = (1.0f + sqrt(5.0f)) / 2.0f;
-	vector<Node*> nodes;
+	vector<Node*>& nodes = graph.nodes;
 	int i = 0;
 	std::string title = "node ";
 
 	// add nodes to vector
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(0, 1, 3 * o)          , SColor(255,255,0,0), true )); // 00
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(0, 1, -3 * o)         , SColor(255,255,0,0), true )); // 01
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(0, -1, 3* o)          , SColor(255,255,0,0), true )); // 02
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(0, -1, -3* o)         , SColor(255,255,0,0), true )); // 03
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, 3* o, 0)           , SColor(255,255,0,0), true )); // 04
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, -3* o, 0)          , SColor(255,255,0,0), true )); // 05
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, 3* o, 0)          , SColor(255,255,0,0), true )); // 06
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, -3* o, 0)         , SColor(255,255,0,0), true )); // 07
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(3* o, 0, 1)           , SColor(255,255,0,0), true )); // 08
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(3* o, 0, -1)          , SColor(255,255,0,0), true )); // 09
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-3* o, 0, 1)          , SColor(255,255,0,0), true )); // 10
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-3* o, 0, -1)         , SColor(255,255,0,0), true )); // 11
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2, (1 + 2* o), o)     , SColor(255,255,0,0), true )); // 12
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2, (1 + 2* o), -o)    , SColor(255,255,0,0), true )); // 13
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2, -(1 + 2* o), o)    , SColor(255,255,0,0), true )); // 14
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2, -(1 + 2* o), -o)   , SColor(255,255,0,0), true )); // 15
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2, (1 + 2* o), o)    , SColor(255,255,0,0), true )); // 16
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2, (1 + 2* o), -o)   , SColor(255,255,0,0), true )); // 17
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2, -(1 + 2* o), o)   , SColor(255,255,0,0), true )); // 18
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2, -(1 + 2* o), -o)  , SColor(255,255,0,0), true )); // 19
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((1 + 2* o), o, 2)     , SColor(255,255,0,0), true )); // 20
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((1 + 2* o), o, -2)    , SColor(255,255,0,0), true )); // 21
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((1 + 2* o), -o, 2)    , SColor(255,255,0,0), true )); // 22
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((1 + 2* o), -o, -2)   , SColor(255,255,0,0), true )); // 23
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(1 + 2* o), o, 2)    , SColor(255,255,0,0), true )); // 24
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(1 + 2* o), o, -2)   , SColor(255,255,0,0), true )); // 25
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(1 + 2* o), -o, 2)   , SColor(255,255,0,0), true )); // 26
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(1 + 2* o), -o, -2)  , SColor(255,255,0,0), true )); // 27
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(o, 2, (1 + 2* o))     , SColor(255,255,0,0), true )); // 28
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(o, 2, -(1 + 2* o))    , SColor(255,255,0,0), true )); // 29
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(o, -2, (1 + 2* o))    , SColor(255,255,0,0), true )); // 30
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(o, -2, -(1 + 2* o))   , SColor(255,255,0,0), true )); // 31
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-o, 2, (1 + 2* o))    , SColor(255,255,0,0), true)); // 32
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-o, 2, -(1 + 2* o))   , SColor(255,255,0,0), true )); // 33
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-o, -2, (1 + 2* o))   , SColor(255,255,0,0), true )); // 34
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-o, -2, -(1 + 2* o))  , SColor(255,255,0,0), true )); // 35
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, (2 + o), 2* o)     , SColor(255,255,0,0), true )); // 36
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, (2 + o), -2* o)    , SColor(255,255,0,0), true )); // 37
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, -(2 + o), 2* o)    , SColor(255,255,0,0), true )); // 38
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(1, -(2 + o), -2* o)   , SColor(255,255,0,0), true )); // 39
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, (2 + o), 2* o)    , SColor(255,255,0,0), true )); // 40
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, (2 + o), -2* o)   , SColor(255,255,0,0), true )); // 41
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, -(2 + o), 2* o)   , SColor(255,255,0,0), true )); // 42
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-1, -(2 + o), -2* o)  , SColor(255,255,0,0), true )); // 43
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((2 + o), 2* o, 1)     , SColor(255,255,0,0), true )); // 44
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((2 + o), 2* o, -1)    , SColor(255,255,0,0), true )); // 45
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((2 + o), -2* o, 1)    , SColor(255,255,0,0), true )); // 46
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df((2 + o), -2* o, -1)   , SColor(255,255,0,0), true )); // 47
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(2 + o), 2* o, 1)    , SColor(255,255,0,0), true )); // 48
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(2 + o), 2* o, -1)   , SColor(255,255,0,0), true )); // 49
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(2 + o), -2* o, 1)   , SColor(255,255,0,0), true )); // 50
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-(2 + o), -2* o, -1)  , SColor(255,255,0,0), true )); // 51
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2* o, 1, (2 + o))     , SColor(255,255,0,0), true )); // 52
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2* o, 1, -(2 + o))    , SColor(255,255,0,0), true )); // 53
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2* o, -1, (2 + o))    , SColor(255,255,0,0), true )); // 54
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(2* o, -1, -(2 + o))   , SColor(255,255,0,0), true )); // 55
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2 * o, 1, (2 + o))   , SColor(255,255,0,0), true )); // 56
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2 * o, 1, -(2 + o))  , SColor(255,255,0,0), true )); // 57
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2 * o, -1, (2 + o))  , SColor(255,255,0,0), true )); // 58
-	nodes.push_back(new Node(title + std::to_string(i++), vector3df(-2 * o, -1, -(2 + o)) , SColor(255,255,0,0), true )); // 59
+	graph.addNode(title + std::to_string(i++), vector3df(0, 1, 3 * o)          , SColor(255,255,0,0), true ); // 00
+	graph.addNode(title + std::to_string(i++), vector3df(0, 1, -3 * o)         , SColor(255,255,0,0), true ); // 01
+	graph.addNode(title + std::to_string(i++), vector3df(0, -1, 3* o)          , SColor(255,255,0,0), true ); // 02
+	graph.addNode(title + std::to_string(i++), vector3df(0, -1, -3* o)         , SColor(255,255,0,0), true ); // 03
+	graph.addNode(title + std::to_string(i++), vector3df(1, 3* o, 0)           , SColor(255,255,0,0), true ); // 04
+	graph.addNode(title + std::to_string(i++), vector3df(1, -3* o, 0)          , SColor(255,255,0,0), true ); // 05
+	graph.addNode(title + std::to_string(i++), vector3df(-1, 3* o, 0)          , SColor(255,255,0,0), true ); // 06
+	graph.addNode(title + std::to_string(i++), vector3df(-1, -3* o, 0)         , SColor(255,255,0,0), true ); // 07
+	graph.addNode(title + std::to_string(i++), vector3df(3* o, 0, 1)           , SColor(255,255,0,0), true ); // 08
+	graph.addNode(title + std::to_string(i++), vector3df(3* o, 0, -1)          , SColor(255,255,0,0), true ); // 09
+	graph.addNode(title + std::to_string(i++), vector3df(-3* o, 0, 1)          , SColor(255,255,0,0), true ); // 10
+	graph.addNode(title + std::to_string(i++), vector3df(-3* o, 0, -1)         , SColor(255,255,0,0), true ); // 11
+	graph.addNode(title + std::to_string(i++), vector3df(2, (1 + 2* o), o)     , SColor(255,255,0,0), true ); // 12
+	graph.addNode(title + std::to_string(i++), vector3df(2, (1 + 2* o), -o)    , SColor(255,255,0,0), true ); // 13
+	graph.addNode(title + std::to_string(i++), vector3df(2, -(1 + 2* o), o)    , SColor(255,255,0,0), true ); // 14
+	graph.addNode(title + std::to_string(i++), vector3df(2, -(1 + 2* o), -o)   , SColor(255,255,0,0), true ); // 15
+	graph.addNode(title + std::to_string(i++), vector3df(-2, (1 + 2* o), o)    , SColor(255,255,0,0), true ); // 16
+	graph.addNode(title + std::to_string(i++), vector3df(-2, (1 + 2* o), -o)   , SColor(255,255,0,0), true ); // 17
+	graph.addNode(title + std::to_string(i++), vector3df(-2, -(1 + 2* o), o)   , SColor(255,255,0,0), true ); // 18
+	graph.addNode(title + std::to_string(i++), vector3df(-2, -(1 + 2* o), -o)  , SColor(255,255,0,0), true ); // 19
+	graph.addNode(title + std::to_string(i++), vector3df((1 + 2* o), o, 2)     , SColor(255,255,0,0), true ); // 20
+	graph.addNode(title + std::to_string(i++), vector3df((1 + 2* o), o, -2)    , SColor(255,255,0,0), true ); // 21
+	graph.addNode(title + std::to_string(i++), vector3df((1 + 2* o), -o, 2)    , SColor(255,255,0,0), true ); // 22
+	graph.addNode(title + std::to_string(i++), vector3df((1 + 2* o), -o, -2)   , SColor(255,255,0,0), true ); // 23
+	graph.addNode(title + std::to_string(i++), vector3df(-(1 + 2* o), o, 2)    , SColor(255,255,0,0), true ); // 24
+	graph.addNode(title + std::to_string(i++), vector3df(-(1 + 2* o), o, -2)   , SColor(255,255,0,0), true ); // 25
+	graph.addNode(title + std::to_string(i++), vector3df(-(1 + 2* o), -o, 2)   , SColor(255,255,0,0), true ); // 26
+	graph.addNode(title + std::to_string(i++), vector3df(-(1 + 2* o), -o, -2)  , SColor(255,255,0,0), true ); // 27
+	graph.addNode(title + std::to_string(i++), vector3df(o, 2, (1 + 2* o))     , SColor(255,255,0,0), true ); // 28
+	graph.addNode(title + std::to_string(i++), vector3df(o, 2, -(1 + 2* o))    , SColor(255,255,0,0), true ); // 29
+	graph.addNode(title + std::to_string(i++), vector3df(o, -2, (1 + 2* o))    , SColor(255,255,0,0), true ); // 30
+	graph.addNode(title + std::to_string(i++), vector3df(o, -2, -(1 + 2* o))   , SColor(255,255,0,0), true ); // 31
+	graph.addNode(title + std::to_string(i++), vector3df(-o, 2, (1 + 2* o))    , SColor(255,255,0,0), true); // 32
+	graph.addNode(title + std::to_string(i++), vector3df(-o, 2, -(1 + 2* o))   , SColor(255,255,0,0), true ); // 33
+	graph.addNode(title + std::to_string(i++), vector3df(-o, -2, (1 + 2* o))   , SColor(255,255,0,0), true ); // 34
+	graph.addNode(title + std::to_string(i++), vector3df(-o, -2, -(1 + 2* o))  , SColor(255,255,0,0), true ); // 35
+	graph.addNode(title + std::to_string(i++), vector3df(1, (2 + o), 2* o)     , SColor(255,255,0,0), true ); // 36
+	graph.addNode(title + std::to_string(i++), vector3df(1, (2 + o), -2* o)    , SColor(255,255,0,0), true ); // 37
+	graph.addNode(title + std::to_string(i++), vector3df(1, -(2 + o), 2* o)    , SColor(255,255,0,0), true ); // 38
+	graph.addNode(title + std::to_string(i++), vector3df(1, -(2 + o), -2* o)   , SColor(255,255,0,0), true ); // 39
+	graph.addNode(title + std::to_string(i++), vector3df(-1, (2 + o), 2* o)    , SColor(255,255,0,0), true ); // 40
+	graph.addNode(title + std::to_string(i++), vector3df(-1, (2 + o), -2* o)   , SColor(255,255,0,0), true ); // 41
+	graph.addNode(title + std::to_string(i++), vector3df(-1, -(2 + o), 2* o)   , SColor(255,255,0,0), true ); // 42
+	graph.addNode(title + std::to_string(i++), vector3df(-1, -(2 + o), -2* o)  , SColor(255,255,0,0), true ); // 43
+	graph.addNode(title + std::to_string(i++), vector3df((2 + o), 2* o, 1)     , SColor(255,255,0,0), true ); // 44
+	graph.addNode(title + std::to_string(i++), vector3df((2 + o), 2* o, -1)    , SColor(255,255,0,0), true ); // 45
+	graph.addNode(title + std::to_string(i++), vector3df((2 + o), -2* o, 1)    , SColor(255,255,0,0), true ); // 46
+	graph.addNode(title + std::to_string(i++), vector3df((2 + o), -2* o, -1)   , SColor(255,255,0,0), true ); // 47
+	graph.addNode(title + std::to_string(i++), vector3df(-(2 + o), 2* o, 1)    , SColor(255,255,0,0), true ); // 48
+	graph.addNode(title + std::to_string(i++), vector3df(-(2 + o), 2* o, -1)   , SColor(255,255,0,0), true ); // 49
+	graph.addNode(title + std::to_string(i++), vector3df(-(2 + o), -2* o, 1)   , SColor(255,255,0,0), true ); // 50
+	graph.addNode(title + std::to_string(i++), vector3df(-(2 + o), -2* o, -1)  , SColor(255,255,0,0), true ); // 51
+	graph.addNode(title + std::to_string(i++), vector3df(2* o, 1, (2 + o))     , SColor(255,255,0,0), true ); // 52
+	graph.addNode(title + std::to_string(i++), vector3df(2* o, 1, -(2 + o))    , SColor(255,255,0,0), true ); // 53
+	graph.addNode(title + std::to_string(i++), vector3df(2* o, -1, (2 + o))    , SColor(255,255,0,0), true ); // 54
+	graph.addNode(title + std::to_string(i++), vector3df(2* o, -1, -(2 + o))   , SColor(255,255,0,0), true ); // 55
+	graph.addNode(title + std::to_string(i++), vector3df(-2 * o, 1, (2 + o))   , SColor(255,255,0,0), true ); // 56
+	graph.addNode(title + std::to_string(i++), vector3df(-2 * o, 1, -(2 + o))  , SColor(255,255,0,0), true ); // 57
+	graph.addNode(title + std::to_string(i++), vector3df(-2 * o, -1, (2 + o))  , SColor(255,255,0,0), true ); // 58
+	graph.addNode(title + std::to_string(i++), vector3df(-2 * o, -1, -(2 + o)) , SColor(255,255,0,0), true ); // 59
 
 	/**
 	 * Create edges between nodes. Each node has 3 shortest edges, so the below
 	 * algorithm iterates over the list of nodes and finds the 3 shortest paths.
 	 * These 3 nodes are added to the edges list.
 	 */
+	Edge edges[3];
 	for (u32 i = 0; i < nodes.size(); ++i) {
+		u32 count = 0;
 		for (u32 j = 0; j < nodes.size(); ++j) {
 			if (i != j) {
 				f32 distance = nodes[i]->position.getDistanceFrom(nodes[j]->position);
-				if (nodes[i]->edges.size() < 3) {
+				if (count < 3) {
 					// add it straight away
-					nodes[i]->edges.push_back(Edge(distance, nodes[i], nodes[j]));
+					edges[count++] = Edge(distance, nodes[i], nodes[j]);
 				}
 				else {
 					// check if it is smaller than any of the edges currently stored
 					u32 largestIndex = 0;
-					f32 largestDistance = nodes[i]->edges[0].weight;
+					f32 largestDistance = edges[0].weight;
 
-					for (u32 k = 1; k < nodes[i]->edges.size(); ++k) {
+					for (u32 k = 1; k < count; ++k) {
 
 						// first we need to find the largest value in the edges array
-						if (nodes[i]->edges[k].weight > largestDistance) {
+						if (edges[k].weight > largestDistance) {
 							largestIndex = k;
-							largestDistance = nodes[i]->edges[k].weight;
+							largestDistance = edges[k].weight;
 						}
 					}
 
 					// if our new edge is smaller than the largest, we replace it
 					if (distance < largestDistance) {
-						nodes[i]->edges[largestIndex].weight = distance;
-						nodes[i]->edges[largestIndex].to = nodes[j];
+						edges[largestIndex].weight = distance;
+						edges[largestIndex].to = nodes[j];
 					}
 
 				}
 			}
 		}
+		graph.setEdges(nodes[i], edges, count);
 	}
-
-	return nodes;
 }
 
 /**
@@ -349,7 +326,7 @@ vector<Node*> GenerateNodes() {
  */
 void PrintNodes(vector<Node*> nodes) {
 	for (u32 i = 0; i < nodes.size(); ++i) {
-		cout << i << " " << nodes[i] << ": e(" << nodes[i]->edges.size() << "):";
+		cout << nodes[i]->id << " " << nodes[i] << ": e(" << nodes[i]->edges.size() << "):";
 		// for each edge
 		for (u32 j = 0; j < nodes[i]->edges.size(); ++j) {
 			// iterate over the nodes and locate the index of which node it points to
@@ -364,147 +341,6 @@ void PrintNodes(vector<Node*> nodes) {
 	}
 }
 
-/**
- * Removes the node from the list
- */
-void listRemove(vector<Node*> &nodes, Node* value) {
-	nodes.erase(std::remove(nodes.begin(), nodes.end(), value), nodes.end());
-}
-
-/**
- * Adds the node to the list
- */
-void listAdd(vector<Node*> &nodes, Node* value) {
-	nodes.push_back(value);
-}
-
-/**
- * Sorts the list
- */
-void listSort(vector<Node*> &nodes) {
-	struct PointerCompare {
-		bool operator()(const Node* l, const Node* r) {
-			return (*l).h < (*r).h;
-		}
-	};
-	std::sort(nodes.begin(), nodes.end(), PointerCompare());
-}
-
-/**
- * Finds the index of the item in the list. If it is not found, return -1
- */
-int listFind(vector<Node*> &nodes, Node* value) {
-	vector<Node*>::iterator it = std::find(nodes.begin(), nodes.end(), value);
-	// return -1 if not found
-	if (it == nodes.end()) return -1;
-	// return the index of the element
-	return (it - nodes.begin());
-}
-
-/**
- * A path finding algorithm based on the A star algorithm.
- * resources used:
- * http://www.policyalmanac.org/games/aStarTutorial.htm
- * (the explanation of the algorithm, not the C++ code)
- * https://www.youtube.com/watch?v=C0qCR18gXdU
- * (watched to gain a high level understanding of how the algorithm works)
- */
-vector<Node*> AStarPathAlgorithm(vector<Node*> nodes, Node* start, Node* end) {
-	// 0. Reset all algorithm info on nodes
-	for (u16 i = 0; i < nodes.size(); ++i) {
-		nodes[i]->visited = false;
-		nodes[i]->f = 0.0f;
-		nodes[i]->g = 0.0f;
-		nodes[i]->h = 0.0f;
-		nodes[i]->parent = nullptr;
-	}
-
-	Node* current = start;
-	std::vector<Node*> openList;
-	std::vector<Node*> closedList;
-
-	bool pathFound = false;
-	vector<Node*> path;
-
-	// add CURRENT to open list
-	listAdd(openList, current);
-
-	while (!pathFound) {
-		if (openList.size() > 0) {
-
-			// sort the lists
-			listSort(openList);
-			listSort(closedList); // TODO: do we need to sort the closed list?
-
-			// set current node to be smallest in openlist
-			current = openList[0];
-			cout << current->name << endl;
-			// drop current node from open list and add to closed list
-			listRemove(openList, current);
-			listAdd(closedList, current);
-
-			// check if we have found our destination
-			if (current == end) {
-				// target found!
-				break;
-			}
-
-			// iterate over connected nodes
-			for (u8 i = 0; i < current->edges.size(); ++i) {
-				Node* connected = current->edges[i].to;
-
-				// ignore flag: set ignore to true if the node is impassible
-				// or the node is in the closed list
-				bool ignore = (!connected->passable || listFind(closedList, connected) != -1);
-
-				if (!ignore) {
-					// add connected node to open list
-					if (listFind(openList, connected) == -1) {
-						// not in list so add it
-						listAdd(openList, connected);
-						// set all connected nodes parent to be THIS node
-						connected->parent = current;
-						// calculate G
-						connected->g = current->g + current->edges[i].weight;
-						// calculate H
-						connected->h = connected->position.getDistanceFrom(end->position);
-						// calculate F
-						connected->f = connected->g + connected->h;
-					} else {
-						// is already in list, so need to possibly update it
-						f32 newG = current->g + current->edges[i].weight;
-						bool betterPathExists = newG < connected->g;
-						if (betterPathExists) {
-							connected->parent = current;
-							connected->g = current->g + current->edges[i].weight;
-							connected->f = connected->g + connected->h;
-							listSort(openList); // resort list
-						}
-					}
-				}
-			}
-		}
-		else {
-			cout << "OPENLIST EMPTY" << endl;
-			break;
-		}
-	}
-
-	if (current == end) {
-		// PATH FOUND
-		while (current != start) {
-			path.push_back(current);
-			current = current->parent;
-		}
-		path.push_back(current); // push the final (end) node into the path
-	}
-	else {
-		// NO PATH FOUND
-		cout << "Really, no path found." << endl;
-	}
-	return path;
-}
-
 enum
 {
 	// flag = node is not pickable
@@ -527,14 +363,22 @@ int main(void) {
 	}
 
 	// generate the nodes
-	vector<Node*> nodes = GenerateNodes();
+	Graph graph;
+	GenerateNodes(graph);
+	vector<Node*>& nodes = graph.nodes;
+
+	// lay the nodes out along a hilbert curve so that neighbours are close in memory.
+	// nodeIndex maps a node id (as entered by the user) to its index in nodes.
+	vector<u32> order = HilbertOrder(nodes);
+	ReorderNodes(graph, order);
+	vector<u32> nodeIndex = InverseOrder(order);
 
 	s32 input_impassable = 0;
 	while (input_impassable != -1) {
 		cout << "All nodes are passable by default. Enter a node ID to make it impassible. -1 to continue: ";
 		cin >> input_impassable;
 		if (input_impassable >= 0 && input_impassable < 60) {
-			nodes[input_impassable]->passable = false;
+			nodes[nodeIndex[input_impassable]]->passable = false;
 		}
 	}
 
@@ -558,43 +402,24 @@ int main(void) {
 
 	// create materials
 	video::IGPUProgrammingServices* gpu = driver->getGPUProgrammingServices();
-	s32 redMaterialType = 0;
-	s32 greenMaterialType = 0;
-	s32 yellowMaterialType = 0;
-
-	// instance of shader callback
-	NodeShaderCallBack* redShader = new NodeShaderCallBack();
-	redShader->setColour(SColorf(1.0f, 0.0f, 0.0f, 0.5f));
-	NodeShaderCallBack* yellowShader = new NodeShaderCallBack();
-	yellowShader->setColour(SColorf(1.0f, 1.0f, 0.0f, 0.5f));
-	NodeShaderCallBack* greenShader = new NodeShaderCallBack();
-	greenShader->setColour(SColorf(0.0f, 1.0f, 0.0f, 0.5f));
+	s32 nodeMaterialType = 0;
+
+	// instance of shader callback.
+	// the light is white, the colour of each node comes from its material.
+	NodeShaderCallBack* nodeShader = new NodeShaderCallBack();
+	nodeShader->setColour(SColorf(1.0f, 1.0f, 1.0f, 1.0f));
 
 	// select shading language as GLSLs
 	const video::E_GPU_SHADING_LANGUAGE shadingLanguage = video::EGSL_DEFAULT;
 
 	// create material from high level shaders (hlsl, glsl or cg)
 
-	redMaterialType = gpu->addHighLevelShaderMaterialFromFiles(
-		vsFileName, "vertexMain", video::EVST_VS_1_1,
-		psFileName, "pixelMain", video::EPST_PS_1_1,
-		redShader, video::EMT_TRANSPARENT_ADD_COLOR, 0, shadingLanguage);
-
-
-	greenMaterialType = gpu->addHighLevelShaderMaterialFromFiles(
+	nodeMaterialType = gpu->addHighLevelShaderMaterialFromFiles(
 		vsFileName, "vertexMain", video::EVST_VS_1_1,
 		psFileName, "pixelMain", video::EPST_PS_1_1,
-		greenShader, video::EMT_TRANSPARENT_ADD_COLOR, 0, shadingLanguage);
+		nodeShader, video::EMT_TRANSPARENT_ADD_COLOR, 0, shadingLanguage);
 
-
-	yellowMaterialType = gpu->addHighLevelShaderMaterialFromFiles(
-		vsFileName, "vertexMain", video::EVST_VS_1_1,
-		psFileName, "pixelMain", video::EPST_PS_1_1,
-		yellowShader, video::EMT_TRANSPARENT_ADD_COLOR, 0, shadingLanguage);
-
-	redShader->drop();
-	yellowShader->drop();
-	greenShader->drop();
+	nodeShader->drop();
 
 	// print node info
 	PrintNodes(nodes);
@@ -604,66 +429,67 @@ int main(void) {
 	* FINDING
 	* ALGORITHM
 	* HERE
+	* The search is advanced inside the render loop (see PLANNER_FRAME_BUDGET)
+	* so a long search does not stall the display.
 	*/
-	vector<Node*> path = AStarPathAlgorithm(nodes, nodes[input_start], nodes[input_end]);
-
-	// print path
-	cout << "PATH LENGTH = " << path.size() << endl;
-	for (int i = path.size() - 1; i >= 0; --i) {
-		cout << path[i]->name << "->";
-	}
-	cout << "END." << endl;
+	Node* startNode = nodes[nodeIndex[input_start]];
+	Node* endNode = nodes[nodeIndex[input_end]];
+	NodePositions positions(nodes);
+	AStarSearch search(nodes, positions, startNode, endNode);
+	vector<Node*> path;
 
-	IVertexBuffer* lineVertexBuffer = new CVertexBuffer(EVT_STANDARD);
-	IIndexBuffer* lineIndexBuffer = new CIndexBuffer(EIT_16BIT);
+	EdgeRenderer edges(nodes);
 	SMaterial lineMaterial = SMaterial();
 	lineMaterial.Thickness = 3;
 	lineMaterial.MaterialType = EMT_TRANSPARENT_ALPHA_CHANNEL;
 	lineMaterial.AmbientColor = SColor(255,255,255,255);
 
+	// Number of quads around and along the sphere drawn for each graph node.
+	const u32 NODE_SPHERE_POLYCOUNT = 16;
+
+	// Colours of the graph nodes, see showOnPath.
+	const SColor YELLOW(255, 255, 255, 0);
+	const SColor RED(255, 255, 0, 0);
+	const SColor GREEN(255, 0, 255, 0);
+
+	// Colour of the line ends at impassable nodes.
+	const SColor GREY(255, 64, 64, 64);
+
+	// Places a graph node's sphere at the node, at the given size.
+	auto markerTransform = [](const Node* n, f32 scale) {
+		matrix4 transform;
+		transform.setTranslation(n->position);
+		transform.setScale(scale);
+		return transform;
+	};
+
+	// All graph nodes are drawn by one instanced scene node, which draws
+	// the same sphere at every node. Instance i is nodes[i].
+	IMesh* sphereMesh = smgr->getGeometryCreator()->getSharedSphereMesh(0.2f, NODE_SPHERE_POLYCOUNT, NODE_SPHERE_POLYCOUNT);
+	sphereMesh->setHardwareMappingHint(EHM_STATIC);
+	IInstancedMeshSceneNode* nodeInstances = smgr->addInstancedMeshSceneNode(sphereMesh, 0, IDFlag_IsPickable);
+	sphereMesh->drop();
+	nodeInstances->setMaterialFlag(EMF_BLEND_OPERATION, true);
+	nodeInstances->setMaterialType((E_MATERIAL_TYPE)nodeMaterialType);
+	nodeInstances->setName("nodes");
+
 	for (u32 i = 0; i < nodes.size(); ++i) {
-		std::string name();
-		scene::ISceneNode* node = smgr->addSphereSceneNode(0.2f, 512,0, IDFlag_IsPickable);
-		node->setMaterialTexture(0, driver->getTexture("./res/portal7.bmp"));
-		node->setMaterialFlag(EMF_BLEND_OPERATION, true);
-		node->setPosition(nodes[i]->position);
-		node->setName(nodes[i]->name.c_str());
-		node->setID(IDFlag_IsPickable);
-		if (i == input_start) {
-			// start node
-			node->setDebugDataVisible(true);
-			node->setMaterialType((E_MATERIAL_TYPE)yellowMaterialType);
-		}
-		else if (i == input_end) {
-			// end node
-			node->setDebugDataVisible(true);
-			node->setMaterialType((E_MATERIAL_TYPE)yellowMaterialType);
-		} else if (listFind(path, nodes[i]) != -1) {
-			node->setMaterialType((E_MATERIAL_TYPE)redMaterialType);
+		if (nodes[i]->id == input_start || nodes[i]->id == input_end) {
+			// start and end node
+			nodeInstances->addInstance(markerTransform(nodes[i], 1.0f), YELLOW);
 		}
 		else {
-			node->setMaterialType((E_MATERIAL_TYPE)greenMaterialType);
-			node->setMaterialTexture(0, driver->getTexture("./res/wall.bmp"));
+			nodeInstances->addInstance(markerTransform(nodes[i], 1.0f), GREEN);
 		}
 
-		smgr->addTextSceneNode(gui->getBuiltInFont(),
-			std::to_wstring(i).c_str(),
-			video::SColor(255, 255, 255, 255), node, vector3df(0,0,0.05f), ID_IsNotPickable);
-		
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->position, vector3df(), SColor(255,0, 255,0), vector2df()));
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->edges[0].to->position, vector3df(), nodes[i]->edges[0].to->color, vector2df()));
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->position, vector3df(), nodes[i]->color, vector2df()));
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->edges[1].to->position, vector3df(), nodes[i]->edges[1].to->color, vector2df()));
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->position, vector3df(), nodes[i]->color, vector2df()));
-		lineVertexBuffer->push_back(S3DVertex(nodes[i]->edges[2].to->position, vector3df(), nodes[i]->edges[2].to->color, vector2df()));
-		lineIndexBuffer->push_back((i * 6) + 0);
-		lineIndexBuffer->push_back((i * 6) + 1);
-		lineIndexBuffer->push_back((i * 6) + 2);
-		lineIndexBuffer->push_back((i * 6) + 3);
-		lineIndexBuffer->push_back((i * 6) + 4);
-		lineIndexBuffer->push_back((i * 6) + 5);
+		if (!nodes[i]->passable) {
+			edges.setNodeColor(nodes[i], GREY);
+		}
 	}
 
+	// the ids of all graph nodes, drawn in one batch
+	LabelRenderer labels(nodes, gui->getBuiltInFont(), vector3df(0, 0, 0.05f));
+
 	// add a nice skybox
 
 	driver->setTextureCreationFlag(video::ETCF_CREATE_MIP_MAPS, false);
@@ -693,6 +519,24 @@ int main(void) {
 	// This is the movemen speed in units per second.
 	const f32 MOVEMENT_SPEED = 5.f;
 
+	// This is how long the path search may run each frame, in milliseconds.
+	const u32 PLANNER_FRAME_BUDGET = 4;
+
+	// Shows a node as part of the path (red) or not (green).
+	// The start and end nodes always stay yellow.
+	// The line ends at a node on the path are yellow.
+	auto showOnPath = [&](Node* n, bool onPath) {
+		edges.setNodeColor(n, onPath ? YELLOW : n->color);
+		if (n == startNode || n == endNode) return;
+		if (onPath) {
+			nodeInstances->setInstanceColor(n->index, RED);
+		}
+		else {
+			nodeInstances->setInstanceColor(n->index, GREEN);
+			nodeInstances->setInstanceTransform(n->index, markerTransform(n, 1.0f));
+		}
+	};
+
 	while (device->run())
 		if (device->isWindowActive())
 		{
@@ -703,6 +547,24 @@ int main(void) {
 			const f32 frameDeltaTime = (f32)(now - then) / 1000.f; // Time in seconds
 			then = now;
 
+			// advance the search and show the best path found so far
+			if (!search.isFinished()) {
+				search.step(device->getTimer(), device->getTimer()->getRealTime() + PLANNER_FRAME_BUDGET);
+
+				for (u32 i = 0; i < path.size(); ++i) showOnPath(path[i], false);
+				path = search.getPath();
+				for (u32 i = 0; i < path.size(); ++i) showOnPath(path[i], true);
+
+				if (search.isFinished()) {
+					// print path
+					cout << "PATH LENGTH = " << path.size() << endl;
+					for (int i = path.size() - 1; i >= 0; --i) {
+						cout << path[i]->name << "->";
+					}
+					cout << "END." << endl;
+				}
+			}
+
 			smgr->drawAll();
 
 			// sine function for displaying the path
@@ -711,21 +573,14 @@ int main(void) {
 
 			// iterate over scene nodes that are part of the path and make the do something
 			for (u32 i = 0; i < path.size(); ++i) {
-				ISceneNode* n = smgr->getSceneNodeFromName(path[i]->name.c_str());
-				n->setScale(vector3df((sin(s) * 0.1f)  + 1.0f));
+				nodeInstances->setInstanceTransform(path[i]->index, markerTransform(path[i], (sin(s) * 0.1f) + 1.0f));
 			}
 
-			driver->setMaterial(lineMaterial);
-
-			driver->setTransform(ETS_WORLD, matrix4());
-
 			// draw lines
-			smgr->getVideoDriver()->drawVertexPrimitiveList(
-				lineVertexBuffer->pointer(), lineVertexBuffer->size(),
-				lineIndexBuffer->pointer(), lineVertexBuffer->size() / 2,
-				EVT_STANDARD,
-				EPT_LINES,
-				EIT_16BIT);
+			edges.draw(driver, lineMaterial);
+
+			// draw the node ids over the scene
+			labels.draw(driver, cam, SColor(255, 255, 255, 255));
 
 			/* Check if keys W, S, A or D are being held down, and move the
 			sphere node around respectively. */